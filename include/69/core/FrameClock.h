@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace core
+{
+
+// Fixed-size history of frame times. Written by the frame loop, readable from any thread
+// without locks (a reader racing the writer may see one sample from the next lap).
+class FrameTimeHistory
+{
+  public:
+    static constexpr int CAPACITY = 256;
+
+    struct Stats
+    {
+        int Count = 0;
+        float P50 = 0.0f;
+        float P99 = 0.0f;
+        float Max = 0.0f;
+    };
+
+    void Push(float seconds);
+    Stats GetStats() const;
+
+  private:
+    std::atomic<float> m_Samples[CAPACITY] = {};
+    std::atomic<unsigned int> m_Written = 0;
+};
+
+// Monotonic frame clock feeding measured deltas to the menu
+class FrameClock
+{
+  public:
+    // Longest step handed to animations (after a stall, a drag, a throttled frame)
+    static constexpr float MAX_DELTA = 0.1f;
+
+    FrameClock();
+
+    // Seconds since the clock was created
+    double Now() const;
+
+    // Call once per rendered frame, returns the clamped delta since the previous call
+    float Tick();
+
+    float GetDelta() const
+    {
+        return m_Delta;
+    }
+    const FrameTimeHistory& GetHistory() const
+    {
+        return m_History;
+    }
+
+  private:
+    std::chrono::steady_clock::time_point m_Start;
+    double m_LastTick = 0.0;
+    float m_Delta = 0.0f;
+    FrameTimeHistory m_History;
+};
+
+} // namespace core
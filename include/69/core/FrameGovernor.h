@@ -0,0 +1,58 @@
+#pragma once
+
+namespace core
+{
+
+// Decides how often the frame loop has to render.
+// Times are in seconds from any monotonic clock, so it can be driven by a fake one.
+class FrameGovernor
+{
+  public:
+    enum class Mode
+    {
+        FULL_RATE,     // Something is animating or the user just interacted: every vsync
+        REDUCED_RATE,  // Only ambient motion (background blobs): capped frame rate
+        WAIT_FOR_INPUT // Nothing to show (idle, minimized, occluded): block until a message
+    };
+
+    // Signals from the menu, refreshed after every rendered frame
+    void SetAnimating(bool animating);
+    void SetAmbientAnimating(bool ambient);
+
+    // Window events
+    void SetFocused(bool focused);
+    void SetMinimized(bool minimized);
+    void SetOccluded(bool occluded);
+    void NotifyInput(double now);
+
+    // Pass when the frame started: the next one is due an interval later, however long
+    // rendering and the vsync wait of Present took
+    void FrameRendered(double frameStart);
+
+    Mode GetMode(double now) const;
+
+    // Seconds the loop may block waiting for messages before the next frame is due,
+    // 0 = render now, < 0 = wait for a message however long it takes
+    double GetWaitTimeout(double now) const;
+
+    bool IsMinimized() const
+    {
+        return m_Minimized;
+    }
+    bool IsOccluded() const
+    {
+        return m_Occluded;
+    }
+
+  private:
+    bool m_Animating = true;
+    bool m_AmbientAnimating = true;
+    bool m_Focused = true;
+    bool m_Minimized = false;
+    bool m_Occluded = false;
+
+    double m_LastInput = 0.0;
+    double m_LastFrame = 0.0;
+};
+
+} // namespace core
@@ -0,0 +1,56 @@
+#pragma once
+#include "imgui/imgui.h"
+
+#include <vector>
+
+namespace menu
+{
+
+// Background blobs pre-rasterized into one RGBA strip so each blob draws as a single quad.
+// RGB holds the share of the blob color in the composite (the rest is the black shadow),
+// A holds the total coverage. Tint the quad with the blob color and the current fade alpha.
+class BlobSprite
+{
+  public:
+    struct Cell
+    {
+        float Size;       // Blob radius in pixels
+        float ColorAlpha; // Alpha of the blob color (baked into the texture)
+        float Extent;     // Half size of the quad around the blob center
+        ImVec2 UvMin;
+        ImVec2 UvMax;
+    };
+
+    // Returns the cell index
+    int AddBlob(float size, float colorAlpha);
+
+    // Rasterize every cell, scale < 1 bakes at reduced resolution (bilinear upscaled on draw)
+    void Bake(float scale = 0.5f);
+
+    void Draw(ImDrawList* drawList, ImTextureRef texture, int index, ImVec2 center,
+              ImU32 tint) const;
+
+    const unsigned char* GetPixels() const
+    {
+        return m_Pixels.empty() ? nullptr : m_Pixels.data();
+    }
+    int GetWidth() const
+    {
+        return m_Width;
+    }
+    int GetHeight() const
+    {
+        return m_Height;
+    }
+
+    // Pixels are only needed until uploaded
+    void ReleasePixels();
+
+  private:
+    std::vector<Cell> m_Cells;
+    std::vector<unsigned char> m_Pixels;
+    int m_Width = 0;
+    int m_Height = 0;
+};
+
+} // namespace menu
@@ -0,0 +1,26 @@
+#pragma once
+#include "69/menu/Texture.h"
+
+// Forward declaration
+struct ID3D11Device;
+
+namespace menu
+{
+
+// Shader resource views on the loader's device, the texture id is the view
+class D3D11TextureFactory final : public ITextureFactory
+{
+  public:
+    explicit D3D11TextureFactory(ID3D11Device* device) : m_Device(device)
+    {
+    }
+
+    ImTextureID CreateTexture(const unsigned char* pixels, int width, int height,
+                              int mipCount = 1) override;
+    void DestroyTexture(ImTextureID texture) override;
+
+  private:
+    ID3D11Device* m_Device;
+};
+
+} // namespace menu
@@ -0,0 +1,57 @@
+#pragma once
+#include "69/menu/Menu.h"
+#include "imgui/imgui.h"
+
+#include <cstdint>
+
+namespace menu
+{
+
+// Per-frame numbers of what ImGui hands to the renderer
+struct DrawStats
+{
+    int DrawLists = 0;
+    int Commands = 0;
+    int Vertices = 0;
+    int Indices = 0;
+    int ClipRectChanges = 0;
+    int TextureChanges = 0;
+    double CpuMs = 0.0; // Time spent building the frame (Menu::Render + ImGui::Render)
+};
+
+DrawStats CollectDrawStats(const ImDrawData* drawData);
+
+const char* GetStateName(AppState state);
+
+// Aggregates frame stats by AppState and dumps them as JSON (average and max per state)
+class DrawStatsRecorder
+{
+  public:
+    void Record(AppState state, const DrawStats& frame);
+    bool WriteJson(const char* path) const;
+
+  private:
+    static constexpr int STATE_COUNT = (int)AppState::LAUNCHING + 1;
+
+    // Running totals, a long recording overflows the per-frame ints
+    struct Totals
+    {
+        int64_t DrawLists = 0;
+        int64_t Commands = 0;
+        int64_t Vertices = 0;
+        int64_t Indices = 0;
+        int64_t ClipRectChanges = 0;
+        int64_t TextureChanges = 0;
+        double CpuMs = 0.0;
+    };
+
+    struct Aggregate
+    {
+        int64_t Frames = 0;
+        Totals Sum;
+        DrawStats Max;
+    };
+    Aggregate m_States[STATE_COUNT];
+};
+
+} // namespace menu
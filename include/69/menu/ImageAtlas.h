@@ -0,0 +1,37 @@
+#pragma once
+#include "imgui/imgui.h"
+
+#include <vector>
+
+namespace menu
+{
+
+// UI images packed next to the glyphs in ImGui's font atlas (custom rects, placed by its
+// imstb_rectpack packer). Images and text then share one texture, so ImGui keeps them in the
+// same draw commands instead of splitting the draw list at every image. Only those: the
+// shadows, baked glows and blob sprite keep textures of their own, and the draw list still
+// switches texture around each of them.
+// No mips: add images at the size they are drawn.
+// The atlas moves rects when it grows or repacks: look the UVs up when drawing, never keep them.
+class ImageAtlas
+{
+  public:
+    // Copies width x height RGBA8 pixels into the current context's font atlas. Must be called
+    // inside a frame (the atlas exists and accepts changes). Returns the image index, -1 if it
+    // doesn't fit.
+    int Add(const unsigned char* pixels, int width, int height);
+
+    // Texture and UVs of image index for this frame, false if there is no such image
+    bool Get(int index, ImTextureRef& texture, ImVec2& uv0, ImVec2& uv1) const;
+
+    int GetCount() const
+    {
+        return (int)m_Rects.size();
+    }
+
+  private:
+    ImFontAtlas* m_Atlas = nullptr;
+    std::vector<ImFontAtlasRectId> m_Rects; // Each with a 1 pixel border around the image
+};
+
+} // namespace menu
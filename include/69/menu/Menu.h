@@ -1,15 +1,20 @@
 #pragma once
+#include "69/menu/BlobSprite.h"
+#include "69/menu/ImageAtlas.h"
+#include "69/menu/Platform.h"
+#include "69/menu/RetainedGeometry.h"
+#include "69/menu/Texture.h"
+#include "69/menu/Theme.h"
+#include "69/menu/Tween.h"
+#include "69/service/Scheduler.h"
 #include "69/service/Service.h"
 #include "imgui/imgui.h"
 
 #include <atomic>
-#include <future>
+#include <chrono>
+#include <optional>
 #include <string>
 
-// Forward declaration
-struct ID3D11ShaderResourceView;
-struct ID3D11Device;
-
 namespace menu
 {
 
@@ -30,45 +35,67 @@ enum class AppState
 class Menu
 {
   public:
-    Menu();
-    void Render(float deltaTime, void* platformHandle, ID3D11Device* device = nullptr);
+    // Nothing Windows specific past these: KeyauthService, Win32Platform and D3D11TextureFactory
+    // in the loader, stand-ins anywhere else. Platform and texture factory must outlive the menu.
+    Menu(std::shared_ptr<service::IService> service, IPlatform& platform,
+         ITextureFactory& textures);
+    ~Menu();
+
+    Menu(const Menu&) = delete;
+    Menu& operator=(const Menu&) = delete;
+
+    void Render(float deltaTime);
+
+    AppState GetState() const
+    {
+        return m_State;
+    }
+
+    // Frame rate hints: anything besides the background drifting needs every frame
+    bool IsAnimating() const;
+    bool HasAmbientAnimation() const;
 
   private:
     // State
     AppState m_State = AppState::LOGIN;
     AppState m_NextState = AppState::LOGIN;
 
+    // Logo and product icons, packed with the font glyphs
+    ImageAtlas m_Images;
+    int m_LogoImage = -1;
+    std::vector<int> m_IconImages; // Image of each SoftwareItem::IconIndex
+
     // Login
-    ID3D11ShaderResourceView* m_LogoTexture = nullptr;
     char m_LicenseKey[64] = "";
     bool m_ShowLicenseKey = false;
 
     // Result logic
     bool m_WasSuccess = false;
     std::string m_StatusMessage;
-    std::future<bool> m_LicenseCheckFuture;
+    std::optional<service::OperationResult> m_LicenseResult;   // Set by LoginFlow
+    std::chrono::steady_clock::time_point m_LicenseClickTime;  // Confirm accepted
+    std::chrono::steady_clock::time_point m_LicenseResultTime; // Flow resumed with the result
 
     bool m_LaunchStart = false;
-    std::future<bool> m_LaunchResultFuture;
+    bool m_Revalidating = false; // Cached login not confirmed yet, see RevalidateFlow
 
-    // Animation States
+    // Animation States (advanced together in m_Tweens)
+    TweenSet m_Tweens;
     float m_Time = 0.0f;
     float m_StateTime = 0.0f;
-    float m_WindowAlpha = 0.0f;
-    float m_ContentAlpha = 1.0f;
+    Tween m_WindowAlpha = m_Tweens.Add(0.0f);
+    Tween m_ContentAlpha = m_Tweens.Add(1.0f);
 
     // Focus States
-    float m_LicenseKeyFocusT = 0.0f;
-    float m_ButtonHoverT = 0.0f;
-    float m_ButtonClickT = 0.0f;
-    float m_ErrorShakeT = 0.0f;
-    float m_ResultAnimT = 0.0f;
+    Tween m_LicenseKeyFocusT = m_Tweens.Add(0.0f);
+    Tween m_ButtonHoverT = m_Tweens.Add(0.0f);
+    Tween m_ButtonClickT = m_Tweens.Add(0.0f);
+    Tween m_ErrorShakeT = m_Tweens.Add(0.0f);
+    Tween m_ResultAnimT = m_Tweens.Add(0.0f);
 
     // Main Menu States
-    ID3D11ShaderResourceView* m_SoftwareTexture = nullptr;
-    float m_ThumbnailHoverT = 0.0f;
     int m_SelectedIndex = -1;
-    float m_LaunchAnimT = 0.0f;
+    Tween m_LaunchAnimT = m_Tweens.Add(0.0f);
 
     // Window Drag State
     bool m_IsDragging = false;
@@ -82,20 +109,37 @@ class Menu
         ImVec2 Vel;
         ImVec4 Color;
         float Size;
+        int SpriteIndex = -1; // Cell in m_BlobSprite
     };
     std::vector<BackgroundBlob> m_Blobs;
+    BlobSprite m_BlobSprite;
+    ImTextureID m_BlobTexture = ImTextureID_Invalid;
+
+    // Retained Content (replayed while only alpha/offset animate)
+    using ScreenFn = void (Menu::*)(ImVec2 pStart, ImVec2 pSize, float alpha);
+    RetainedGeometry m_RetainedContent;
+    ScreenFn m_RetainedScreen = nullptr;
+    theme::Quality m_RetainedQuality = theme::Quality::HIGH;
+    bool m_ContentReplayed = false;
+
+    // Platform
+    IPlatform& m_Platform;
+    ITextureFactory& m_Textures;
 
     // Service
     std::shared_ptr<service::IService> m_service;
-    std::vector<service::SoftwareItem> m_SoftwareList;
+    service::LoginBundle m_Login;        // Catalog, subscriptions, variables, set by LoginFlow
+    service::FrameScheduler m_Scheduler; // Ticked once per Render
 
     // Helper Methods
     void DrawGlassPanel(ImVec2 pos, ImVec2 size, float alpha);
-    void DrawInput(const char* label, char* buffer, size_t size, bool isPassword, float& focusT,
+    void DrawInput(const char* label, char* buffer, size_t size, bool isPassword, Tween focus,
                    bool& showPasswordToggle, float alpha);
-    bool DrawButton(const char* label, ImVec2 size, float& hoverT, float& clickT, float alpha);
+    bool DrawButton(const char* label, ImVec2 size, Tween hover, Tween click, float alpha);
     void TriggerShake();
-    void LoadTexture(ID3D11Device* device);
+    bool CanReplayContent() const;
+    void LoadTexture();
+    bool GetIcon(int iconIndex, ImTextureRef& texture, ImVec2& uv0, ImVec2& uv1) const;
 
     // Screens
     void DrawLoginScreen(ImVec2 pStart, ImVec2 pSize, float alpha);
@@ -106,6 +150,10 @@ class Menu
 
     void StartLicenseCheck();
     void StartLaunchSoftware(int id);
+    service::Task<void> LoginFlow(std::string licenseKey);
+    service::Task<void> RevalidateFlow(std::string licenseKey);
+    service::Task<void> LaunchFlow(int id);
+    void CancelPendingOperations();
 };
 
 } // namespace menu
@@ -0,0 +1,61 @@
+#pragma once
+
+namespace menu
+{
+
+// What the menu asks of the operating system, so it runs the same on any backend.
+// Positions are in screen pixels.
+class IPlatform
+{
+  public:
+    virtual ~IPlatform() = default;
+
+    virtual void GetCursorPos(long& x, long& y) = 0;
+    virtual void MoveWindow(long dx, long dy) = 0;
+    virtual void Minimize() = 0;
+    virtual void Quit() = 0;
+
+    // Debugger output, not shown to the user
+    virtual void Log(const char* message) = 0;
+};
+
+// Headless stand-in for benchmarks and CI: the window is only a position and the cursor is
+// wherever it was last set. Log goes to stderr.
+class NullPlatform final : public IPlatform
+{
+  public:
+    void GetCursorPos(long& x, long& y) override;
+    void MoveWindow(long dx, long dy) override;
+    void Minimize() override;
+    void Quit() override;
+    void Log(const char* message) override;
+
+    void SetCursorPos(long x, long y);
+
+    long GetWindowX() const
+    {
+        return m_WindowX;
+    }
+    long GetWindowY() const
+    {
+        return m_WindowY;
+    }
+    bool IsMinimized() const
+    {
+        return m_Minimized;
+    }
+    bool HasQuit() const
+    {
+        return m_Quit;
+    }
+
+  private:
+    long m_CursorX = 0;
+    long m_CursorY = 0;
+    long m_WindowX = 0;
+    long m_WindowY = 0;
+    bool m_Minimized = false;
+    bool m_Quit = false;
+};
+
+} // namespace menu
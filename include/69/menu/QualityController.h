@@ -0,0 +1,44 @@
+#pragma once
+#include "69/menu/Theme.h"
+
+#include <vector>
+
+namespace menu
+{
+
+// Picks the effects quality tier from measured frame times.
+// Drops a tier as soon as a full window of frames runs slow, climbs back only after a long
+// stretch of fast frames, and waits twice as long after every upgrade that had to be undone.
+class QualityController
+{
+  public:
+    QualityController();
+
+    // Frame time of a frame rendered back to back with the previous one (not throttled)
+    void AddFrame(float seconds);
+
+    // Pin the tier (--quality=...), stops adapting
+    void Force(theme::Quality tier);
+
+    theme::Quality GetTier() const
+    {
+        return m_Tier;
+    }
+
+  private:
+    float GetWindowP90() const;
+    void SetTier(theme::Quality tier);
+
+    theme::Quality m_Tier = theme::Quality::HIGH;
+    bool m_Forced = false;
+
+    std::vector<float> m_Window;
+    int m_WindowPos = 0;
+    int m_WindowCount = 0;
+
+    int m_FramesAtTier = 0;
+    int m_UpgradeDelay;
+    bool m_JustUpgraded = false;
+};
+
+} // namespace menu
@@ -0,0 +1,33 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+namespace menu
+{
+namespace raster
+{
+
+// Signed distance to a rounded rect centered at (cx, cy) with half size (hx, hy)
+inline float RoundedRectDistance(float x, float y, float cx, float cy, float hx, float hy, float r)
+{
+    float qx = std::fabs(x - cx) - (hx - r);
+    float qy = std::fabs(y - cy) - (hy - r);
+    float ox = std::max(qx, 0.0f);
+    float oy = std::max(qy, 0.0f);
+    return std::sqrt(ox * ox + oy * oy) + std::min(std::max(qx, qy), 0.0f) - r;
+}
+
+// Anti-aliased coverage of a filled shape from its signed distance (one pixel fringe)
+inline float Coverage(float distance)
+{
+    return std::min(std::max(0.5f - distance, 0.0f), 1.0f);
+}
+
+// Corner rounding as ImDrawList clamps it for a w x h rect
+inline float ClampRounding(float rounding, float w, float h)
+{
+    return std::max(std::min(rounding, std::min(w, h) * 0.5f - 1.0f), 0.0f);
+}
+
+} // namespace raster
+} // namespace menu
@@ -0,0 +1,66 @@
+#pragma once
+#include "imgui/imgui.h"
+
+#include <vector>
+
+namespace menu
+{
+
+// Copy of the vertices/indices a screen emitted into a draw list, replayed on later frames
+// with only the alpha and position changed (fades, shake) instead of re-tessellating.
+class RetainedGeometry
+{
+  public:
+    // Mark the draw list state before the screen draws
+    void BeginRecord(ImDrawList* drawList);
+
+    // Copy everything emitted since BeginRecord, alpha/offset are the ones the screen used
+    void EndRecord(ImDrawList* drawList, float alpha, ImVec2 offset);
+
+    // Append the recorded geometry faded to alpha and moved to offset.
+    // Returns false when the recording can't reproduce it (nothing recorded, alpha above
+    // the recorded one, font atlas changed since), in which case the screen must draw itself.
+    bool Replay(ImDrawList* drawList, float alpha, ImVec2 offset) const;
+
+    void Invalidate();
+    bool IsValid() const
+    {
+        return m_Valid;
+    }
+
+  private:
+    struct Segment
+    {
+        ImVec4 ClipRect;
+        ImTextureRef TexRef;
+        int IdxOffset;
+        int IdxCount;
+    };
+
+    bool m_Valid = false;
+    int m_CmdStart = 0;
+    int m_VtxStart = 0;
+    int m_IdxStart = 0;
+
+    float m_Alpha = 1.0f;
+    ImVec2 m_Offset;
+    ImVec2 m_FontUvScale;
+
+    std::vector<Segment> m_Segments;
+    std::vector<ImDrawVert> m_Vertices;
+    std::vector<ImDrawIdx> m_Indices; // Relative to the first recorded vertex
+};
+
+// The copy passes of Replay, SSE2 when available
+namespace retained
+{
+
+// Move positions by offset and scale vertex alpha by alphaScale / 256, alphaScale <= 256
+void TransformVertices(const ImDrawVert* src, ImDrawVert* dst, int count, ImVec2 offset,
+                       int alphaScale);
+
+// dst = src + base
+void RebaseIndices(const ImDrawIdx* src, ImDrawIdx* dst, int count, unsigned int base);
+
+} // namespace retained
+} // namespace menu
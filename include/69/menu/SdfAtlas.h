@@ -0,0 +1,60 @@
+#pragma once
+#include "69/menu/Texture.h"
+#include "imgui/imgui.h"
+
+#include <vector>
+
+namespace menu
+{
+
+// Cache of baked stroke textures for the neon focus rects and the result rings.
+// Textures come from the distance field baker (SdfBaker.h) and are keyed by shape parameters,
+// so a whole glow is a single nine-slice or quad instead of several tessellated outlines.
+// The textures are not in the font atlas: fewer vertices, but a texture change around each draw.
+class SdfAtlas
+{
+  public:
+    ~SdfAtlas();
+
+    // Textures come from the factory until it is replaced, changing it destroys them.
+    // Set nullptr before the factory goes away.
+    void SetTextureFactory(ITextureFactory* textures);
+
+    // Bake ahead of the first draw (startup)
+    void WarmNeonRect(float thickness, float rounding, int layers);
+    void WarmRing(float radius, float thickness);
+
+    // Same look as the layered DrawNeonRect, returns false if it can't be drawn from the cache
+    // (no texture factory yet, or rect smaller than its corners)
+    bool DrawNeonRect(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, ImU32 color,
+                      float thickness, float intensity, float rounding, int layers);
+
+    // Same look as AddCircle(center, radius, color, 0, thickness)
+    bool DrawRing(ImDrawList* drawList, ImVec2 center, float radius, ImU32 color,
+                  float thickness);
+
+  private:
+    enum class Shape
+    {
+        NEON_RECT,
+        RING
+    };
+
+    struct Entry
+    {
+        Shape Kind;
+        float Size;      // Rounding for NEON_RECT, radius for RING
+        float Thickness;
+        int Layers;
+        ImTextureID Texture;
+        int TextureSize; // Texture is TextureSize x TextureSize
+        int Margin;      // Distance from the texture edge to the outline
+    };
+
+    const Entry* Find(Shape kind, float size, float thickness, int layers);
+
+    ITextureFactory* m_Textures = nullptr;
+    std::vector<Entry> m_Entries;
+};
+
+} // namespace menu
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace menu
+{
+namespace raster
+{
+
+// Anti-aliased stroke centered on a shape outline, Alpha at full opacity
+struct Stroke
+{
+    float Width;
+    float Alpha;
+};
+
+// Bake strokes along a rounded rect centered in a width x height RGBA image.
+// RGB is white, A the composited coverage of all strokes (later ones drawn on top).
+// A circle is a rounded rect with hx = hy = r. SSE2 when available, big images are split
+// by rows over a few threads.
+void BakeRoundedRectStrokes(unsigned char* rgba, int width, int height, float hx, float hy,
+                            float r, const Stroke* strokes, int strokeCount);
+
+} // namespace raster
+} // namespace menu
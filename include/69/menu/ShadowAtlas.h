@@ -0,0 +1,44 @@
+#pragma once
+#include "69/menu/Texture.h"
+#include "imgui/imgui.h"
+
+#include <vector>
+
+namespace menu
+{
+
+// Nine-slice cache for the layered rounded-rect drop shadow.
+// One small texture is baked per (rounding, spread, layers) the first time it is drawn,
+// after that every shadow is 9 quads whatever its size.
+class ShadowAtlas
+{
+  public:
+    ~ShadowAtlas();
+
+    // Textures come from the factory until it is replaced, changing it destroys them.
+    // Set nullptr before the factory goes away.
+    void SetTextureFactory(ITextureFactory* textures);
+
+    // Same parameters as the layered DrawBlurShadow, returns false if the shadow can't be
+    // drawn from the cache (no texture factory yet, or rect smaller than its corners)
+    bool Draw(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, float shadowSize, int layers,
+              float rounding, float alpha);
+
+  private:
+    struct Entry
+    {
+        float Rounding;
+        float Spread;
+        int Layers;
+        ImTextureID Texture;
+        int Size;   // Texture is Size x Size
+        int Margin; // Distance from the texture edge to the shadowed rect
+    };
+
+    const Entry* Find(float rounding, float spread, int layers);
+
+    ITextureFactory* m_Textures = nullptr;
+    std::vector<Entry> m_Entries;
+};
+
+} // namespace menu
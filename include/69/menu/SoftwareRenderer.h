@@ -0,0 +1,112 @@
+#pragma once
+#include "69/menu/Texture.h"
+#include "imgui/imgui.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace menu
+{
+
+// ImDrawData rasterized on the CPU into an RGBA8 framebuffer: the fallback when no D3D11
+// device can be created (not even WARP), and a renderer for headless runs and pixel tests.
+// The screen is cut in 64x64 tiles. Triangles are set up and binned by all threads, then each
+// tile is filled by one thread in submission order, 4 pixels at a time with SSE2.
+// Blending is the DX11 backend's (alpha over, alpha channel ONE / INV_SRC_ALPHA), so drawn
+// on a transparent clear the result is premultiplied. Every texture must come from the
+// MemoryTextureFactory given here, the font atlas is kept in it too.
+class SoftwareRenderer
+{
+  public:
+    // threads = 0: one per core, up to MAX_THREADS
+    explicit SoftwareRenderer(MemoryTextureFactory& textures, int threads = 0);
+    ~SoftwareRenderer();
+
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    static constexpr int TILE_SIZE = 64;
+    static constexpr int MAX_THREADS = 8;
+
+    // Renderer backend of the current ImGui context, like ImGui_ImplDX11_Init / _Shutdown
+    void Init();
+    void Shutdown();
+
+    // Sized to the display, cleared to clearColor (IM_COL32) then drawn
+    void Render(ImDrawData* drawData, ImU32 clearColor = 0);
+
+    // IM_COL32 pixels (R in the lowest byte), GetPitch() pixels from one row to the next
+    const ImU32* GetPixels() const
+    {
+        return m_Pixels.data();
+    }
+    int GetWidth() const
+    {
+        return m_Width;
+    }
+    int GetHeight() const
+    {
+        return m_Height;
+    }
+    int GetPitch() const
+    {
+        return m_Pitch;
+    }
+
+  private:
+    struct Batch;
+    struct Triangle;
+
+    void UpdateTexture(ImTextureData* texture);
+
+    // False when the triangle covers no pixel center
+    static bool SetupTriangle(const Batch& batch, const ImDrawIdx* indices, Triangle& triangle);
+    // Fills the pixels of triangle inside [minX, maxX] x [minY, maxY]
+    static void DrawTriangle(const Triangle& triangle, ImU32* pixels, int pitch, int minX,
+                             int minY, int maxX, int maxY);
+
+    // Steps of a frame, run by every thread, item = chunk of triangles / tile
+    void SetupChunk(int chunk);
+    void RasterizeTile(int tile);
+
+    // Calls (this->*job)(item) for every item in [0, count), returns once all are done
+    void RunParallel(void (SoftwareRenderer::*job)(int), int count);
+    void WorkerLoop();
+    void RunItems();
+
+    MemoryTextureFactory& m_Textures;
+
+    // Framebuffer, the pitch is a multiple of 4 pixels
+    std::vector<ImU32> m_Pixels;
+    int m_Width = 0;
+    int m_Height = 0;
+    int m_Pitch = 0;
+    ImU32 m_ClearColor = 0;
+
+    // Current frame
+    std::vector<Batch> m_Batches;
+    std::vector<Triangle> m_Triangles;
+    int m_TilesX = 0;
+    int m_TilesY = 0;
+    int m_ChunkCount = 0;
+    std::vector<std::vector<uint32_t>> m_Bins; // Triangle indices per chunk and tile
+
+    // Workers, the calling thread takes items as well
+    int m_ThreadCount = 1;
+    std::vector<std::thread> m_Workers;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    std::condition_variable m_Done;
+    void (SoftwareRenderer::*m_Job)(int) = nullptr;
+    int m_ItemCount = 0;
+    std::atomic<int> m_NextItem = 0;
+    int m_Running = 0;
+    uint64_t m_Generation = 0;
+    bool m_Stop = false;
+};
+
+} // namespace menu
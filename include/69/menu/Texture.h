@@ -0,0 +1,61 @@
+#pragma once
+#include "imgui/imgui.h"
+
+#include <memory>
+#include <vector>
+
+namespace menu
+{
+
+// Uploads tightly packed RGBA8 pixels for ImGui to draw
+class ITextureFactory
+{
+  public:
+    virtual ~ITextureFactory() = default;
+
+    // ImTextureID_Invalid on failure. pixels holds mipCount levels one after the other, level i
+    // is GetMipSize(width, i) x GetMipSize(height, i).
+    virtual ImTextureID CreateTexture(const unsigned char* pixels, int width, int height,
+                                      int mipCount = 1) = 0;
+    virtual void DestroyTexture(ImTextureID texture) = 0;
+
+    static int GetMipSize(int size, int level)
+    {
+        return (size >> level) > 0 ? size >> level : 1;
+    }
+};
+
+// Keeps the pixels in memory, for headless runs and software rendering. A texture id points
+// to its MemoryTexture. Only the first mip is kept, the software renderer doesn't use mips.
+class MemoryTextureFactory final : public ITextureFactory
+{
+  public:
+    struct MemoryTexture
+    {
+        int Width;
+        int Height;
+        std::vector<unsigned char> Pixels; // RGBA8, Width * 4 bytes per row
+    };
+
+    ImTextureID CreateTexture(const unsigned char* pixels, int width, int height,
+                              int mipCount = 1) override;
+    void DestroyTexture(ImTextureID texture) override;
+
+    // Overwrites a width x height block at x, y, pitch is in bytes
+    void UpdateTexture(ImTextureID texture, int x, int y, int width, int height,
+                       const unsigned char* pixels, int pitch);
+
+    static const MemoryTexture* Get(ImTextureID texture)
+    {
+        return (const MemoryTexture*)(size_t)texture;
+    }
+    int GetTextureCount() const
+    {
+        return (int)m_Textures.size();
+    }
+
+  private:
+    std::vector<std::unique_ptr<MemoryTexture>> m_Textures;
+};
+
+} // namespace menu
@@ -8,32 +8,119 @@ namespace theme
 {
 
 // Color Palette - Red Dragon Theme
-const ImVec4 GLASS_BG = ImVec4(0.12f, 0.05f, 0.05f, 0.90f);      // Dark red base
-const ImVec4 GLASS_BORDER = ImVec4(0.95f, 0.35f, 0.25f, 0.60f);  // Fiery red border
-const ImVec4 ACCENT_COLOR = ImVec4(1.0f, 0.40f, 0.30f, 0.9f);    // Bright red-orange accent
-const ImVec4 TEXT_PRIMARY = ImVec4(1.0f, 0.95f, 0.92f, 0.95f);   // Warm white
-const ImVec4 TEXT_SECONDARY = ImVec4(0.95f, 0.95f, 0.95f, 0.7f); // Soft coral
-const ImVec4 INPUT_BG = ImVec4(0.08f, 0.03f, 0.03f, 0.4f);       // Very dark red
-const ImVec4 INPUT_BORDER = ImVec4(0.80f, 0.30f, 0.25f, 0.15f);  // Subtle red border
-const ImVec4 BUTTON_TOP = ImVec4(1.0f, 0.50f, 0.35f, 0.9f);      // Orange-red top
-const ImVec4 BUTTON_BOTTOM = ImVec4(0.70f, 0.15f, 0.10f, 0.9f);  // Deep crimson bottom
-const ImVec4 ERROR_COLOR = ImVec4(1.0f, 0.25f, 0.20f, 0.8f);     // Bright red error
-const ImVec4 SUCCESS_COLOR = ImVec4(1.0f, 0.65f, 0.35f, 1.0f);   // Golden orange success
+constexpr ImVec4 GLASS_BG = ImVec4(0.12f, 0.05f, 0.05f, 0.90f);      // Dark red base
+constexpr ImVec4 GLASS_BORDER = ImVec4(0.95f, 0.35f, 0.25f, 0.60f);  // Fiery red border
+constexpr ImVec4 ACCENT_COLOR = ImVec4(1.0f, 0.40f, 0.30f, 0.9f);    // Bright red-orange accent
+constexpr ImVec4 TEXT_PRIMARY = ImVec4(1.0f, 0.95f, 0.92f, 0.95f);   // Warm white
+constexpr ImVec4 TEXT_SECONDARY = ImVec4(0.95f, 0.95f, 0.95f, 0.7f); // Soft coral
+constexpr ImVec4 INPUT_BG = ImVec4(0.08f, 0.03f, 0.03f, 0.4f);       // Very dark red
+constexpr ImVec4 INPUT_BORDER = ImVec4(0.80f, 0.30f, 0.25f, 0.15f);  // Subtle red border
+constexpr ImVec4 BUTTON_TOP = ImVec4(1.0f, 0.50f, 0.35f, 0.9f);      // Orange-red top
+constexpr ImVec4 BUTTON_BOTTOM = ImVec4(0.70f, 0.15f, 0.10f, 0.9f);  // Deep crimson bottom
+constexpr ImVec4 ERROR_COLOR = ImVec4(1.0f, 0.25f, 0.20f, 0.8f);     // Bright red error
+constexpr ImVec4 SUCCESS_COLOR = ImVec4(1.0f, 0.65f, 0.35f, 1.0f);   // Golden orange success
 
 // Blobs - Fire gradient variations
-const ImVec4 BLOB_1 = ImVec4(1.0f, 0.40f, 0.30f, 0.10f);  // Bright red-orange blob
-const ImVec4 BLOB_2 = ImVec4(0.90f, 0.25f, 0.20f, 0.10f); // Deep red blob
-const ImVec4 BLOB_3 = ImVec4(0.95f, 0.50f, 0.25f, 0.10f); // Orange-red blob
+constexpr ImVec4 BLOB_1 = ImVec4(1.0f, 0.40f, 0.30f, 0.10f);  // Bright red-orange blob
+constexpr ImVec4 BLOB_2 = ImVec4(0.90f, 0.25f, 0.20f, 0.10f); // Deep red blob
+constexpr ImVec4 BLOB_3 = ImVec4(0.95f, 0.50f, 0.25f, 0.10f); // Orange-red blob
+
+// Packed Palette - colors pre-converted at compile time with every alpha fade (256 steps),
+// so a faded draw color is a table lookup instead of a float -> ImU32 conversion
+constexpr int ToByte(float v)
+{
+    // IM_F32_TO_INT8_SAT
+    return (int)((v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v) * 255.0f + 0.5f);
+}
+
+constexpr ImU32 PackColor(const ImVec4& color)
+{
+    return IM_COL32(ToByte(color.x), ToByte(color.y), ToByte(color.z), ToByte(color.w));
+}
+
+struct PackedColor
+{
+    ImU32 Faded[256]; // Faded[i] = color with its alpha scaled by i / 255
+
+    constexpr ImU32 Get(float alpha = 1.0f) const
+    {
+        return Faded[ToByte(alpha)];
+    }
+};
+
+constexpr PackedColor MakePackedColor(const ImVec4& color)
+{
+    PackedColor packed = {};
+    for (int i = 0; i < 256; i++)
+    {
+        float alpha = color.w * (float)i / 255.0f;
+        packed.Faded[i] = PackColor(ImVec4(color.x, color.y, color.z, alpha));
+    }
+    return packed;
+}
+
+inline constexpr PackedColor GLASS_BG_U32 = MakePackedColor(GLASS_BG);
+inline constexpr PackedColor GLASS_BORDER_U32 = MakePackedColor(GLASS_BORDER);
+inline constexpr PackedColor ACCENT_COLOR_U32 = MakePackedColor(ACCENT_COLOR);
+inline constexpr PackedColor TEXT_PRIMARY_U32 = MakePackedColor(TEXT_PRIMARY);
+inline constexpr PackedColor INPUT_BG_U32 = MakePackedColor(INPUT_BG);
+inline constexpr PackedColor BUTTON_TOP_U32 = MakePackedColor(BUTTON_TOP);
+inline constexpr PackedColor BUTTON_BOTTOM_U32 = MakePackedColor(BUTTON_BOTTOM);
+inline constexpr PackedColor ERROR_COLOR_U32 = MakePackedColor(ERROR_COLOR);
+inline constexpr PackedColor SUCCESS_COLOR_U32 = MakePackedColor(SUCCESS_COLOR);
+inline constexpr PackedColor WHITE_U32 = MakePackedColor(ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
 
 // Blur / Shadow Configuration
 const float BLUR_STRENGTH = 20.0f;     // Base alpha intensity for blur layers
 const float GLASS_SHADOW_SIZE = 15.0f; // Size/Spread of the panel shadow
 const int GLASS_SHADOW_LAYERS = 15;    // Number of layers for smoothness
 
-// Easing Functions
+// Effects Quality - scaled down at runtime on slow machines (RDP, WARP)
+enum class Quality
+{
+    LOW,
+    MEDIUM,
+    HIGH
+};
+
+struct EffectsQuality
+{
+    int GlassShadowLayers;            // Panel shadow layers
+    int ButtonShadowLayers;           // Button shadow layers (0 = no shadow)
+    int NeonLayers;                   // Neon glow rects, 1 keeps only the sharp one
+    bool BackgroundBlobs;             // Animated blobs behind the panel
+    float CircleTessellationMaxError; // ImGuiStyle::CircleTessellationMaxError
+    bool AntiAliasing;                // ImGuiStyle::AntiAliasedLines / AntiAliasedFill
+};
+
+const EffectsQuality QUALITY_LOW = {4, 0, 1, false, 1.20f, false};
+const EffectsQuality QUALITY_MEDIUM = {8, 5, 2, true, 0.60f, true};
+const EffectsQuality QUALITY_HIGH = {GLASS_SHADOW_LAYERS, 10, 3, true, 0.30f, true};
+
+inline Quality s_Quality = Quality::HIGH;
+
+inline void SetQuality(Quality quality)
+{
+    s_Quality = quality;
+}
+
+inline Quality GetQuality()
+{
+    return s_Quality;
+}
+
+inline const EffectsQuality& GetEffects()
+{
+    return s_Quality == Quality::LOW      ? QUALITY_LOW
+           : s_Quality == Quality::MEDIUM ? QUALITY_MEDIUM
+                                          : QUALITY_HIGH;
+}
+
+// Easing Functions (polynomial, cheap enough to run per widget per frame)
 inline float EaseOutCubic(float t)
 {
-    return 1.0f - std::pow(1.0f - t, 3.0f);
+    float u = 1.0f - t;
+    return 1.0f - u * u * u;
 }
 
 inline float EaseOutQuad(float t)
@@ -43,7 +130,8 @@ inline float EaseOutQuad(float t)
 
 inline float EaseInOutQuad(float t)
 {
-    return t < 0.5f ? 2.0f * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 2.0f) / 2.0f;
+    float u = -2.0f * t + 2.0f;
+    return t < 0.5f ? 2.0f * t * t : 1.0f - u * u / 2.0f;
 }
 
 inline float EaseOutElastic(float t)
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+namespace menu
+{
+
+// Handle to one value animated by a TweenSet
+struct Tween
+{
+    int Index = -1;
+};
+
+// All animated values of the menu, stored as arrays (value / target / rate / speed) and
+// advanced together once per frame. Every value chases its target either exponentially
+// (SmoothTo, frame rate independent) or at a constant speed (MoveTo), and stops on it.
+class TweenSet
+{
+  public:
+    Tween Add(float value);
+
+    // Approach target exponentially, rate is the inverse time constant (1/s)
+    void SmoothTo(Tween tween, float target, float rate);
+
+    // Approach target at a constant speed (units/s)
+    void MoveTo(Tween tween, float target, float speed);
+
+    // Jump to value and stop there
+    void Set(Tween tween, float value);
+
+    float Get(Tween tween) const
+    {
+        return m_Value[tween.Index];
+    }
+
+    void Update(float deltaTime);
+
+    // Some value hasn't reached its target yet
+    bool IsAnimating() const
+    {
+        return m_Animating;
+    }
+
+  private:
+    int m_Count = 0;
+    bool m_Animating = false;
+
+    // Padded to a multiple of 4 with idle entries
+    std::vector<float> m_Value;
+    std::vector<float> m_Target;
+    std::vector<float> m_Rate;
+    std::vector<float> m_Speed;
+};
+
+} // namespace menu
@@ -0,0 +1,26 @@
+#pragma once
+#include "69/menu/Platform.h"
+
+namespace menu
+{
+
+// The loader window: dragged by hand (no modal move loop), minimized, and closed through the
+// message loop
+class Win32Platform final : public IPlatform
+{
+  public:
+    explicit Win32Platform(void* hwnd) : m_Hwnd(hwnd)
+    {
+    }
+
+    void GetCursorPos(long& x, long& y) override;
+    void MoveWindow(long dx, long dy) override;
+    void Minimize() override;
+    void Quit() override;
+    void Log(const char* message) override;
+
+  private:
+    void* m_Hwnd; // HWND
+};
+
+} // namespace menu
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace service
+{
+
+static const size_t SHA512_SIZE = 64;
+static const size_t ED25519_PUBLIC_KEY_SIZE = 32;
+static const size_t ED25519_SIGNATURE_SIZE = 64;
+
+void Sha512(const void* data, size_t size, uint8_t digest[SHA512_SIZE]);
+
+// HMAC-SHA-512 (RFC 2104)
+void HmacSha512(const void* key, size_t keySize, const void* data, size_t size,
+                uint8_t digest[SHA512_SIZE]);
+
+// Ed25519 signature check (RFC 8032), plain C++ with no dependency and no allocation.
+// Strict about encodings: a non-canonical R, S or public key is rejected.
+// Verification only, nothing secret goes through it so it is not constant time.
+bool VerifyEd25519(const uint8_t publicKey[ED25519_PUBLIC_KEY_SIZE], const void* message,
+                   size_t size, const uint8_t signature[ED25519_SIGNATURE_SIZE]);
+
+} // namespace service
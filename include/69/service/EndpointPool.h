@@ -0,0 +1,63 @@
+#pragma once
+#include "69/service/HttpClient.h"
+#include "69/service/Operation.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace service
+{
+
+struct RetryPolicy
+{
+    int MaxAttempts = 3;                     // First try included
+    std::chrono::milliseconds BaseDelay{200}; // Before the first retry, doubled after each
+    std::chrono::milliseconds MaxDelay{2000};
+    bool Hedge = true; // Duplicate a slow attempt on the next endpoint
+};
+
+// Equivalent endpoints serving the same idempotent request.
+// A failed attempt (no answer, 5xx, 429) is retried on the next endpoint after an exponential
+// backoff. With hedging, once an attempt runs longer than the p95 of the answers its endpoint
+// gave lately, the request also goes to the next endpoint and the first answer wins.
+class EndpointPool
+{
+  public:
+    // Sends the request to url, called from two threads at once when hedging
+    using SendFn = std::function<HttpResponse(const std::string& url)>;
+
+    explicit EndpointPool(std::vector<std::string> urls, RetryPolicy policy = RetryPolicy());
+
+    // Status 0 when no endpoint answered before the attempts ran out or the token stopped
+    HttpResponse Send(const SendFn& send, const CancellationToken& token);
+
+    const std::vector<std::string>& GetUrls() const
+    {
+        return m_Urls;
+    }
+
+    // How long an attempt on that endpoint runs before it is hedged
+    std::chrono::milliseconds GetHedgeDelay(int endpoint) const;
+
+  private:
+    // Shared with attempt threads that may still be running
+    struct State;
+    struct Race;
+
+    // Sends to one endpoint, an answer's latency goes into its window
+    static HttpResponse TimedSend(const std::shared_ptr<State>& state, int endpoint,
+                                  const std::string& url, const SendFn& send);
+
+    void Launch(const std::shared_ptr<Race>& race, int endpoint, const SendFn& send);
+    HttpResponse Attempt(int endpoint, const SendFn& send, const CancellationToken& token);
+    bool Backoff(int retry, const CancellationToken& token);
+
+    std::vector<std::string> m_Urls;
+    RetryPolicy m_Policy;
+    std::shared_ptr<State> m_State;
+};
+
+} // namespace service
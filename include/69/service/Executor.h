@@ -0,0 +1,39 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace service
+{
+
+// Persistent worker threads for blocking service work (network calls, launches).
+// Two bounded queues, interactive tasks always run before background ones.
+// The workers live as long as the process and are never joined, a task stuck in a socket
+// can't hold up shutdown.
+class Executor
+{
+  public:
+    enum class Priority
+    {
+        INTERACTIVE, // The user is waiting on it (login, launch)
+        BACKGROUND   // Warm-ups, refreshes, telemetry
+    };
+
+    static Executor& Get();
+
+    // False when that priority's queue is full, the task is dropped
+    bool Submit(Priority priority, std::function<void()> task);
+
+  private:
+    Executor(int workers, size_t capacity);
+    void WorkerLoop();
+
+    std::mutex m_Mutex; // Guards the queues
+    std::condition_variable m_Wake;
+    std::deque<std::function<void()>> m_Queues[2]; // Indexed by Priority
+    size_t m_Capacity;
+};
+
+} // namespace service
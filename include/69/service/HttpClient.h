@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace service
+{
+
+struct HttpResponse
+{
+    int Status = 0; // 0 = the request never got an answer
+    std::string Body;
+
+    bool Ok() const
+    {
+        return Status >= 200 && Status < 300;
+    }
+};
+
+// HTTP/1.1 client over one WinHTTP session.
+// Connections are kept per host and reused (keep-alive), TLS sessions are resumed within the
+// session, so only the first request to a host pays the TCP + TLS handshakes.
+class HttpClient
+{
+  public:
+    HttpClient();
+    ~HttpClient();
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    // Open the connection to the host of url ahead of time (DNS lookup, TCP, TLS)
+    bool Warm(const std::string& url);
+
+    HttpResponse Get(const std::string& url);
+    HttpResponse Post(const std::string& url, const std::string& body,
+                      const std::string& contentType = "application/x-www-form-urlencoded");
+
+  private:
+    HttpResponse Send(const wchar_t* verb, const std::string& url, const std::string* body,
+                      const std::string& contentType);
+
+    // WinHTTP connection handle for host:port, opened once and kept
+    void* GetConnection(const std::wstring& host, int port);
+
+    void* m_Session = nullptr; // HINTERNET
+
+    std::mutex m_Mutex; // Guards m_Connections
+    std::map<std::wstring, void*> m_Connections;
+};
+
+} // namespace service
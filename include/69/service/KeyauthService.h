@@ -1,17 +1,63 @@
 #pragma once
 
+#include "69/service/EndpointPool.h"
+#include "69/service/HttpClient.h"
 #include "69/service/Service.h"
 
+#include <mutex>
+
+// Forward declaration
+namespace KeyAuth
+{
+class API;
+}
+
 namespace service
 {
 
 class KeyauthService final : public IService
 {
   public:
-    KeyauthService() = default;
-    bool ValidateUser(const std::string& licenseKey) override;
+    // Opens the KeyAuth session (or the login server connection) in the background right away.
+    // loginServerUrls: comma separated mirrors of a server answering the whole LoginBundle in
+    // one request, see scripts/login_server.py. Empty logs in through keyauth.lib.
+    // With login servers, the signed token of the last login lets the next one skip the network.
+    explicit KeyauthService(const std::string& loginServerUrls = std::string());
+
+    LoginBundle Login(const std::string& licenseKey, const CancellationToken& token) override;
+    bool GetCachedLogin(std::string& licenseKey, LoginBundle& bundle) override;
+    LoginBundle Revalidate(const std::string& licenseKey, const CancellationToken& token) override;
+    OperationResult ValidateUser(const std::string& licenseKey,
+                                 const CancellationToken& token) override;
     std::vector<SoftwareItem> GetAvailableSoftware() override;
-    bool LaunchSoftware(int id) override;
+    OperationResult LaunchSoftware(int id, const CancellationToken& token) override;
+
+  private:
+    // Session held across calls, so a login is a single license() round trip.
+    // Re-initialized when it gets old or the server no longer knows it.
+    // Shared with the background threads, which may outlive the service.
+    struct Session
+    {
+        std::timed_mutex Mutex; // Guards everything below
+        std::unique_ptr<KeyAuth::API> Api;
+        bool Valid = false;
+        std::chrono::steady_clock::time_point Start;
+        size_t UrlIndex = 0; // API endpoint the session was opened on
+    };
+
+    static bool EnsureSession(Session& session, bool forceInit, const CancellationToken& token);
+
+    LoginBundle LoginWithKeyAuth(const std::string& licenseKey, const CancellationToken& token);
+
+    // Keeps the signed license token (see LoginWithToken) in sync with the answer
+    LoginBundle LoginWithServer(const std::string& licenseKey, const CancellationToken& token);
+
+    std::shared_ptr<EndpointPool> m_LoginServers; // Null when logging in through keyauth.lib
+
+    std::shared_ptr<Session> m_Session;
+
+    // Pooled keep-alive connections to the login servers, null with keyauth.lib
+    std::shared_ptr<HttpClient> m_Http;
 };
 
 } // namespace service
@@ -0,0 +1,24 @@
+#pragma once
+#include "69/service/Service.h"
+
+#include <string>
+
+namespace service
+{
+
+// Last login the server accepted, kept so the next start can open on the main menu while the
+// server confirms it again. Encrypted at rest with DPAPI for the current Windows account, and
+// bound to hwid on top of that. Valid for a week after it was saved.
+
+// False when there is none, or it expired, belongs to another machine or doesn't decrypt.
+// One small file read into a fixed layout record, nothing is parsed.
+bool LoadCachedLogin(const std::string& path, const std::string& hwid, std::string& licenseKey,
+                     LoginBundle& bundle);
+
+// False when the bundle doesn't fit the record, which then isn't kept either
+bool SaveCachedLogin(const std::string& path, const std::string& hwid,
+                     const std::string& licenseKey, const LoginBundle& bundle);
+
+void ClearCachedLogin(const std::string& path);
+
+} // namespace service
@@ -0,0 +1,52 @@
+#pragma once
+#include "69/service/Service.h"
+
+#include <cstdint>
+#include <string>
+
+namespace service
+{
+
+// Decrypted contents of the login cache file (LoginCache.h). Fixed size and layout so loading
+// reads it in place: strings are zero terminated arrays, a login that doesn't fit is not cached.
+struct LoginRecord
+{
+    uint32_t Magic;
+    uint32_t Version;
+    long long Expiry; // Unix time
+    char Hwid[128];
+    char LicenseKey[64];
+
+    uint32_t SubscriptionCount;
+    struct
+    {
+        char Name[64];
+        char Expiry[32];
+    } Subscriptions[8];
+
+    uint32_t SoftwareCount;
+    struct
+    {
+        int32_t ID;
+        int32_t IconIndex;
+        char Name[64];
+    } Software[16];
+
+    uint32_t VariableCount;
+    struct
+    {
+        char Name[32];
+        char Value[224];
+    } Variables[8];
+};
+
+// Fills record with a login that expires at expiry (Unix time), false when it doesn't fit
+bool PackLoginRecord(const std::string& hwid, const std::string& licenseKey,
+                     const LoginBundle& bundle, long long expiry, LoginRecord& record);
+
+// The login in record, false unless it is a whole record for this hwid that hasn't expired at
+// now (Unix time). Counts and strings are checked, the file may have been tampered with.
+bool UnpackLoginRecord(const LoginRecord& record, const std::string& hwid, long long now,
+                       std::string& licenseKey, LoginBundle& bundle);
+
+} // namespace service
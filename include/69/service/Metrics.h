@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace service
+{
+
+enum class Metric
+{
+    // IService calls
+    LOGIN,
+    VALIDATE_USER,
+    GET_AVAILABLE_SOFTWARE,
+    LAUNCH_SOFTWARE,
+
+    // keyauth.lib round trips
+    KEYAUTH_INIT,
+    KEYAUTH_LICENSE,
+    KEYAUTH_VAR,
+
+    // Offline login from the cached license token, and the cached login read at startup
+    LICENSE_TOKEN,
+    LOGIN_CACHE,
+
+    // HttpClient request phases, DNS / connect / TLS only when a new connection was opened
+    HTTP_DNS,
+    HTTP_CONNECT,
+    HTTP_TLS,
+    HTTP_WAIT, // Request sent to response headers
+    HTTP_BODY,
+    HTTP_REQUEST, // Whole request
+
+    COUNT
+};
+
+const char* GetMetricName(Metric metric);
+
+// Log-linear latency histogram in microseconds (HDR style): every power of two is split in
+// 8 linear buckets, so any value is off by at most 1/16 from its bucket middle.
+// Record() is lock-free (relaxed atomics, no allocation), it can be called from any thread.
+class LatencyHistogram
+{
+  public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int BUCKET_COUNT = (33 - SUB_BUCKET_BITS) << SUB_BUCKET_BITS;
+
+    void Record(std::chrono::steady_clock::duration latency);
+
+    static int GetBucket(uint32_t micros);
+    static uint32_t GetBucketStart(int bucket);
+
+    // Counts at one point in time, taken bucket by bucket while recording goes on
+    struct Snapshot
+    {
+        uint32_t Counts[BUCKET_COUNT];
+        uint64_t Count;
+        uint64_t SumMicros;
+        uint32_t MaxMicros;
+
+        double GetPercentileMs(double percentile) const;
+    };
+    void Read(Snapshot& snapshot) const;
+
+  private:
+    std::atomic<uint32_t> m_Counts[BUCKET_COUNT] = {};
+    std::atomic<uint64_t> m_SumMicros = 0;
+    std::atomic<uint32_t> m_MaxMicros = 0;
+};
+
+// One histogram per Metric for the whole process
+class Metrics
+{
+  public:
+    static void Record(Metric metric, std::chrono::steady_clock::duration latency);
+
+    // Writes every metric with samples, through a temporary file so a reader never sees
+    // half of it. Safe to call from any thread while recording goes on.
+    static bool WriteJson(const char* path);
+};
+
+// Records the time from construction to destruction
+class ScopedLatency
+{
+  public:
+    explicit ScopedLatency(Metric metric)
+        : m_Metric(metric), m_Start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedLatency()
+    {
+        Metrics::Record(m_Metric, std::chrono::steady_clock::now() - m_Start);
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+  private:
+    Metric m_Metric;
+    std::chrono::steady_clock::time_point m_Start;
+};
+
+} // namespace service
@@ -0,0 +1,159 @@
+#pragma once
+#include "69/service/Executor.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace service
+{
+
+enum class OperationResult
+{
+    SUCCESS,
+    FAILURE, // No answer, or not one to go by
+    DENIED,  // The server answered and refused
+    CANCELLED,
+    TIMED_OUT
+};
+
+// Shared stop flag + deadline of one service operation. Copies share the same state, the
+// caller keeps one to cancel and the operation checks its copy between blocking steps.
+class CancellationToken
+{
+  public:
+    // Never times out
+    CancellationToken() : m_State(std::make_shared<State>())
+    {
+    }
+
+    explicit CancellationToken(std::chrono::steady_clock::duration timeout) : CancellationToken()
+    {
+        m_State->Deadline = std::chrono::steady_clock::now() + timeout;
+    }
+
+    void Cancel()
+    {
+        m_State->Cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool IsCancelled() const
+    {
+        return m_State->Cancelled.load(std::memory_order_relaxed);
+    }
+
+    bool IsExpired() const
+    {
+        return std::chrono::steady_clock::now() >= m_State->Deadline;
+    }
+
+    bool ShouldStop() const
+    {
+        return IsCancelled() || IsExpired();
+    }
+
+    // What to return when bailing out because of ShouldStop()
+    OperationResult GetStopResult() const
+    {
+        return IsCancelled() ? OperationResult::CANCELLED : OperationResult::TIMED_OUT;
+    }
+
+  private:
+    struct State
+    {
+        std::atomic<bool> Cancelled = false;
+        std::chrono::steady_clock::time_point Deadline =
+            std::chrono::steady_clock::time_point::max();
+    };
+
+    std::shared_ptr<State> m_State;
+};
+
+// Service call running on the service Executor, its result lands in an atomic slot the UI
+// thread polls once per frame. Nothing ever waits for the worker: Poll() reports a cancelled
+// or timed out result as soon as the token says so, and a call stuck in a socket is left to
+// finish (or die with the process) on its own.
+class PendingOperation
+{
+  public:
+    // fn(const CancellationToken&) -> OperationResult
+    template <class Fn>
+    static PendingOperation Start(Fn fn, std::chrono::steady_clock::duration timeout,
+                                  Executor::Priority priority = Executor::Priority::INTERACTIVE)
+    {
+        PendingOperation operation;
+        operation.m_State = std::make_shared<State>();
+        operation.m_Token = CancellationToken(timeout);
+
+        auto state = operation.m_State;
+        bool queued = Executor::Get().Submit(priority, [state, token = operation.m_Token, fn]() {
+            state->Result = fn(token);
+            state->Finished = std::chrono::steady_clock::now();
+            state->Done.store(true, std::memory_order_release);
+        });
+
+        // Queue full, fails on the first poll
+        if (!queued)
+        {
+            state->Finished = std::chrono::steady_clock::now();
+            state->Done.store(true, std::memory_order_release);
+        }
+        return operation;
+    }
+
+    bool IsPending() const
+    {
+        return m_State != nullptr;
+    }
+
+    // True once there is a result, the operation is no longer pending after that
+    bool Poll(OperationResult& result)
+    {
+        if (!m_State)
+            return false;
+
+        if (m_State->Done.load(std::memory_order_acquire))
+        {
+            result = m_State->Result;
+            m_Finished = m_State->Finished;
+        }
+        else if (m_Token.ShouldStop())
+        {
+            result = m_Token.GetStopResult();
+            m_Finished = std::chrono::steady_clock::now();
+            m_Token.Cancel(); // Let the thread stop at its next check
+        }
+        else
+        {
+            return false;
+        }
+
+        m_State.reset();
+        return true;
+    }
+
+    void Cancel()
+    {
+        m_Token.Cancel();
+    }
+
+    // When the last polled result came in
+    std::chrono::steady_clock::time_point GetFinishTime() const
+    {
+        return m_Finished;
+    }
+
+  private:
+    struct State
+    {
+        std::atomic<bool> Done = false;
+        OperationResult Result = OperationResult::FAILURE;
+        std::chrono::steady_clock::time_point Finished;
+    };
+
+    std::shared_ptr<State> m_State;
+    CancellationToken m_Token;
+    std::chrono::steady_clock::time_point m_Finished;
+};
+
+} // namespace service
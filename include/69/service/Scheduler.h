@@ -0,0 +1,149 @@
+#pragma once
+#include "69/service/Operation.h"
+#include "69/service/Task.h"
+
+#include <coroutine>
+#include <utility>
+#include <vector>
+
+namespace service
+{
+
+// Runs Tasks on the UI thread, driven by the frame loop.
+// A task runs until it awaits something that isn't ready, from then on Tick() checks it once
+// per frame and resumes it on the frame it becomes ready. Blocking work goes to the Executor
+// (co_await a PendingOperation), so no thread is ever parked on a step of a flow.
+class FrameScheduler
+{
+  public:
+    // Something a task can wait on, checked once per Tick while the task is suspended
+    class Waiter
+    {
+      public:
+        virtual ~Waiter() = default;
+
+        virtual bool IsReady() = 0;
+
+        // The task waiting on it is being dropped
+        virtual void Cancel()
+        {
+        }
+
+        bool await_ready()
+        {
+            return IsReady();
+        }
+
+        // Only valid inside a task started by Spawn, i.e. during Spawn() or Tick()
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            s_Current->m_Waiting.push_back({this, handle});
+        }
+    };
+
+    FrameScheduler() = default;
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+    ~FrameScheduler();
+
+    // Runs the task up to its first suspension, the scheduler owns it from then on
+    void Spawn(Task<void> task);
+
+    // Resume every task whose waiter is ready, once per frame.
+    // Rethrows an exception that escaped a spawned task.
+    void Tick();
+
+    // Cancel what the tasks are waiting on and destroy them, never call it from a task
+    void CancelAll();
+
+    bool HasPending() const
+    {
+        return !m_Tasks.empty();
+    }
+
+  private:
+    struct Suspended
+    {
+        Waiter* Awaited;
+        std::coroutine_handle<> Handle;
+    };
+
+    // Scheduler running a task right now, what Waiter::await_suspend registers with
+    static FrameScheduler* s_Current;
+
+    std::vector<Task<void>> m_Tasks;
+    std::vector<Suspended> m_Waiting;
+};
+
+// co_await NextFrame(): resume on the next Tick
+class NextFrame final : public FrameScheduler::Waiter
+{
+  public:
+    bool IsReady() override
+    {
+        return std::exchange(m_Suspended, true);
+    }
+
+    void await_resume()
+    {
+    }
+
+  private:
+    bool m_Suspended = false;
+};
+
+// co_await Until(fn): resume on the first Tick fn() returns true
+template <class Fn> class Until final : public FrameScheduler::Waiter
+{
+  public:
+    explicit Until(Fn condition) : m_Condition(std::move(condition))
+    {
+    }
+
+    bool IsReady() override
+    {
+        return m_Condition();
+    }
+
+    void await_resume()
+    {
+    }
+
+  private:
+    Fn m_Condition;
+};
+
+// co_await operation: resume with its result on the frame Poll() reports one
+class OperationWaiter final : public FrameScheduler::Waiter
+{
+  public:
+    explicit OperationWaiter(PendingOperation operation) : m_Operation(std::move(operation))
+    {
+    }
+
+    bool IsReady() override
+    {
+        return m_Operation.Poll(m_Result);
+    }
+
+    void Cancel() override
+    {
+        m_Operation.Cancel();
+    }
+
+    OperationResult await_resume() const
+    {
+        return m_Result;
+    }
+
+  private:
+    PendingOperation m_Operation;
+    OperationResult m_Result = OperationResult::FAILURE;
+};
+
+inline OperationWaiter operator co_await(PendingOperation&& operation)
+{
+    return OperationWaiter(std::move(operation));
+}
+
+} // namespace service
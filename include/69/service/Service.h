@@ -1,6 +1,9 @@
 #pragma once
+#include "69/service/Operation.h"
+#include "69/service/Task.h"
 
 #include <chrono>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
@@ -17,14 +20,55 @@ struct SoftwareItem
     int ID;
 };
 
+struct Subscription
+{
+    std::string Name;
+    std::string Expiry;
+};
+
+// Everything the main menu needs after a login, answered by one request
+struct LoginBundle
+{
+    OperationResult Result = OperationResult::FAILURE;
+    std::vector<Subscription> Subscriptions;
+    std::vector<SoftwareItem> Software;           // What the subscriptions entitle to
+    std::map<std::string, std::string> Variables; // App variables the client needs
+    bool Offline = false; // Answered without the server, Revalidate asks it
+};
+
 // Interfaces
+// Blocking calls take a token and should return its stop result soon after it is cancelled
+// or its deadline passes
 class IService
 {
   public:
     virtual ~IService() = default;
-    virtual bool ValidateUser(const std::string& licenseKey) = 0;
+    // May answer offline (LoginBundle::Offline), the caller then revalidates before relying on it
+    virtual LoginBundle Login(const std::string& licenseKey, const CancellationToken& token) = 0;
+
+    // Login kept from an earlier start, to show the main menu before the server confirms it.
+    // Revalidate then asks the server, never an offline shortcut; DENIED drops the cached one.
+    virtual bool GetCachedLogin(std::string& licenseKey, LoginBundle& bundle) = 0;
+    virtual LoginBundle Revalidate(const std::string& licenseKey,
+                                   const CancellationToken& token) = 0;
+    virtual OperationResult ValidateUser(const std::string& licenseKey,
+                                         const CancellationToken& token) = 0;
     virtual std::vector<SoftwareItem> GetAvailableSoftware() = 0;
-    virtual bool LaunchSoftware(int id) = 0;
+    virtual OperationResult LaunchSoftware(int id, const CancellationToken& token) = 0;
 };
 
+// Awaitable versions for tasks run by a FrameScheduler.
+// The blocking call goes to the Executor, the awaiting task resumes on the frame it finishes
+// or times out. The service is shared with the worker, which may outlive the caller.
+Task<LoginBundle> LoginAsync(std::shared_ptr<IService> service, std::string licenseKey,
+                             std::chrono::steady_clock::duration timeout);
+Task<LoginBundle> RevalidateAsync(std::shared_ptr<IService> service, std::string licenseKey,
+                                  std::chrono::steady_clock::duration timeout);
+Task<OperationResult> ValidateUserAsync(std::shared_ptr<IService> service, std::string licenseKey,
+                                        std::chrono::steady_clock::duration timeout);
+Task<std::vector<SoftwareItem>> GetAvailableSoftwareAsync(
+    std::shared_ptr<IService> service, std::chrono::steady_clock::duration timeout);
+Task<OperationResult> LaunchSoftwareAsync(std::shared_ptr<IService> service, int id,
+                                          std::chrono::steady_clock::duration timeout);
+
 } // namespace service
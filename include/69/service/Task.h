@@ -0,0 +1,183 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace service
+{
+
+template <class T> class Task;
+
+namespace detail
+{
+
+// Shared by Task<T> and Task<void>: lazy start, resumes whoever awaited it when done
+struct TaskPromiseBase
+{
+    struct FinalAwaiter
+    {
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            std::coroutine_handle<> continuation = handle.promise().Continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {
+        }
+    };
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception()
+    {
+        Exception = std::current_exception();
+    }
+
+    std::coroutine_handle<> Continuation;
+    std::exception_ptr Exception;
+};
+
+template <class T> struct TaskPromise : TaskPromiseBase
+{
+    Task<T> get_return_object();
+
+    template <class U> void return_value(U&& value)
+    {
+        Value.emplace(std::forward<U>(value));
+    }
+
+    T TakeResult()
+    {
+        if (Exception)
+            std::rethrow_exception(Exception);
+        return std::move(*Value);
+    }
+
+    std::optional<T> Value;
+};
+
+template <> struct TaskPromise<void> : TaskPromiseBase
+{
+    Task<void> get_return_object();
+
+    void return_void()
+    {
+    }
+
+    void TakeResult()
+    {
+        if (Exception)
+            std::rethrow_exception(Exception);
+    }
+};
+
+} // namespace detail
+
+// Lazily started coroutine returning T.
+// Nothing runs until it is awaited by another task or handed to FrameScheduler::Spawn, the
+// awaiting coroutine is resumed right where the task finishes. Owns its frame, destroying a
+// suspended task destroys every task it is awaiting too.
+template <class T = void> class Task
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : m_Handle(handle)
+    {
+    }
+
+    Task(Task&& other) noexcept : m_Handle(std::exchange(other.m_Handle, nullptr))
+    {
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_Handle)
+                m_Handle.destroy();
+            m_Handle = std::exchange(other.m_Handle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        if (m_Handle)
+            m_Handle.destroy();
+    }
+
+    bool IsDone() const
+    {
+        return !m_Handle || m_Handle.done();
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            Handle Coroutine;
+
+            bool await_ready() noexcept
+            {
+                return !Coroutine || Coroutine.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                Coroutine.promise().Continuation = awaiting;
+                return Coroutine;
+            }
+
+            T await_resume()
+            {
+                return Coroutine.promise().TakeResult();
+            }
+        };
+        return Awaiter{m_Handle};
+    }
+
+  private:
+    friend class FrameScheduler;
+
+    Handle m_Handle;
+};
+
+namespace detail
+{
+
+template <class T> Task<T> TaskPromise<T>::get_return_object()
+{
+    return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object()
+{
+    return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+} // namespace detail
+
+} // namespace service
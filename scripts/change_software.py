@@ -1,67 +1,11 @@
 """
-Script to convert software.png to C++ header file with raw bytes
+Script to convert software.png to the C++ header file the loader uploads from:
+decoded to RGBA8 at the size it is drawn here, so the program never decodes it
 Usage: python change_software.py
 """
 
-import os
 from pathlib import Path
-from PIL import Image
-
-def get_image_dimensions(image_path):
-    """Get width and height of the image"""
-    try:
-        with Image.open(image_path) as img:
-            return img.width, img.height
-    except Exception as e:
-        print(f"Warning: Could not read image dimensions: {e}")
-        return 128, 128  # Default dimensions
-
-def read_png_as_bytes(png_path):
-    """Read PNG file as raw bytes"""
-    with open(png_path, 'rb') as f:
-        return f.read()
-
-def bytes_to_cpp_array(data, bytes_per_line=12):
-    """Convert bytes to C++ array format"""
-    lines = []
-    for i in range(0, len(data), bytes_per_line):
-        chunk = data[i:i + bytes_per_line]
-        hex_values = ', '.join(f'0x{b:02X}' for b in chunk)
-        lines.append(f'    {hex_values}')
-    
-    return ',\n'.join(lines)
-
-def create_logo_header(logo_bytes, width, height, output_path):
-    """Create Logo.h header file"""
-    
-    cpp_array = bytes_to_cpp_array(logo_bytes)
-    array_size = len(logo_bytes)
-    
-    header_content = f"""#pragma once
-
-namespace resource
-{{
-
-inline int s_SoftwareWidth = {width};
-inline int s_SoftwareHeight = {height};
-
-inline unsigned char s_Software[{array_size}] = {{
-{cpp_array}
-}};
-
-}} // namespace resource
-"""
-    
-    # Ensure output directory exists
-    os.makedirs(os.path.dirname(output_path), exist_ok=True)
-    
-    # Write header file
-    with open(output_path, 'w', encoding='utf-8') as f:
-        f.write(header_content)
-    
-    print(f"✓ Created {output_path}")
-    print(f"  - Image size: {width}x{height}")
-    print(f"  - Array size: {array_size} bytes")
+from texture_header import build_mip_chain, create_texture_header
 
 def main():
     # Define paths
@@ -72,25 +16,24 @@ def main():
     print(f"Software path: {software_path}")
     print(f"Output path: {output_path}")
     
-    # Check if logo.png exists
+    # Check if software.png exists
     if not software_path.exists():
         print(f"❌ Error: {software_path} not found!")
         print(f"   Please place software.png in the same directory as this script.")
         return 1
     
-    # Get image dimensions
-    width, height = get_image_dimensions(software_path)
-    
-    # Read PNG as bytes
+    # Decode and keep the level it is drawn with: 120 to 140 px in DrawMainMenu and
+    # DrawLaunchingScreen, the 128 px one
     print(f"\nReading {software_path}...")
-    software_bytes = read_png_as_bytes(software_path)
+    width, height, mip_count, software_bytes = build_mip_chain(software_path, first_level=1,
+                                                                 level_count=1)
     
     # Create header file
     print(f"Creating C++ header file...")
-    create_logo_header(software_bytes, width, height, output_path)
+    create_texture_header('Software', software_bytes, width, height, mip_count, 'change_software.py', output_path)
     
     print("\n✓ Done!")
     return 0
 
 if __name__ == '__main__':
-    exit(main())
\ No newline at end of file
+    exit(main())
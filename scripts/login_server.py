@@ -0,0 +1,206 @@
+"""
+Local stand-in for the login bundle server
+Usage: python login_server.py [port] [--latency=ms] [--loss=fraction]
+Then run the loader with --login-server=http://127.0.0.1:6969/
+
+--latency and --loss slow down and drop logins, to try the retries and hedging against
+several instances: start two on different ports, e.g. one with --latency=3000 and one
+with --loss=0.3, and pass both as --login-server=http://127.0.0.1:6969/,http://127.0.0.1:6970/
+
+One POST answers validation, subscriptions, the entitled catalog and the requested app
+variables together. A real server would check the key against KeyAuth (seller API) and
+its own entitlement table, here they are the tables below.
+
+The answer also carries a license token: the same entitlements with a salted key HMAC, the
+client's HWID and an expiry, signed with Ed25519. The loader keeps it and logs in from it
+offline next time, then confirms it with the server before launching anything.
+"""
+
+import hashlib
+import hmac
+import os
+import random
+import sys
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs
+
+# License key -> subscriptions (name, expiry as unix time)
+LICENSES = {
+    '69-TEST-KEY': [('default', '4102444800')],
+}
+
+# Subscription -> software it unlocks (id, icon index, name)
+ENTITLEMENTS = {
+    'default': [(0, 0, 'FPS Boost System')],
+}
+
+# App variables
+VARIABLES = {
+    'motd': 'Welcome back',
+}
+
+# Token signing key. Stand-in only: this seed is public, anyone can sign tokens with it. A real
+# server keeps its own secret, and the loader checks against its public key in
+# GetTokenPublicKey() (KeyauthService.cpp), which ships empty with tokens turned off.
+SIGNING_SEED = bytes.fromhex('1f2d8748cc8504e7e377a352997c7253e8bdfe51806f608d9d1dcc229a0e0e3c')
+
+# How long a token lets the loader log in offline
+TOKEN_LIFETIME = 7 * 24 * 3600
+
+# Ed25519 signing (RFC 8032), slow but enough for a test server
+ED_P = 2**255 - 19
+ED_L = 2**252 + 27742317777372353535851937790883648493
+ED_D = -121665 * pow(121666, ED_P - 2, ED_P) % ED_P
+
+def ed_add(p, q):
+    a = (p[1] - p[0]) * (q[1] - q[0]) % ED_P
+    b = (p[1] + p[0]) * (q[1] + q[0]) % ED_P
+    c = 2 * p[3] * q[3] * ED_D % ED_P
+    d = 2 * p[2] * q[2] % ED_P
+    e, f, g, h = b - a, d - c, d + c, b + a
+    return (e * f % ED_P, g * h % ED_P, f * g % ED_P, e * h % ED_P)
+
+def ed_mul(s, p):
+    q = (0, 1, 1, 0)
+    while s > 0:
+        if s & 1:
+            q = ed_add(q, p)
+        p = ed_add(p, p)
+        s >>= 1
+    return q
+
+def ed_encode(p):
+    z = pow(p[2], ED_P - 2, ED_P)
+    x, y = p[0] * z % ED_P, p[1] * z % ED_P
+    return int.to_bytes(y | ((x & 1) << 255), 32, 'little')
+
+def ed_base():
+    y = 4 * pow(5, ED_P - 2, ED_P) % ED_P
+    x2 = (y * y - 1) * pow(ED_D * y * y + 1, ED_P - 2, ED_P)
+    x = pow(x2, (ED_P + 3) // 8, ED_P)
+    if (x * x - x2) % ED_P != 0:
+        x = x * pow(2, (ED_P - 1) // 4, ED_P) % ED_P
+    if x & 1:
+        x = ED_P - x
+    return (x, y, 1, x * y % ED_P)
+
+def ed_hash(data):
+    return int.from_bytes(hashlib.sha512(data).digest(), 'little')
+
+def ed_expand(seed):
+    h = hashlib.sha512(seed).digest()
+    a = int.from_bytes(h[:32], 'little') & ((1 << 254) - 8) | (1 << 254)
+    return a, h[32:]
+
+def ed_public_key(seed):
+    return ed_encode(ed_mul(ed_expand(seed)[0], ed_base()))
+
+def ed_sign(seed, message):
+    a, prefix = ed_expand(seed)
+    public = ed_encode(ed_mul(a, ed_base()))
+    r = ed_hash(prefix + message) % ED_L
+    encoded_r = ed_encode(ed_mul(r, ed_base()))
+    s = (r + ed_hash(encoded_r + public + message) * a) % ED_L
+    return encoded_r + int.to_bytes(s, 32, 'little')
+
+def escape(value):
+    """Escape a field for the tab separated answer"""
+    return str(value).replace('\\', '\\\\').replace('\t', '\\t').replace('\n', '\\n')
+
+def record(*fields):
+    """One answer line"""
+    return '\t'.join(escape(f) for f in fields) + '\n'
+
+def build_bundle(key, hwid, variables):
+    """Answer body for a login with key from machine hwid, asking for the given variable names"""
+    subscriptions = LICENSES.get(key)
+    if subscriptions is None:
+        return record('result', 'Invalid license key')
+
+    missing = [name for name in variables if name not in VARIABLES]
+    if missing:
+        return record('result', f"Unknown variable {missing[0]}")
+
+    entitlements = []
+    for name, expiry in subscriptions:
+        entitlements.append(record('sub', name, expiry))
+    for name, _ in subscriptions:
+        for app_id, icon, app_name in ENTITLEMENTS.get(name, []):
+            entitlements.append(record('app', app_id, icon, app_name))
+    for name in variables:
+        entitlements.append(record('var', name, VARIABLES[name]))
+
+    lines = [record('result', 'ok')] + entitlements
+    if hwid:
+        # The key itself is never in the token, only an HMAC keyed with it over a random salt
+        salt = os.urandom(16)
+        user = hmac.new(key.encode('utf-8'), salt, hashlib.sha512).hexdigest()
+        claims = (record('user', salt.hex(), user) +
+                  record('hwid', hwid) +
+                  record('exp', int(time.time()) + TOKEN_LIFETIME) +
+                  ''.join(entitlements))
+        signature = ed_sign(SIGNING_SEED, claims.encode('utf-8'))
+        lines.append(record('token', claims, signature.hex()))
+    return ''.join(lines)
+
+class LoginHandler(BaseHTTPRequestHandler):
+    # Keep-alive, the loader reuses its connection
+    protocol_version = 'HTTP/1.1'
+
+    # Injected faults, set from the command line
+    latency = 0.0
+    loss = 0.0
+
+    def send_body(self, status, body):
+        data = body.encode('utf-8')
+        self.send_response(status)
+        self.send_header('Content-Type', 'text/plain; charset=utf-8')
+        self.send_header('Content-Length', str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def do_HEAD(self):
+        # Connection warm-up
+        self.send_response(200)
+        self.send_header('Content-Length', '0')
+        self.end_headers()
+
+    def do_POST(self):
+        length = int(self.headers.get('Content-Length', 0))
+        form = parse_qs(self.rfile.read(length).decode('utf-8'))
+        key = form.get('key', [''])[0]
+        hwid = form.get('hwid', [''])[0]
+        variables = [v for v in form.get('vars', [''])[0].split(',') if v]
+
+        time.sleep(self.latency * random.uniform(0.5, 1.5))
+        if random.random() < self.loss:
+            # Dropped, the client sees the connection close without an answer
+            self.close_connection = True
+            return
+
+        self.send_body(200, build_bundle(key, hwid, variables))
+
+def main():
+    port = 6969
+    for arg in sys.argv[1:]:
+        if arg.startswith('--latency='):
+            LoginHandler.latency = float(arg.split('=', 1)[1]) / 1000.0
+        elif arg.startswith('--loss='):
+            LoginHandler.loss = float(arg.split('=', 1)[1])
+        else:
+            port = int(arg)
+
+    server = ThreadingHTTPServer(('127.0.0.1', port), LoginHandler)
+    print(f"Login server on http://127.0.0.1:{port}/")
+    print(f"  - Test license: {next(iter(LICENSES))}")
+    print(f"  - Latency: {LoginHandler.latency * 1000:.0f} ms, loss: {LoginHandler.loss:.0%}")
+    print(f"  - Token public key: {ed_public_key(SIGNING_SEED).hex()}")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+if __name__ == '__main__':
+    exit(main())
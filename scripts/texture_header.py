@@ -0,0 +1,88 @@
+"""
+Shared by change_logo.py and change_software.py: decodes an image into the RGBA8 mip levels
+the loader uploads as is, and writes them as a C++ header
+"""
+
+import os
+from PIL import Image
+
+def get_mip_count(width, height):
+    """Levels down to 1x1, each half the previous size rounded down"""
+    count = 1
+    while max(width, height) >> count:
+        count += 1
+    return count
+
+def build_mip_chain(image_path, first_level=0, level_count=None):
+    """Decode the image and return (width, height, level count, RGBA8 bytes of the levels kept).
+    Only levels first_level to first_level + level_count - 1 are kept, every level down to 1x1
+    when level_count is None: the loader draws an image at one size, the others are dead weight.
+    Levels follow each other, tightly packed, level i is max(1, width >> i) x max(1, height >> i)
+    and width, height are those of the first level kept"""
+    with Image.open(image_path) as img:
+        base = img.convert('RGBA')
+
+    width, height = base.size
+    last_level = get_mip_count(width, height) - 1
+    if level_count is not None:
+        last_level = min(last_level, first_level + level_count - 1)
+
+    # Every level is an area average of the full image, done on premultiplied colors so
+    # transparent pixels don't darken the edges
+    premultiplied = base.convert('RGBa')
+    data = bytearray()
+    for level in range(first_level, last_level + 1):
+        if level == 0:
+            data += base.tobytes()
+            continue
+        size = (max(1, width >> level), max(1, height >> level))
+        mip = premultiplied.resize(size, Image.BOX).convert('RGBA')
+        data += mip.tobytes()
+
+    return (max(1, width >> first_level), max(1, height >> first_level),
+            last_level - first_level + 1, bytes(data))
+
+def bytes_to_cpp_array(data, bytes_per_line=12):
+    """Convert bytes to C++ array format"""
+    lines = []
+    for i in range(0, len(data), bytes_per_line):
+        chunk = data[i:i + bytes_per_line]
+        hex_values = ', '.join(f'0x{b:02X}' for b in chunk)
+        lines.append(f'    {hex_values}')
+
+    return ',\n'.join(lines)
+
+def create_texture_header(name, data, width, height, mip_count, script_name, output_path):
+    """Create the header declaring s_<name>, s_<name>Width, s_<name>Height, s_<name>MipCount"""
+
+    cpp_array = bytes_to_cpp_array(data)
+    array_size = len(data)
+
+    layout = 'one mip level' if mip_count == 1 else f'{mip_count} mip levels one after the other'
+    header_content = f"""#pragma once
+
+namespace resource
+{{
+
+// Generated by scripts/{script_name}: RGBA8, {layout}
+inline constexpr int s_{name}Width = {width};
+inline constexpr int s_{name}Height = {height};
+inline constexpr int s_{name}MipCount = {mip_count};
+
+inline const unsigned char s_{name}[{array_size}] = {{
+{cpp_array}
+}};
+
+}} // namespace resource
+"""
+
+    # Ensure output directory exists
+    os.makedirs(os.path.dirname(output_path), exist_ok=True)
+
+    # Write header file
+    with open(output_path, 'w', encoding='utf-8') as f:
+        f.write(header_content)
+
+    print(f"✓ Created {output_path}")
+    print(f"  - Image size: {width}x{height}, {mip_count} mips")
+    print(f"  - Array size: {array_size} bytes")
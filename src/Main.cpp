@@ -1,29 +1,69 @@
+#include "69/core/FrameClock.h"
+#include "69/core/FrameGovernor.h"
+#include "69/menu/D3D11Texture.h"
+#include "69/menu/DrawStats.h"
 #include "69/menu/Menu.h"
+#include "69/menu/QualityController.h"
+#include "69/menu/SoftwareRenderer.h"
+#include "69/menu/Win32Platform.h"
 #include "69/resource/fonts/FontAwesome.h"
 #include "69/resource/fonts/FontPrompt.h"
 #include "69/resource/fonts/IconsFontAwesome.h"
+#include "69/service/Executor.h"
+#include "69/service/KeyauthService.h"
+#include "69/service/Metrics.h"
 #include "dx11/D3D11.h"
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_dx11.h"
 #include "imgui/imgui_impl_win32.h"
 #include "obfuscate/obfuscate.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <dwmapi.h>
+#include <string>
 #include <tchar.h>
+#include <wchar.h>
 
 // Data
 static ID3D11Device* g_pd3dDevice = nullptr;
 static ID3D11DeviceContext* g_pd3dDeviceContext = nullptr;
 static IDXGISwapChain* g_pSwapChain = nullptr;
 static ID3D11RenderTargetView* g_mainRenderTargetView = nullptr;
+static core::FrameGovernor g_FrameGovernor;
+
+// Software rendering: the framebuffer goes through this DIB section to UpdateLayeredWindow
+static HDC g_SoftwareDC = nullptr;
+static HBITMAP g_SoftwareBitmap = nullptr;
+static unsigned int* g_SoftwareBits = nullptr;
+static int g_SoftwareWidth = 0;
+static int g_SoftwareHeight = 0;
+
+// Seconds between two writes of the metrics file
+static const double METRICS_FLUSH_INTERVAL = 10.0;
 
 // Forward declarations of helper functions
 bool CreateDeviceD3D(HWND hWnd);
 void CleanupDeviceD3D();
 void CreateRenderTarget();
 void CleanupRenderTarget();
+void PresentSoftware(HWND hWnd, const menu::SoftwareRenderer& renderer);
+void CleanupSoftware();
 LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
+// Value of a --name=value option, ASCII only, empty if missing
+static std::string GetCommandLineValue(const wchar_t* cmdLine, const wchar_t* option)
+{
+    const wchar_t* value = cmdLine ? wcsstr(cmdLine, option) : nullptr;
+    if (!value)
+        return std::string();
+
+    std::string result;
+    for (value += wcslen(option); *value && *value != L' '; value++)
+        result += (char)*value;
+    return result;
+}
+
 // Main code
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine, int nCmdShow)
 {
@@ -55,12 +95,13 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
                                 OBF(L"69iMgUi69"), WS_POPUP, winX, winY, winWidth, winHeight,
                                 nullptr, nullptr, wc.hInstance, nullptr);
 
-    // Initialize Direct3D
-    if (!CreateDeviceD3D(hwnd))
+    // Initialize Direct3D, rendered on the CPU instead with --software-renderer or when no
+    // device can be created (not even WARP: no GPU driver, some VMs and remote sessions)
+    bool softwareRendering = pCmdLine && wcsstr(pCmdLine, L"--software-renderer") != nullptr;
+    if (!softwareRendering && !CreateDeviceD3D(hwnd))
     {
         CleanupDeviceD3D();
-        UnregisterClassW(wc.lpszClassName, wc.hInstance);
-        return 1;
+        softwareRendering = true;
     }
 
     // Show the window
@@ -106,25 +147,84 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
                                    resource::s_FontAwesome_ttf_len, 16.0f, &icons_config,
                                    icons_ranges);
 
+    // Textures live in the renderer's memory when software rendering
+    menu::D3D11TextureFactory d3dTextures(g_pd3dDevice);
+    menu::MemoryTextureFactory memoryTextures;
+    menu::ITextureFactory& textures =
+        softwareRendering ? (menu::ITextureFactory&)memoryTextures : d3dTextures;
+    menu::SoftwareRenderer softwareRenderer(memoryTextures, softwareRendering ? 0 : 1);
+
     // Setup Platform/Renderer backends
     ImGui_ImplWin32_Init(hwnd);
-    ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
+    if (softwareRendering)
+    {
+        softwareRenderer.Init();
+    }
+    else
+    {
+        ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
 
-    // Transparency for the window
-    SetLayeredWindowAttributes(hwnd, 0, 255, LWA_ALPHA);
+        // Transparency for the window, software frames come with per-pixel alpha instead
+        SetLayeredWindowAttributes(hwnd, 0, 255, LWA_ALPHA);
 
-    // Enable Blur Behind (Windows 10/11 Aero/Acrylic)
-    const MARGINS margins = {-1};
-    DwmExtendFrameIntoClientArea(hwnd, &margins);
+        // Enable Blur Behind (Windows 10/11 Aero/Acrylic)
+        const MARGINS margins = {-1};
+        DwmExtendFrameIntoClientArea(hwnd, &margins);
+    }
 
     // Our state
     ImVec4 clear_color = ImVec4(0.0f, 0.0f, 0.0f, 0.0f); // Transparent clear
-    menu::Menu app;
+    // Log in through bundle servers instead of KeyAuth: --login-server=<url>[,<mirror>...]
+    auto loginService = std::make_shared<service::KeyauthService>(
+        GetCommandLineValue(pCmdLine, L"--login-server="));
+    menu::Win32Platform platform(hwnd);
+    menu::Menu app(loginService, platform, textures);
+
+    // Per-state draw statistics: run with --draw-stats, written to draw_stats.json on exit
+    bool recordDrawStats = pCmdLine && wcsstr(pCmdLine, L"--draw-stats") != nullptr;
+    menu::DrawStatsRecorder drawStatsRecorder;
+
+    // Frame time overlay: run with --frame-stats
+    bool showFrameStats = pCmdLine && wcsstr(pCmdLine, L"--frame-stats") != nullptr;
+    core::FrameClock frameClock;
+
+    // Effects quality follows the frame time unless pinned with --quality=low|medium|high
+    menu::QualityController qualityController;
+    if (pCmdLine && wcsstr(pCmdLine, L"--quality=low"))
+        qualityController.Force(theme::Quality::LOW);
+    else if (pCmdLine && wcsstr(pCmdLine, L"--quality=medium"))
+        qualityController.Force(theme::Quality::MEDIUM);
+    else if (pCmdLine && wcsstr(pCmdLine, L"--quality=high"))
+        qualityController.Force(theme::Quality::HIGH);
+
+    // Service latency histograms: run with --metrics=<path>, rewritten every few seconds for
+    // a scraper to pick up, and on exit
+    std::string metricsPath = GetCommandLineValue(pCmdLine, L"--metrics=");
+    double nextMetricsFlush = frameClock.Now() + METRICS_FLUSH_INTERVAL;
 
     // Main loop
     bool done = false;
+    bool renderedLast = false; // Previous iteration rendered, so this delta is a real frame time
     while (!done)
     {
+        // Block until a message arrives or the governor wants the next frame
+        double waitTimeout = g_FrameGovernor.GetWaitTimeout(frameClock.Now());
+        bool backToBack = renderedLast && waitTimeout == 0.0;
+        renderedLast = false;
+        if (!metricsPath.empty())
+        {
+            // Wake up for the flush even when idle
+            double untilFlush = std::max(nextMetricsFlush - frameClock.Now(), 0.0);
+            if (waitTimeout < 0.0 || waitTimeout > untilFlush)
+                waitTimeout = untilFlush;
+        }
+        if (waitTimeout != 0.0)
+        {
+            DWORD waitMs = waitTimeout < 0.0 ? INFINITE : (DWORD)(waitTimeout * 1000.0);
+            ::MsgWaitForMultipleObjectsEx(0, nullptr, waitMs, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        }
+        double wakeTime = frameClock.Now(); // Frame intervals count from here, Present included
+
         MSG msg;
         while (::PeekMessage(&msg, nullptr, 0U, 0U, PM_REMOVE))
         {
@@ -132,36 +232,121 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
             ::DispatchMessage(&msg);
             if (msg.message == WM_QUIT)
                 done = true;
+            g_FrameGovernor.NotifyInput(frameClock.Now());
         }
         if (done)
             break;
 
+        if (!metricsPath.empty() && frameClock.Now() >= nextMetricsFlush)
+        {
+            nextMetricsFlush = frameClock.Now() + METRICS_FLUSH_INTERVAL;
+            service::Executor::Get().Submit(
+                service::Executor::Priority::BACKGROUND,
+                [metricsPath]() { service::Metrics::WriteJson(metricsPath.c_str()); });
+        }
+
+        // Nothing visible to render
+        if (g_FrameGovernor.IsMinimized())
+            continue;
+        if (g_FrameGovernor.IsOccluded())
+        {
+            if (g_pSwapChain->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED)
+            {
+                g_FrameGovernor.FrameRendered(frameClock.Now());
+                continue;
+            }
+            g_FrameGovernor.SetOccluded(false);
+        }
+
+        // Apply the effects quality before any geometry is built this frame
+        theme::SetQuality(qualityController.GetTier());
+        const theme::EffectsQuality& effects = theme::GetEffects();
+        ImGuiStyle& style = ImGui::GetStyle();
+        if (style.CircleTessellationMaxError != effects.CircleTessellationMaxError)
+        {
+            style.CircleTessellationMaxError = effects.CircleTessellationMaxError;
+            style.AntiAliasedLines = effects.AntiAliasing;
+            style.AntiAliasedFill = effects.AntiAliasing;
+        }
+
         // Start the Dear ImGui frame
-        ImGui_ImplDX11_NewFrame();
+        if (!softwareRendering)
+            ImGui_ImplDX11_NewFrame();
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
 
         // Application Logic
-        app.Render(1.0f / 75.0f, (void*)hwnd, g_pd3dDevice); // Pass HWND and D3D Device
+        double frameStart = frameClock.Now();
+        menu::AppState frameState = app.GetState();
+
+        // Measured, clamped step (refresh rate and throttling independent)
+        float deltaTime = frameClock.Tick();
+        if (backToBack)
+            qualityController.AddFrame(deltaTime);
+        app.Render(deltaTime);
+
+        if (showFrameStats)
+        {
+            core::FrameTimeHistory::Stats stats = frameClock.GetHistory().GetStats();
+            char text[96];
+            snprintf(text, sizeof(text), "p50 %.1f ms  p99 %.1f ms  max %.1f ms",
+                     stats.P50 * 1000.0f, stats.P99 * 1000.0f, stats.Max * 1000.0f);
+            ImGui::GetForegroundDrawList()->AddText(ImVec2(30.0f, 480.0f),
+                                                    IM_COL32(255, 255, 255, 160), text);
+        }
 
         // Rendering
         ImGui::Render();
+        if (recordDrawStats)
+        {
+            menu::DrawStats stats = menu::CollectDrawStats(ImGui::GetDrawData());
+            stats.CpuMs = (frameClock.Now() - frameStart) * 1000.0;
+            drawStatsRecorder.Record(frameState, stats);
+        }
+
         const float clear_color_with_alpha[4] = {clear_color.x * clear_color.w,
                                                  clear_color.y * clear_color.w,
                                                  clear_color.z * clear_color.w, clear_color.w};
-        g_pd3dDeviceContext->OMSetRenderTargets(1, &g_mainRenderTargetView, nullptr);
-        g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, clear_color_with_alpha);
-        ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+        if (softwareRendering)
+        {
+            softwareRenderer.Render(ImGui::GetDrawData(),
+                                    ImGui::ColorConvertFloat4ToU32(ImVec4(
+                                        clear_color_with_alpha[0], clear_color_with_alpha[1],
+                                        clear_color_with_alpha[2], clear_color_with_alpha[3])));
+            PresentSoftware(hwnd, softwareRenderer);
+        }
+        else
+        {
+            g_pd3dDeviceContext->OMSetRenderTargets(1, &g_mainRenderTargetView, nullptr);
+            g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView,
+                                                       clear_color_with_alpha);
+            ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
 
-        g_pSwapChain->Present(1, 0); // Present with vsync
+            HRESULT presentResult = g_pSwapChain->Present(1, 0); // Present with vsync
+            g_FrameGovernor.SetOccluded(presentResult == DXGI_STATUS_OCCLUDED);
+        }
+
+        g_FrameGovernor.SetAnimating(app.IsAnimating());
+        g_FrameGovernor.SetAmbientAnimating(app.HasAmbientAnimation());
+        g_FrameGovernor.FrameRendered(wakeTime);
+        renderedLast = true;
     }
 
+    if (recordDrawStats)
+        drawStatsRecorder.WriteJson("draw_stats.json");
+    if (!metricsPath.empty())
+        service::Metrics::WriteJson(metricsPath.c_str());
+
     // Cleanup
-    ImGui_ImplDX11_Shutdown();
+    if (softwareRendering)
+        softwareRenderer.Shutdown();
+    else
+        ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
 
     CleanupDeviceD3D();
+    CleanupSoftware();
     DestroyWindow(hwnd);
     UnregisterClassW(wc.lpszClassName, wc.hInstance);
 
@@ -249,6 +434,76 @@ void CleanupRenderTarget()
     }
 }
 
+// Copies the software framebuffer to the layered window, per-pixel alpha. The renderer's
+// RGBA is already premultiplied, only R and B swap places for the DIB's BGRA.
+void PresentSoftware(HWND hWnd, const menu::SoftwareRenderer& renderer)
+{
+    int width = renderer.GetWidth();
+    int height = renderer.GetHeight();
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (width != g_SoftwareWidth || height != g_SoftwareHeight)
+    {
+        CleanupSoftware();
+        BITMAPINFO bmi = {};
+        bmi.bmiHeader.biSize = sizeof(bmi.bmiHeader);
+        bmi.bmiHeader.biWidth = width;
+        bmi.bmiHeader.biHeight = -height; // Top-down
+        bmi.bmiHeader.biPlanes = 1;
+        bmi.bmiHeader.biBitCount = 32;
+        bmi.bmiHeader.biCompression = BI_RGB;
+
+        void* bits = nullptr;
+        g_SoftwareDC = CreateCompatibleDC(nullptr);
+        g_SoftwareBitmap = CreateDIBSection(g_SoftwareDC, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+        if (!g_SoftwareBitmap)
+        {
+            CleanupSoftware();
+            return;
+        }
+        SelectObject(g_SoftwareDC, g_SoftwareBitmap);
+        g_SoftwareBits = (unsigned int*)bits;
+        g_SoftwareWidth = width;
+        g_SoftwareHeight = height;
+    }
+
+    const ImU32* pixels = renderer.GetPixels();
+    for (int y = 0; y < height; y++)
+    {
+        const ImU32* source = pixels + (size_t)y * renderer.GetPitch();
+        unsigned int* dest = g_SoftwareBits + (size_t)y * width;
+        for (int x = 0; x < width; x++)
+        {
+            ImU32 p = source[x];
+            dest[x] = (p & 0xFF00FF00) | ((p & 0xFF) << 16) | ((p >> 16) & 0xFF);
+        }
+    }
+
+    SIZE size = {width, height};
+    POINT origin = {0, 0};
+    BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+    UpdateLayeredWindow(hWnd, nullptr, nullptr, &size, g_SoftwareDC, &origin, 0, &blend,
+                        ULW_ALPHA);
+}
+
+void CleanupSoftware()
+{
+    if (g_SoftwareDC)
+    {
+        DeleteDC(g_SoftwareDC);
+        g_SoftwareDC = nullptr;
+    }
+    if (g_SoftwareBitmap)
+    {
+        DeleteObject(g_SoftwareBitmap);
+        g_SoftwareBitmap = nullptr;
+    }
+    g_SoftwareBits = nullptr;
+    g_SoftwareWidth = 0;
+    g_SoftwareHeight = 0;
+}
+
 // Forward declare message handler from imgui_impl_win32.cpp
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam,
                                                              LPARAM lParam);
@@ -261,6 +516,7 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
     switch (msg)
     {
     case WM_SIZE:
+        g_FrameGovernor.SetMinimized(wParam == SIZE_MINIMIZED);
         if (g_pd3dDevice != nullptr && wParam != SIZE_MINIMIZED)
         {
             CleanupRenderTarget();
@@ -269,6 +525,9 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
             CreateRenderTarget();
         }
         return 0;
+    case WM_ACTIVATE:
+        g_FrameGovernor.SetFocused(LOWORD(wParam) != WA_INACTIVE);
+        break;
     case WM_SYSCOMMAND:
         if ((wParam & 0xfff0) == SC_KEYMENU) // Disable ALT application menu
             return 0;
@@ -0,0 +1,59 @@
+#include "69/core/FrameClock.h"
+
+#include <algorithm>
+
+namespace core
+{
+
+void FrameTimeHistory::Push(float seconds)
+{
+    unsigned int index = m_Written.load(std::memory_order_relaxed);
+    m_Samples[index % CAPACITY].store(seconds, std::memory_order_relaxed);
+    m_Written.store(index + 1, std::memory_order_release);
+}
+
+FrameTimeHistory::Stats FrameTimeHistory::GetStats() const
+{
+    Stats stats;
+    unsigned int written = m_Written.load(std::memory_order_acquire);
+    int count = (int)std::min<unsigned int>(written, CAPACITY);
+    if (count == 0)
+        return stats;
+
+    float samples[CAPACITY];
+    for (int i = 0; i < count; i++)
+        samples[i] = m_Samples[(written - 1 - i) % CAPACITY].load(std::memory_order_relaxed);
+
+    // Nearest-rank percentiles
+    int p50 = (count - 1) / 2;
+    int p99 = (count * 99 + 99) / 100 - 1;
+    std::nth_element(samples, samples + p50, samples + count);
+    stats.P50 = samples[p50];
+    std::nth_element(samples, samples + p99, samples + count);
+    stats.P99 = samples[p99];
+    stats.Max = *std::max_element(samples, samples + count);
+    stats.Count = count;
+    return stats;
+}
+
+FrameClock::FrameClock() : m_Start(std::chrono::steady_clock::now())
+{
+}
+
+double FrameClock::Now() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+}
+
+float FrameClock::Tick()
+{
+    double now = Now();
+    float elapsed = (float)(now - m_LastTick);
+    m_LastTick = now;
+
+    m_History.Push(elapsed);
+    m_Delta = std::min(elapsed, MAX_DELTA);
+    return m_Delta;
+}
+
+} // namespace core
@@ -0,0 +1,86 @@
+#include "69/core/FrameGovernor.h"
+
+namespace core
+{
+
+// Keep full rate a little after input so hover/click tweens can start
+static const double INPUT_GRACE = 0.5;
+
+// Frame intervals for ambient-only motion
+static const double REDUCED_INTERVAL = 1.0 / 30.0;
+static const double BACKGROUND_INTERVAL = 1.0 / 10.0;
+
+// Occlusion ends without a message, so poll for it
+static const double OCCLUDED_POLL_INTERVAL = 0.25;
+
+void FrameGovernor::SetAnimating(bool animating)
+{
+    m_Animating = animating;
+}
+
+void FrameGovernor::SetAmbientAnimating(bool ambient)
+{
+    m_AmbientAnimating = ambient;
+}
+
+void FrameGovernor::SetFocused(bool focused)
+{
+    m_Focused = focused;
+}
+
+void FrameGovernor::SetMinimized(bool minimized)
+{
+    m_Minimized = minimized;
+}
+
+void FrameGovernor::SetOccluded(bool occluded)
+{
+    m_Occluded = occluded;
+}
+
+void FrameGovernor::NotifyInput(double now)
+{
+    m_LastInput = now;
+}
+
+void FrameGovernor::FrameRendered(double frameStart)
+{
+    m_LastFrame = frameStart;
+}
+
+FrameGovernor::Mode FrameGovernor::GetMode(double now) const
+{
+    if (m_Minimized || m_Occluded)
+        return Mode::WAIT_FOR_INPUT;
+
+    if (m_Animating || now - m_LastInput < INPUT_GRACE)
+        return Mode::FULL_RATE;
+
+    if (m_AmbientAnimating)
+        return Mode::REDUCED_RATE;
+
+    return Mode::WAIT_FOR_INPUT;
+}
+
+double FrameGovernor::GetWaitTimeout(double now) const
+{
+    double interval = 0.0;
+    switch (GetMode(now))
+    {
+    case Mode::FULL_RATE:
+        return 0.0;
+    case Mode::REDUCED_RATE:
+        interval = m_Focused ? REDUCED_INTERVAL : BACKGROUND_INTERVAL;
+        break;
+    case Mode::WAIT_FOR_INPUT:
+        if (!m_Occluded || m_Minimized)
+            return -1.0;
+        interval = OCCLUDED_POLL_INTERVAL;
+        break;
+    }
+
+    double remaining = m_LastFrame + interval - now;
+    return remaining > 0.0 ? remaining : 0.0;
+}
+
+} // namespace core
@@ -0,0 +1,135 @@
+#include "69/menu/BlobSprite.h"
+
+#include "69/menu/Raster.h"
+#include "69/menu/Theme.h"
+#include "imgui/imgui_internal.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace menu
+{
+
+// Layer setup of the original immediate-mode blob (shadow + colored core)
+static const int SHADOW_LAYERS = 20;
+static const float SHADOW_ALPHA = 0.3f;
+static const int CORE_LAYERS = 24;
+static const float CORE_ALPHA = 0.1f;
+
+// Shadow layers are offset downwards like DrawBlurShadow does
+static const float SHADOW_OFFSET_TOP = 4.0f;
+static const float SHADOW_OFFSET_BOTTOM = 8.0f;
+
+int BlobSprite::AddBlob(float size, float colorAlpha)
+{
+    Cell cell = {};
+    cell.Size = size;
+    cell.ColorAlpha = colorAlpha;
+    cell.Extent = size + SHADOW_OFFSET_BOTTOM + 2.0f;
+    m_Cells.push_back(cell);
+    return (int)m_Cells.size() - 1;
+}
+
+void BlobSprite::Bake(float scale)
+{
+    // Layout cells side by side with a transparent pixel in between
+    std::vector<int> cellX(m_Cells.size());
+    std::vector<int> cellSide(m_Cells.size());
+    m_Width = 0;
+    m_Height = 0;
+    for (size_t i = 0; i < m_Cells.size(); i++)
+    {
+        cellSide[i] = (int)std::ceil(m_Cells[i].Extent * 2.0f * scale);
+        cellX[i] = m_Width;
+        m_Width += cellSide[i] + 1;
+        m_Height = std::max(m_Height, cellSide[i]);
+    }
+
+    m_Pixels.assign((size_t)m_Width * m_Height * 4, 0);
+
+    for (size_t i = 0; i < m_Cells.size(); i++)
+    {
+        Cell& cell = m_Cells[i];
+        int side = cellSide[i];
+        float pixelSize = (cell.Extent * 2.0f) / (float)side;
+
+        // Per-layer alphas, quantized the same way the draw list did it
+        float shadowAlpha[SHADOW_LAYERS];
+        for (int l = 0; l < SHADOW_LAYERS; l++)
+        {
+            float op = 1.0f - (float)l / (float)SHADOW_LAYERS;
+            op *= op;
+            shadowAlpha[l] = (float)(int)(theme::BLUR_STRENGTH * op * SHADOW_ALPHA) / 255.0f;
+        }
+        float coreAlpha[CORE_LAYERS];
+        for (int l = 0; l < CORE_LAYERS; l++)
+        {
+            float f = (float)l / (float)CORE_LAYERS;
+            coreAlpha[l] =
+                (float)IM_F32_TO_INT8_SAT(cell.ColorAlpha * (1.0f - f) * CORE_ALPHA) / 255.0f;
+        }
+
+        for (int py = 0; py < side; py++)
+        {
+            unsigned char* row = &m_Pixels[((size_t)py * m_Width + cellX[i]) * 4];
+            float y = ((float)py + 0.5f) * pixelSize - cell.Extent;
+            for (int px = 0; px < side; px++)
+            {
+                float x = ((float)px + 0.5f) * pixelSize - cell.Extent;
+
+                // Black shadow: rounded rects growing from a zero width rect below the center
+                float shadowKeep = 1.0f;
+                for (int l = 1; l < SHADOW_LAYERS; l++)
+                {
+                    float e = cell.Size * (float)l / (float)SHADOW_LAYERS;
+                    float hy = e + (SHADOW_OFFSET_BOTTOM - SHADOW_OFFSET_TOP) * 0.5f;
+                    float cy = (SHADOW_OFFSET_TOP + SHADOW_OFFSET_BOTTOM) * 0.5f;
+                    float r = raster::ClampRounding(cell.Size + e, e * 2.0f, hy * 2.0f);
+                    float d = raster::RoundedRectDistance(x, y, 0.0f, cy, e, hy, r);
+                    shadowKeep *= 1.0f - shadowAlpha[l] * raster::Coverage(d);
+                }
+
+                // Colored core: shrinking concentric circles
+                float coreKeep = 1.0f;
+                float dist = std::sqrt(x * x + y * y);
+                for (int l = 0; l < CORE_LAYERS; l++)
+                {
+                    float radius = cell.Size * (1.0f - (float)l / (float)CORE_LAYERS * 0.5f);
+                    coreKeep *= 1.0f - coreAlpha[l] * raster::Coverage(dist - radius);
+                }
+
+                float core = 1.0f - coreKeep;
+                float total = 1.0f - shadowKeep * coreKeep;
+                float share = total > 0.0f ? core / total : 0.0f;
+
+                unsigned char* p = row + px * 4;
+                p[0] = p[1] = p[2] = (unsigned char)IM_F32_TO_INT8_SAT(share);
+                p[3] = (unsigned char)IM_F32_TO_INT8_SAT(total);
+            }
+        }
+
+        cell.UvMin = ImVec2((float)cellX[i] / (float)m_Width, 0.0f);
+        cell.UvMax =
+            ImVec2((float)(cellX[i] + side) / (float)m_Width, (float)side / (float)m_Height);
+    }
+}
+
+void BlobSprite::Draw(ImDrawList* drawList, ImTextureRef texture, int index, ImVec2 center,
+                      ImU32 tint) const
+{
+    if (index < 0 || index >= (int)m_Cells.size())
+        return;
+
+    const Cell& cell = m_Cells[index];
+    drawList->AddImage(texture, ImVec2(center.x - cell.Extent, center.y - cell.Extent),
+                       ImVec2(center.x + cell.Extent, center.y + cell.Extent), cell.UvMin,
+                       cell.UvMax, tint);
+}
+
+void BlobSprite::ReleasePixels()
+{
+    m_Pixels.clear();
+    m_Pixels.shrink_to_fit();
+}
+
+} // namespace menu
@@ -0,0 +1,63 @@
+#include "69/menu/D3D11Texture.h"
+
+#include "dx11/D3D11.h"
+
+namespace menu
+{
+
+// D3D11_REQ_MIP_LEVELS
+static const int MAX_MIP_LEVELS = 15;
+
+ImTextureID D3D11TextureFactory::CreateTexture(const unsigned char* pixels, int width,
+                                               int height, int mipCount)
+{
+    if (!m_Device || !pixels || width <= 0 || height <= 0 || mipCount < 1 ||
+        mipCount > MAX_MIP_LEVELS)
+        return ImTextureID_Invalid;
+
+    // Create texture
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = width;
+    desc.Height = height;
+    desc.MipLevels = mipCount;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    // Uploaded straight from the caller's memory, one subresource per mip
+    D3D11_SUBRESOURCE_DATA subResources[MAX_MIP_LEVELS] = {};
+    const unsigned char* level = pixels;
+    for (int i = 0; i < mipCount; i++)
+    {
+        int levelWidth = GetMipSize(width, i);
+        subResources[i].pSysMem = level;
+        subResources[i].SysMemPitch = levelWidth * 4;
+        level += (size_t)levelWidth * GetMipSize(height, i) * 4;
+    }
+
+    ID3D11Texture2D* pTexture = nullptr;
+    if (m_Device->CreateTexture2D(&desc, subResources, &pTexture) != S_OK || !pTexture)
+        return ImTextureID_Invalid;
+
+    // Create shader resource view
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = mipCount;
+
+    ID3D11ShaderResourceView* srv = nullptr;
+    m_Device->CreateShaderResourceView(pTexture, &srvDesc, &srv);
+    pTexture->Release();
+
+    return srv ? (ImTextureID)(size_t)srv : ImTextureID_Invalid;
+}
+
+void D3D11TextureFactory::DestroyTexture(ImTextureID texture)
+{
+    if (texture != ImTextureID_Invalid)
+        ((ID3D11ShaderResourceView*)(size_t)texture)->Release();
+}
+
+} // namespace menu
@@ -0,0 +1,139 @@
+#include "69/menu/DrawStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace menu
+{
+
+DrawStats CollectDrawStats(const ImDrawData* drawData)
+{
+    DrawStats stats;
+    if (!drawData || !drawData->Valid)
+        return stats;
+
+    stats.DrawLists = drawData->CmdListsCount;
+    stats.Vertices = drawData->TotalVtxCount;
+    stats.Indices = drawData->TotalIdxCount;
+
+    for (const ImDrawList* drawList : drawData->CmdLists)
+    {
+        const ImDrawCmd* prev = nullptr;
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+        {
+            if (cmd.ElemCount == 0 && !cmd.UserCallback)
+                continue;
+
+            stats.Commands++;
+            if (!prev || prev->ClipRect.x != cmd.ClipRect.x || prev->ClipRect.y != cmd.ClipRect.y ||
+                prev->ClipRect.z != cmd.ClipRect.z || prev->ClipRect.w != cmd.ClipRect.w)
+                stats.ClipRectChanges++;
+            if (!prev || prev->TexRef._TexData != cmd.TexRef._TexData ||
+                prev->TexRef._TexID != cmd.TexRef._TexID)
+                stats.TextureChanges++;
+            prev = &cmd;
+        }
+    }
+
+    return stats;
+}
+
+const char* GetStateName(AppState state)
+{
+    switch (state)
+    {
+    case AppState::LOGIN:
+        return "LOGIN";
+    case AppState::TRANSITION_TO_LOADING:
+        return "TRANSITION_TO_LOADING";
+    case AppState::LOADING:
+        return "LOADING";
+    case AppState::TRANSITION_FROM_LOADING:
+        return "TRANSITION_FROM_LOADING";
+    case AppState::RESULT:
+        return "RESULT";
+    case AppState::TRANSITION_TO_LOGIN:
+        return "TRANSITION_TO_LOGIN";
+    case AppState::TRANSITION_TO_MAINMENU:
+        return "TRANSITION_TO_MAINMENU";
+    case AppState::MAIN_MENU:
+        return "MAIN_MENU";
+    case AppState::TRANSITION_TO_LAUNCHING:
+        return "TRANSITION_TO_LAUNCHING";
+    case AppState::LAUNCHING:
+        return "LAUNCHING";
+    }
+    return "UNKNOWN";
+}
+
+void DrawStatsRecorder::Record(AppState state, const DrawStats& frame)
+{
+    int index = (int)state;
+    if (index < 0 || index >= STATE_COUNT)
+        return;
+
+    Aggregate& agg = m_States[index];
+    agg.Frames++;
+    agg.Sum.DrawLists += frame.DrawLists;
+    agg.Sum.Commands += frame.Commands;
+    agg.Sum.Vertices += frame.Vertices;
+    agg.Sum.Indices += frame.Indices;
+    agg.Sum.ClipRectChanges += frame.ClipRectChanges;
+    agg.Sum.TextureChanges += frame.TextureChanges;
+    agg.Sum.CpuMs += frame.CpuMs;
+
+    agg.Max.DrawLists = std::max(agg.Max.DrawLists, frame.DrawLists);
+    agg.Max.Commands = std::max(agg.Max.Commands, frame.Commands);
+    agg.Max.Vertices = std::max(agg.Max.Vertices, frame.Vertices);
+    agg.Max.Indices = std::max(agg.Max.Indices, frame.Indices);
+    agg.Max.ClipRectChanges = std::max(agg.Max.ClipRectChanges, frame.ClipRectChanges);
+    agg.Max.TextureChanges = std::max(agg.Max.TextureChanges, frame.TextureChanges);
+    agg.Max.CpuMs = std::max(agg.Max.CpuMs, frame.CpuMs);
+}
+
+// DrawStats or Totals
+template <class Stats>
+static std::string FormatStats(const char* name, const Stats& stats, double div)
+{
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "    \"%s\": {\"draw_lists\": %.1f, \"commands\": %.1f, \"vertices\": %.1f, "
+             "\"indices\": %.1f, \"clip_rect_changes\": %.1f, \"texture_changes\": %.1f, "
+             "\"cpu_ms\": %.4f}",
+             name, (double)stats.DrawLists / div, (double)stats.Commands / div,
+             (double)stats.Vertices / div, (double)stats.Indices / div,
+             (double)stats.ClipRectChanges / div, (double)stats.TextureChanges / div,
+             stats.CpuMs / div);
+    return buffer;
+}
+
+bool DrawStatsRecorder::WriteJson(const char* path) const
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "{\n";
+    bool first = true;
+    for (int i = 0; i < STATE_COUNT; i++)
+    {
+        const Aggregate& agg = m_States[i];
+        if (agg.Frames == 0)
+            continue;
+
+        if (!first)
+            file << ",\n";
+        file << "  \"" << GetStateName((AppState)i) << "\": {\n";
+        file << "    \"frames\": " << agg.Frames << ",\n";
+        file << FormatStats("avg", agg.Sum, (double)agg.Frames) << ",\n";
+        file << FormatStats("max", agg.Max, 1.0) << "\n  }";
+        first = false;
+    }
+    file << "\n}\n";
+
+    return (bool)file;
+}
+
+} // namespace menu
@@ -0,0 +1,64 @@
+#include "69/menu/ImageAtlas.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <cstring>
+
+namespace menu
+{
+
+int ImageAtlas::Add(const unsigned char* pixels, int width, int height)
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (!pixels || width <= 0 || height <= 0 || (m_Atlas && m_Atlas != atlas))
+        return -1;
+
+    // The border repeats the edge pixels: bilinear filtering at the image edge then reads the
+    // image itself, not the glyph or padding next to it
+    int paddedWidth = width + 2;
+    int paddedHeight = height + 2;
+    ImFontAtlasRect rect;
+    atlas->TexPixelsUseColors = true;
+    ImFontAtlasRectId id = atlas->AddCustomRect(paddedWidth, paddedHeight, &rect);
+    if (id == ImFontAtlasRectId_Invalid)
+        return -1;
+
+    std::vector<unsigned char> padded((size_t)paddedWidth * paddedHeight * 4);
+    for (int y = 0; y < paddedHeight; y++)
+    {
+        int sourceY = ImClamp(y - 1, 0, height - 1);
+        const unsigned char* source = pixels + (size_t)sourceY * width * 4;
+        unsigned char* dest = &padded[(size_t)y * paddedWidth * 4];
+        memcpy(dest, source, 4);
+        memcpy(dest + 4, source, (size_t)width * 4);
+        memcpy(dest + (size_t)(width + 1) * 4, source + (size_t)(width - 1) * 4, 4);
+    }
+
+    // Written straight into the atlas in its format, uploaded with the next glyphs
+    ImTextureData* texture = atlas->TexData;
+    ImFontAtlasTextureBlockConvert(padded.data(), ImTextureFormat_RGBA32, paddedWidth * 4,
+                                   (unsigned char*)texture->GetPixelsAt(rect.x, rect.y),
+                                   texture->Format, texture->GetPitch(), paddedWidth,
+                                   paddedHeight);
+    ImFontAtlasTextureBlockQueueUpload(atlas, texture, rect.x, rect.y, paddedWidth, paddedHeight);
+
+    m_Atlas = atlas;
+    m_Rects.push_back(id);
+    return (int)m_Rects.size() - 1;
+}
+
+bool ImageAtlas::Get(int index, ImTextureRef& texture, ImVec2& uv0, ImVec2& uv1) const
+{
+    ImFontAtlasRect rect;
+    if (index < 0 || index >= (int)m_Rects.size() || !m_Atlas->GetCustomRect(m_Rects[index], &rect))
+        return false;
+
+    // Inside the border
+    texture = m_Atlas->TexRef;
+    uv0 = ImVec2((rect.x + 1) * m_Atlas->TexUvScale.x, (rect.y + 1) * m_Atlas->TexUvScale.y);
+    uv1 = ImVec2((rect.x + rect.w - 1) * m_Atlas->TexUvScale.x,
+                 (rect.y + rect.h - 1) * m_Atlas->TexUvScale.y);
+    return true;
+}
+
+} // namespace menu
@@ -1,154 +1,250 @@
 ﻿#include "69/menu/Menu.h"
 
+#include "69/menu/SdfAtlas.h"
+#include "69/menu/ShadowAtlas.h"
 #include "69/menu/Theme.h"
 #include "69/resource/Logo.h"
 #include "69/resource/Software.h"
 #include "69/resource/fonts/IconsFontAwesome.h"
-#include "69/service/KeyauthService.h"
-#include "dx11/D3D11.h"
 #include "imgui/imgui_internal.h"
 #include "obfuscate/obfuscate.h"
-#include "stb/stb_image.h"
 
+#include <cfloat>
 #include <chrono>
+#include <cstdio>
 #include <thread>
-#include <windows.h>
 
 namespace menu
 {
 
 static bool g_Closing = false;
 
-Menu::Menu()
-{
-    // Initialize Services
-    m_service = std::make_shared<service::KeyauthService>();
-
-    // Cache Software List
-    m_SoftwareList = m_service->GetAvailableSoftware();
+// Service calls resolve as timed out after this, whatever the network does
+static const std::chrono::seconds LICENSE_CHECK_TIMEOUT(15);
+static const std::chrono::seconds LAUNCH_TIMEOUT(10);
+static ShadowAtlas g_ShadowAtlas;
+static SdfAtlas g_SdfAtlas;
 
+Menu::Menu(std::shared_ptr<service::IService> service, IPlatform& platform,
+           ITextureFactory& textures)
+    : m_Platform(platform), m_Textures(textures), m_service(std::move(service))
+{
     // Initialize Animated Background Blobs
     m_Blobs.push_back({ImVec2(50, 50), ImVec2(15, 20), theme::BLOB_1, 160.0f});
     m_Blobs.push_back({ImVec2(300, 400), ImVec2(-20, -15), theme::BLOB_2, 190.0f});
     m_Blobs.push_back({ImVec2(200, 200), ImVec2(-10, 25), theme::BLOB_3, 140.0f});
+
+    // Bake the soft blob falloff once, uploaded in LoadTexture
+    for (auto& blob : m_Blobs)
+        blob.SpriteIndex = m_BlobSprite.AddBlob(blob.Size, blob.Color.w);
+    m_BlobSprite.Bake();
+
+    // Open on the last accepted login, the server confirms it in the background
+    std::string licenseKey;
+    if (m_service->GetCachedLogin(licenseKey, m_Login))
+    {
+        m_State = m_NextState = AppState::MAIN_MENU;
+        m_Scheduler.Spawn(RevalidateFlow(licenseKey));
+    }
+}
+
+Menu::~Menu()
+{
+    CancelPendingOperations();
+
+    // The atlases are shared, they give their textures back with the factory
+    g_ShadowAtlas.SetTextureFactory(nullptr);
+    g_SdfAtlas.SetTextureFactory(nullptr);
+
+    // The images in the font atlas go with the ImGui context
+    if (m_BlobTexture != ImTextureID_Invalid)
+        m_Textures.DestroyTexture(m_BlobTexture);
 }
 
 void Menu::TriggerShake()
 {
-    m_ErrorShakeT = 1.0f;
+    m_Tweens.Set(m_ErrorShakeT, 1.0f);
+    m_Tweens.MoveTo(m_ErrorShakeT, 0.0f, 2.0f);
 }
 
-void Menu::LoadTexture(ID3D11Device* device)
+bool Menu::IsAnimating() const
 {
-    if (!device)
-        return;
+    // Window fade in / out, content fades, shake, focus / hover tweens still settling
+    if (g_Closing || m_Tweens.IsAnimating())
+        return true;
+
+    // Transitions, spinner, result and launch animations, service flows in progress
+    if (m_State != AppState::LOGIN && m_State != AppState::MAIN_MENU)
+        return true;
+    if (m_Scheduler.HasPending())
+        return true;
+
+    // Text cursor blink
+    return ImGui::IsAnyItemActive();
+}
 
-    if (m_LogoTexture == nullptr)
-    {
-        int channels;
-        unsigned char* image_data =
-            stbi_load_from_memory(resource::s_Logo, sizeof(resource::s_Logo),
-                                  &resource::s_LogoWidth, &resource::s_LogoHeight, &channels,
-                                  4 // Force RGBA
-            );
+bool Menu::HasAmbientAnimation() const
+{
+    return !m_Blobs.empty() && theme::GetEffects().BackgroundBlobs;
+}
 
-        if (image_data)
-        {
-            // Create texture
-            D3D11_TEXTURE2D_DESC desc = {};
-            desc.Width = resource::s_LogoWidth;
-            desc.Height = resource::s_LogoHeight;
-            desc.MipLevels = 1;
-            desc.ArraySize = 1;
-            desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            desc.SampleDesc.Count = 1;
-            desc.Usage = D3D11_USAGE_DEFAULT;
-            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-            D3D11_SUBRESOURCE_DATA subResource = {};
-            subResource.pSysMem = image_data;
-            subResource.SysMemPitch = resource::s_LogoWidth * 4;
-
-            ID3D11Texture2D* pTexture = nullptr;
-            device->CreateTexture2D(&desc, &subResource, &pTexture);
-
-            // Create shader resource view
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-            srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-            srvDesc.Texture2D.MipLevels = 1;
-
-            device->CreateShaderResourceView(pTexture, &srvDesc, &m_LogoTexture);
-            pTexture->Release();
-
-            stbi_image_free(image_data);
-        }
-    }
+// Screens don't change in fade-outs and while shaking, as long as nobody interacts with them
+bool Menu::CanReplayContent() const
+{
+    if (m_State == AppState::TRANSITION_TO_LOADING || m_State == AppState::TRANSITION_TO_LOGIN ||
+        m_State == AppState::TRANSITION_TO_MAINMENU ||
+        m_State == AppState::TRANSITION_TO_LAUNCHING)
+        return true;
 
-    if (m_SoftwareTexture == nullptr)
+    if (m_Tweens.Get(m_ErrorShakeT) > 0.0f)
     {
-        int channels;
-        unsigned char* image_data =
-            stbi_load_from_memory(resource::s_Software, sizeof(resource::s_Software),
-                                  &resource::s_SoftwareWidth, &resource::s_SoftwareHeight, &channels,
-                                  4 // Force RGBA
-            );
+        ImGuiIO& io = ImGui::GetIO();
+        return !ImGui::IsAnyItemActive() && !ImGui::IsAnyMouseDown() &&
+               io.InputQueueCharacters.Size == 0;
+    }
 
-        if (image_data)
-        {
-            // Create texture
-            D3D11_TEXTURE2D_DESC desc = {};
-            desc.Width = resource::s_SoftwareWidth;
-            desc.Height = resource::s_SoftwareHeight;
-            desc.MipLevels = 1;
-            desc.ArraySize = 1;
-            desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            desc.SampleDesc.Count = 1;
-            desc.Usage = D3D11_USAGE_DEFAULT;
-            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-            D3D11_SUBRESOURCE_DATA subResource = {};
-            subResource.pSysMem = image_data;
-            subResource.SysMemPitch = resource::s_SoftwareWidth * 4;
-
-            ID3D11Texture2D* pTexture = nullptr;
-            device->CreateTexture2D(&desc, &subResource, &pTexture);
-
-            // Create shader resource view
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-            srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-            srvDesc.Texture2D.MipLevels = 1;
-
-            device->CreateShaderResourceView(pTexture, &srvDesc, &m_SoftwareTexture);
-            pTexture->Release();
-
-            stbi_image_free(image_data);
-        }
+    return false;
+}
+
+void Menu::LoadTexture()
+{
+    g_ShadowAtlas.SetTextureFactory(&m_Textures);
+    g_SdfAtlas.SetTextureFactory(&m_Textures);
+
+    // Neon rects for every quality tier and the result rings
+    for (int layers = 1; layers <= 3; layers++)
+        g_SdfAtlas.WarmNeonRect(1.0f, 8.0f, layers);
+    g_SdfAtlas.WarmRing(40.0f, 4.0f);
+
+    // Decoded by scripts/change_*.py, copied next to the font glyphs. The atlas has no mips, so
+    // each header holds the level it is drawn at: the logo 1:1, the icon its 128 px level for
+    // the 120 to 140 px it is drawn at.
+    if (m_LogoImage < 0)
+        m_LogoImage =
+            m_Images.Add(resource::s_Logo, resource::s_LogoWidth, resource::s_LogoHeight);
+
+    // Product icons by SoftwareItem::IconIndex
+    if (m_IconImages.empty())
+        m_IconImages.push_back(m_Images.Add(resource::s_Software, resource::s_SoftwareWidth,
+                                            resource::s_SoftwareHeight));
+
+    if (m_BlobTexture == ImTextureID_Invalid && m_BlobSprite.GetPixels())
+    {
+        m_BlobTexture = m_Textures.CreateTexture(m_BlobSprite.GetPixels(), m_BlobSprite.GetWidth(),
+                                                 m_BlobSprite.GetHeight());
+        m_BlobSprite.ReleasePixels();
     }
 }
 
+// Unknown icon indices show the first icon
+bool Menu::GetIcon(int iconIndex, ImTextureRef& texture, ImVec2& uv0, ImVec2& uv1) const
+{
+    if (m_IconImages.empty())
+        return false;
+    if (iconIndex < 0 || iconIndex >= (int)m_IconImages.size())
+        iconIndex = 0;
+    return m_Images.Get(m_IconImages[iconIndex], texture, uv0, uv1);
+}
+
 void Menu::StartLicenseCheck()
 {
-    m_LicenseCheckFuture =
-        std::async(std::launch::async, [this]() { return m_service->ValidateUser(m_LicenseKey); });
+    m_LicenseClickTime = std::chrono::steady_clock::now();
+    m_LicenseResult.reset();
+    m_Scheduler.Spawn(LoginFlow(m_LicenseKey));
 }
 
 void Menu::StartLaunchSoftware(int id)
 {
     m_LaunchStart = true; // Prevent multiple launch
-    m_LaunchResultFuture =
-        std::async(std::launch::async, [this, id]() { return m_service->LaunchSoftware(id); });
+    m_Scheduler.Spawn(LaunchFlow(id));
+}
+
+// License, catalog and variables in one call, so the main menu is ready with the result.
+// The LOADING state picks it up. An offline answer is confirmed with the server right after.
+service::Task<void> Menu::LoginFlow(std::string licenseKey)
+{
+    service::LoginBundle login =
+        co_await service::LoginAsync(m_service, licenseKey, LICENSE_CHECK_TIMEOUT);
+    m_LicenseResultTime = std::chrono::steady_clock::now();
+
+    m_LicenseResult = login.Result;
+    if (login.Result != service::OperationResult::SUCCESS)
+        co_return;
+
+    bool offline = login.Offline;
+    m_Login = std::move(login);
+    if (offline)
+        m_Scheduler.Spawn(RevalidateFlow(std::move(licenseKey)));
+}
+
+// Confirms a cached or offline login, launching waits for it.
+// Only a refused license logs out, an unreachable server keeps the login.
+service::Task<void> Menu::RevalidateFlow(std::string licenseKey)
+{
+    m_Revalidating = true;
+    service::LoginBundle login =
+        co_await service::RevalidateAsync(m_service, licenseKey, LICENSE_CHECK_TIMEOUT);
+    m_Revalidating = false;
+
+    if (login.Result == service::OperationResult::SUCCESS && m_State != AppState::LOGIN)
+    {
+        m_Login = std::move(login);
+    }
+    else if (login.Result == service::OperationResult::DENIED)
+    {
+        // Through the failed result screen back to login, also from the loading screen
+        m_Login = service::LoginBundle();
+        m_LicenseResult.reset();
+        m_LaunchStart = false;
+        m_WasSuccess = false;
+        m_SelectedIndex = -1;
+        m_State = AppState::RESULT;
+        m_StateTime = 0.0f;
+        m_Tweens.Set(m_ContentAlpha, 0.0f);
+        m_Tweens.Set(m_ResultAnimT, 0.0f);
+    }
+}
+
+service::Task<void> Menu::LaunchFlow(int id)
+{
+    // Nothing is launched on a license the server is about to refuse
+    co_await service::Until([this]() { return !m_Revalidating; });
+    if (m_State != AppState::LAUNCHING)
+        co_return;
+
+    service::OperationResult result =
+        co_await service::LaunchSoftwareAsync(m_service, id, LAUNCH_TIMEOUT);
+
+    // Quit once the progress bar has been seen
+    co_await service::Until([this]() { return m_Tweens.Get(m_LaunchAnimT) > 2.1f; });
+    if (result == service::OperationResult::SUCCESS)
+        g_Closing = true;
+}
+
+// Stop waiting for the service, nothing blocks on the workers afterwards
+void Menu::CancelPendingOperations()
+{
+    m_Scheduler.CancelAll();
 }
 
 // Helper for Neon Glow
 void DrawNeonRect(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, ImU32 color, float thickness,
                   float intensity, float rounding = 8.0f)
 {
-    drawList->AddRect(pMin, pMax, (color & 0x00FFFFFF) | ((int)(40 * intensity) << 24), rounding, 0,
-                      thickness + 6.0f);
-    drawList->AddRect(pMin, pMax, (color & 0x00FFFFFF) | ((int)(80 * intensity) << 24), rounding, 0,
-                      thickness + 2.0f);
+    // Outer glow rects are dropped first on lower quality
+    int layers = theme::GetEffects().NeonLayers;
+
+    // One baked nine-slice, layered rects only as a fallback
+    if (g_SdfAtlas.DrawNeonRect(drawList, pMin, pMax, color, thickness, intensity, rounding,
+                                layers))
+        return;
+
+    if (layers >= 3)
+        drawList->AddRect(pMin, pMax, (color & 0x00FFFFFF) | ((int)(40 * intensity) << 24),
+                          rounding, 0, thickness + 6.0f);
+    if (layers >= 2)
+        drawList->AddRect(pMin, pMax, (color & 0x00FFFFFF) | ((int)(80 * intensity) << 24),
+                          rounding, 0, thickness + 2.0f);
     drawList->AddRect(pMin, pMax, (color & 0x00FFFFFF) | ((int)(200 * intensity) << 24), rounding,
                       0, thickness);
 }
@@ -157,6 +253,10 @@ void DrawNeonRect(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, ImU32 color, f
 void DrawBlurShadow(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, float shadowSize, int layers,
                     float rounding, float alpha)
 {
+    // Nine-slice from the cached texture, layered rects only as a fallback
+    if (g_ShadowAtlas.Draw(drawList, pMin, pMax, shadowSize, layers, rounding, alpha))
+        return;
+
     for (int i = 0; i < layers; i++)
     {
         float factor = (float)i / (float)layers;
@@ -176,19 +276,19 @@ void Menu::DrawGlassPanel(ImVec2 pos, ImVec2 size, float alpha)
     ImDrawList* drawList = ImGui::GetWindowDrawList();
 
     // Blurry Shadow
-    DrawBlurShadow(drawList, pos, ImVec2(pos.x + size.x, pos.y + size.y), 15.0f, 15, 12.0f, alpha);
+    DrawBlurShadow(drawList, pos, ImVec2(pos.x + size.x, pos.y + size.y), 15.0f,
+                   theme::GetEffects().GlassShadowLayers, 12.0f, alpha);
 
     // Glass Background
     drawList->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y),
-                            theme::GetColorU32(theme::FadeColor(theme::GLASS_BG, alpha)), 12.0f);
+                            theme::GLASS_BG_U32.Get(alpha), 12.0f);
 
     // Glass Border
     drawList->AddRect(pos, ImVec2(pos.x + size.x, pos.y + size.y),
-                      theme::GetColorU32(theme::FadeColor(theme::GLASS_BORDER, alpha)), 12.0f, 0,
-                      1.5f);
+                      theme::GLASS_BORDER_U32.Get(alpha), 12.0f, 0, 1.5f);
 }
 
-void Menu::DrawInput(const char* label, char* buffer, size_t size, bool isPassword, float& focusT,
+void Menu::DrawInput(const char* label, char* buffer, size_t size, bool isPassword, Tween focus,
                      bool& showPasswordToggle, float alpha)
 {
     ImGui::PushID(label);
@@ -199,7 +299,7 @@ void Menu::DrawInput(const char* label, char* buffer, size_t size, bool isPasswo
     ImDrawList* drawList = ImGui::GetWindowDrawList();
 
     // Background
-    ImU32 bgColor = theme::GetColorU32(theme::FadeColor(theme::INPUT_BG, alpha));
+    ImU32 bgColor = theme::INPUT_BG_U32.Get(alpha);
     drawList->AddRectFilled(pos, ImVec2(pos.x + sizeVec.x, pos.y + sizeVec.y), bgColor, 8.0f);
 
     // Input Logic (Invisible but active)
@@ -248,8 +348,8 @@ void Menu::DrawInput(const char* label, char* buffer, size_t size, bool isPasswo
     }
 
     // Focus Animation Update
-    float targetFocus = isFocused ? 1.0f : 0.0f;
-    focusT = ImLerp(focusT, targetFocus, ImGui::GetIO().DeltaTime * 10.0f);
+    m_Tweens.SmoothTo(focus, isFocused ? 1.0f : 0.0f, 10.0f);
+    float focusT = m_Tweens.Get(focus);
 
     // Decoration
     ImVec4 borderCol = ImLerp(theme::INPUT_BORDER, theme::ACCENT_COLOR, focusT);
@@ -258,7 +358,7 @@ void Menu::DrawInput(const char* label, char* buffer, size_t size, bool isPasswo
     if (focusT > 0.01f)
     {
         DrawNeonRect(drawList, pos, ImVec2(pos.x + sizeVec.x, pos.y + sizeVec.y),
-                     theme::GetColorU32(theme::ACCENT_COLOR), 1.0f, alpha * focusT);
+                     theme::ACCENT_COLOR_U32.Get(), 1.0f, alpha * focusT);
     }
     else
     {
@@ -270,7 +370,7 @@ void Menu::DrawInput(const char* label, char* buffer, size_t size, bool isPasswo
 }
 
 // Returns true if clicked
-bool Menu::DrawButton(const char* label, ImVec2 size, float& hoverT, float& clickT, float alpha)
+bool Menu::DrawButton(const char* label, ImVec2 size, Tween hover, Tween click, float alpha)
 {
     ImVec2 pos = ImGui::GetCursorScreenPos();
     ImDrawList* drawList = ImGui::GetWindowDrawList();
@@ -280,11 +380,10 @@ bool Menu::DrawButton(const char* label, ImVec2 size, float& hoverT, float& clic
     bool clicked = hovered && ImGui::IsMouseDown(0);
     bool result = false;
 
-    float targetHover = hovered ? 1.0f : 0.0f;
-    hoverT = ImLerp(hoverT, targetHover, ImGui::GetIO().DeltaTime * 10.0f);
-
-    float targetClick = clicked ? 1.0f : 0.0f;
-    clickT = ImLerp(clickT, targetClick, ImGui::GetIO().DeltaTime * 20.0f);
+    m_Tweens.SmoothTo(hover, hovered ? 1.0f : 0.0f, 10.0f);
+    m_Tweens.SmoothTo(click, clicked ? 1.0f : 0.0f, 20.0f);
+    float hoverT = m_Tweens.Get(hover);
+    float clickT = m_Tweens.Get(click);
 
     float scale = 1.0f + (hoverT * 0.02f) - (clickT * 0.02f);
     ImVec2 center = ImVec2(pos.x + size.x * 0.5f, pos.y + size.y * 0.5f);
@@ -294,17 +393,16 @@ bool Menu::DrawButton(const char* label, ImVec2 size, float& hoverT, float& clic
 
     if (hoverT > 0.01f)
     {
-        DrawNeonRect(drawList, pMin, pMax, theme::GetColorU32(theme::ACCENT_COLOR), 1.0f,
-                     alpha * hoverT);
+        DrawNeonRect(drawList, pMin, pMax, theme::ACCENT_COLOR_U32.Get(), 1.0f, alpha * hoverT);
     }
 
-    DrawBlurShadow(drawList, pMin, pMax, 8.0f, 10, 8.0f, alpha * 0.6f);
+    DrawBlurShadow(drawList, pMin, pMax, 8.0f, theme::GetEffects().ButtonShadowLayers, 8.0f,
+                   alpha * 0.6f);
 
-    drawList->AddRectFilledMultiColor(
-        pMin, pMax, theme::GetColorU32(theme::FadeColor(theme::BUTTON_TOP, alpha)),
-        theme::GetColorU32(theme::FadeColor(theme::BUTTON_TOP, alpha)),
-        theme::GetColorU32(theme::FadeColor(theme::BUTTON_BOTTOM, alpha)),
-        theme::GetColorU32(theme::FadeColor(theme::BUTTON_BOTTOM, alpha)), 8.0f);
+    drawList->AddRectFilledMultiColor(pMin, pMax, theme::BUTTON_TOP_U32.Get(alpha),
+                                      theme::BUTTON_TOP_U32.Get(alpha),
+                                      theme::BUTTON_BOTTOM_U32.Get(alpha),
+                                      theme::BUTTON_BOTTOM_U32.Get(alpha), 8.0f);
 
     ImGui::PushStyleColor(ImGuiCol_Text, theme::FadeColor(theme::TEXT_PRIMARY, alpha));
     ImVec2 textSize = ImGui::CalcTextSize(label);
@@ -327,8 +425,11 @@ void Menu::DrawLoginScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
     float scale = 1.0f;
     ImVec2 logoSize = ImVec2(resource::s_LogoWidth * scale, resource::s_LogoHeight * scale);
     ImGui::SetCursorScreenPos(ImVec2(pCenter - (logoSize.x * 0.5f), pStart.y + 55));
-    ImGui::Image((void*)m_LogoTexture, logoSize, ImVec2(0, 0), ImVec2(1, 1), ImVec4(1, 1, 1, alpha),
-                 ImVec4(0, 0, 0, 0));
+    ImTextureRef logoTexture;
+    ImVec2 logoUv0, logoUv1;
+    if (m_Images.Get(m_LogoImage, logoTexture, logoUv0, logoUv1))
+        ImGui::Image(logoTexture, logoSize, logoUv0, logoUv1, ImVec4(1, 1, 1, alpha),
+                     ImVec4(0, 0, 0, 0));
 
     // App Name
     const char* titleText = OBF("กรุณาเข้าสู่ระบบ");
@@ -355,11 +456,12 @@ void Menu::DrawLoginScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
         }
         else
         {
-            // Start Transition
+            // Start Transition, the check runs while the login screen fades out
             if (m_State == AppState::LOGIN)
             {
                 m_State = AppState::TRANSITION_TO_LOADING; // Set directly to start transition
-                m_ContentAlpha = 1.0f;                     // Ensure alpha starts full
+                m_Tweens.Set(m_ContentAlpha, 1.0f);        // Ensure alpha starts full
+                StartLicenseCheck();
             }
         }
     }
@@ -386,7 +488,7 @@ void Menu::DrawLoadingScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
         if (alphaMod < 0)
             alphaMod = 0;
 
-        ImU32 col = theme::GetColorU32(theme::FadeColor(theme::ACCENT_COLOR, alpha * alphaMod));
+        ImU32 col = theme::ACCENT_COLOR_U32.Get(alpha * alphaMod);
 
         ImVec2 p1(center.x + cosf(angle) * radius, center.y + sinf(angle) * radius);
         ImVec2 p2(center.x + cosf(angle) * (radius - 10), center.y + sinf(angle) * (radius - 10));
@@ -411,18 +513,18 @@ void Menu::DrawResultScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
     if (m_WasSuccess)
     {
         // Success Circle
-        drawList->AddCircle(center, 40.0f,
-                            theme::GetColorU32(theme::FadeColor(theme::SUCCESS_COLOR, alpha)), 0,
-                            4.0f);
+        ImU32 ringColor = theme::SUCCESS_COLOR_U32.Get(alpha);
+        if (!g_SdfAtlas.DrawRing(drawList, center, 40.0f, ringColor, 4.0f))
+            drawList->AddCircle(center, 40.0f, ringColor, 0, 4.0f);
 
         // Animated Checkmark
-        float anim = m_ResultAnimT > 1.0f ? 1.0f : m_ResultAnimT;
+        float anim = std::min(m_Tweens.Get(m_ResultAnimT), 1.0f);
 
         ImVec2 p1(center.x - 20, center.y + 5);
         ImVec2 p2(center.x - 5, center.y + 20);
         ImVec2 p3(center.x + 20, center.y - 15);
 
-        ImU32 col = theme::GetColorU32(theme::FadeColor(theme::SUCCESS_COLOR, alpha));
+        ImU32 col = theme::SUCCESS_COLOR_U32.Get(alpha);
 
         ImVec2 currentP2 = p2;
 
@@ -462,13 +564,13 @@ void Menu::DrawResultScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
     else
     {
         // Error Circle
-        drawList->AddCircle(center, 40.0f,
-                            theme::GetColorU32(theme::FadeColor(theme::ERROR_COLOR, alpha)), 0,
-                            4.0f);
+        ImU32 ringColor = theme::ERROR_COLOR_U32.Get(alpha);
+        if (!g_SdfAtlas.DrawRing(drawList, center, 40.0f, ringColor, 4.0f))
+            drawList->AddCircle(center, 40.0f, ringColor, 0, 4.0f);
 
         // Animated Cross (X)
-        float anim = m_ResultAnimT > 1.0f ? 1.0f : m_ResultAnimT;
-        ImU32 col = theme::GetColorU32(theme::FadeColor(theme::ERROR_COLOR, alpha));
+        float anim = std::min(m_Tweens.Get(m_ResultAnimT), 1.0f);
+        ImU32 col = theme::ERROR_COLOR_U32.Get(alpha);
 
         float size = 20.0f * anim;
         drawList->AddLine(ImVec2(center.x - size, center.y - size),
@@ -485,11 +587,8 @@ void Menu::DrawResultScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
 
 void Menu::DrawMainMenu(ImVec2 pStart, ImVec2 pSize, float alpha)
 {
-    if (!m_SoftwareTexture)
-        return;
-
     // Check if we have at least one software
-    if (m_SoftwareList.empty())
+    if (m_Login.Software.empty())
     {
         ImGui::SetCursorScreenPos(ImVec2(pStart.x + 20, pStart.y + 40));
         ImGui::TextColored(theme::FadeColor(theme::TEXT_PRIMARY, alpha), OBF("No software found."));
@@ -497,7 +596,11 @@ void Menu::DrawMainMenu(ImVec2 pStart, ImVec2 pSize, float alpha)
     }
 
     // Use only the first app
-    const auto& app = m_SoftwareList[0];
+    const auto& app = m_Login.Software[0];
+    ImTextureRef iconTexture;
+    ImVec2 iconUv0, iconUv1;
+    if (!GetIcon(app.IconIndex, iconTexture, iconUv0, iconUv1))
+        return;
 
     float pCenter = pStart.x + pSize.x * 0.5f;
     float pMiddle = pStart.y + pSize.y * 0.5f;
@@ -519,18 +622,15 @@ void Menu::DrawMainMenu(ImVec2 pStart, ImVec2 pSize, float alpha)
 
     // Glow Effect behind image
     /*DrawNeonRect(drawList, imgPos, ImVec2(imgPos.x + imgSize, imgPos.y + imgSize),
-                 theme::GetColorU32(theme::ACCENT_COLOR), 1.0f, alpha * 0.5f, 12.0f);*/
+                 theme::ACCENT_COLOR_U32.Get(), 1.0f, alpha * 0.5f, 12.0f);*/
 
     // Image
-    drawList->AddImage((void*)m_SoftwareTexture, imgPos,
-                       ImVec2(imgPos.x + imgSize, imgPos.y + imgSize),
-                       ImVec2(0, 0), ImVec2(1, 1),
-                       theme::GetColorU32(theme::FadeColor(ImVec4(1, 1, 1, 1), alpha)));
+    drawList->AddImage(iconTexture, imgPos, ImVec2(imgPos.x + imgSize, imgPos.y + imgSize),
+                       iconUv0, iconUv1, theme::WHITE_U32.Get(alpha));
 
     // Optional: Border around image
     /*drawList->AddRect(imgPos, ImVec2(imgPos.x + imgSize, imgPos.y + imgSize),
-                      theme::GetColorU32(theme::FadeColor(theme::GLASS_BORDER, alpha)), 0.0f, 0,
-                      2.0f);*/
+                      theme::GLASS_BORDER_U32.Get(alpha), 0.0f, 0, 2.0f);*/
 
     // 3. App Name below image
     ImGui::PushFont(ImGui::GetIO().Fonts->Fonts[0]);
@@ -553,14 +653,15 @@ void Menu::DrawMainMenu(ImVec2 pStart, ImVec2 pSize, float alpha)
 
 void Menu::DrawLaunchingScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
 {
-    if (!m_SoftwareTexture)
+    if (m_SelectedIndex < 0 || m_SelectedIndex >= (int)m_Login.Software.size())
         return;
 
-    if (m_SelectedIndex < 0 || m_SelectedIndex >= m_SoftwareList.size())
+    const auto& app = m_Login.Software[m_SelectedIndex];
+    ImTextureRef iconTexture;
+    ImVec2 iconUv0, iconUv1;
+    if (!GetIcon(app.IconIndex, iconTexture, iconUv0, iconUv1))
         return;
 
-    const auto& app = m_SoftwareList[m_SelectedIndex];
-
     float pCenter = pStart.x + pSize.x * 0.5f;
     float pMiddle = pStart.y + pSize.y * 0.5f;
 
@@ -570,13 +671,12 @@ void Menu::DrawLaunchingScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
     ImVec2 pMin(center.x - iconSize * 0.5f, center.y - iconSize * 0.5f);
     ImVec2 pMax(center.x + iconSize * 0.5f, center.y + iconSize * 0.5f);
 
-    ImGui::GetWindowDrawList()->AddImage(
-        (void*)m_SoftwareTexture, pMin, pMax, ImVec2(0, 0), ImVec2(1, 1),
-        theme::GetColorU32(theme::FadeColor(ImVec4(1, 1, 1, 1), alpha)));
+    ImGui::GetWindowDrawList()->AddImage(iconTexture, pMin, pMax, iconUv0, iconUv1,
+                                         theme::WHITE_U32.Get(alpha));
 
     // Neon Ring Pulse
     /*float pulse = sinf(m_Time * 5.0f) * 0.5f + 0.5f;
-    DrawNeonRect(ImGui::GetWindowDrawList(), pMin, pMax, theme::GetColorU32(theme::ACCENT_COLOR),
+    DrawNeonRect(ImGui::GetWindowDrawList(), pMin, pMax, theme::ACCENT_COLOR_U32.Get(),
                  1.0f, alpha * pulse, 0.0f);*/
 
     // Text
@@ -599,7 +699,7 @@ void Menu::DrawLaunchingScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
     // Fill - Infinite looping animation
     float segmentWidth = barWidth * 0.3f; // Width of the moving segment
     float cycleTime = 1.5f;               // Time for one complete cycle in seconds
-    float progress = fmod(m_LaunchAnimT, cycleTime) / cycleTime; // Loop between 0-1
+    float progress = fmod(m_Tweens.Get(m_LaunchAnimT), cycleTime) / cycleTime; // Loop between 0-1
 
     // Calculate segment position (moving left to right)
     float segmentStart = (barWidth + segmentWidth) * progress - segmentWidth;
@@ -610,166 +710,152 @@ void Menu::DrawLaunchingScreen(ImVec2 pStart, ImVec2 pSize, float alpha)
     {
         ImGui::GetWindowDrawList()->AddRectFilled(
             ImVec2(barStart.x + fillStart, barStart.y),
-            ImVec2(barStart.x + fillEnd, barStart.y + barHeight),
-            theme::GetColorU32(theme::FadeColor(theme::ACCENT_COLOR, alpha)), 2.0f);
+            ImVec2(barStart.x + fillEnd, barStart.y + barHeight), theme::ACCENT_COLOR_U32.Get(alpha),
+            2.0f);
     }
 
     // Perform Launch Action at end
-    if (m_LaunchAnimT > 2.0f && !m_LaunchStart && !g_Closing)
+    if (m_Tweens.Get(m_LaunchAnimT) > 2.0f && !m_LaunchStart && !g_Closing)
         StartLaunchSoftware(app.ID);
 }
 
-void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
+void Menu::Render(float deltaTime)
 {
-    if (m_LogoTexture == nullptr)
-        LoadTexture(device);
+    if (m_LogoImage < 0)
+        LoadTexture();
 
+    // Window fade in / out, every tween advances in one pass
     if (g_Closing)
     {
-        m_WindowAlpha -= deltaTime * 3.0f;
-        if (m_WindowAlpha <= 0.0f)
-        {
-            PostQuitMessage(0);
-            return;
-        }
+        CancelPendingOperations();
+        m_Tweens.MoveTo(m_WindowAlpha, 0.0f, 3.0f);
     }
     else
     {
         m_Time += deltaTime;
         m_StateTime += deltaTime; // Reset on state switch
-        if (m_WindowAlpha < 1.0f)
-        {
-            m_WindowAlpha += deltaTime * 2.0f;
-            if (m_WindowAlpha > 1.0f)
-                m_WindowAlpha = 1.0f;
-        }
+        m_Tweens.MoveTo(m_WindowAlpha, 1.0f, 2.0f);
+    }
+    m_Tweens.Update(deltaTime);
+
+    if (g_Closing && m_Tweens.Get(m_WindowAlpha) <= 0.0f)
+    {
+        m_Platform.Quit();
+        return;
     }
 
-    float easedAlpha = theme::EaseOutCubic(m_WindowAlpha);
+    // Resume the service flows whose step finished
+    m_Scheduler.Tick();
+
+    float easedAlpha = theme::EaseOutCubic(m_Tweens.Get(m_WindowAlpha));
 
     // ---- State Transitions ----
     if (m_State == AppState::LOGIN)
     {
-        if (m_ContentAlpha < 1.0f)
-            m_ContentAlpha += deltaTime * 3.0f;
+        m_Tweens.MoveTo(m_ContentAlpha, 1.0f, 3.0f);
     }
     else if (m_State == AppState::TRANSITION_TO_LOADING)
     {
-        m_ContentAlpha -= deltaTime * 3.0f;
-        if (m_ContentAlpha <= 0.0f)
+        m_Tweens.MoveTo(m_ContentAlpha, 0.0f, 3.0f);
+        if (m_Tweens.Get(m_ContentAlpha) <= 0.0f)
         {
-            m_ContentAlpha = 0.0f;
             m_State = AppState::LOADING;
             m_StateTime = 0.0f;
-            StartLicenseCheck();
         }
     }
     else if (m_State == AppState::LOADING)
     {
-        if (m_ContentAlpha < 1.0f)
-            m_ContentAlpha += deltaTime * 3.0f;
+        m_Tweens.MoveTo(m_ContentAlpha, 1.0f, 3.0f);
 
-        if (m_LicenseCheckFuture.valid())
+        if (m_LicenseResult)
         {
-            auto status = m_LicenseCheckFuture.wait_for(std::chrono::milliseconds(0));
-            if (status == std::future_status::ready)
-            {
-                bool result = m_LicenseCheckFuture.get();
-                m_WasSuccess = result;
-                m_NextState = AppState::TRANSITION_FROM_LOADING;
-                m_State = AppState::TRANSITION_FROM_LOADING;
-                m_StateTime = 0.0f;
-            }
+            m_WasSuccess = *m_LicenseResult == service::OperationResult::SUCCESS;
+            m_LicenseResult.reset();
+
+            // Click to result: network time vs when the transition let us show it
+            auto ms = [this](std::chrono::steady_clock::time_point t) {
+                std::chrono::duration<double, std::milli> elapsed = t - m_LicenseClickTime;
+                return elapsed.count();
+            };
+            char message[128];
+            snprintf(message, sizeof(message),
+                     "License check: result after %.0f ms, shown after %.0f ms\n",
+                     ms(m_LicenseResultTime), ms(std::chrono::steady_clock::now()));
+            m_Platform.Log(message);
+            m_NextState = AppState::TRANSITION_FROM_LOADING;
+            m_State = AppState::TRANSITION_FROM_LOADING;
+            m_StateTime = 0.0f;
         }
     }
     else if (m_State == AppState::TRANSITION_FROM_LOADING)
     {
-        m_ContentAlpha -= deltaTime * 3.0f;
-        if (m_ContentAlpha <= 0.0f)
+        m_Tweens.MoveTo(m_ContentAlpha, 0.0f, 3.0f);
+        if (m_Tweens.Get(m_ContentAlpha) <= 0.0f)
         {
-            m_ContentAlpha = 0.0f;
             m_State = AppState::RESULT;
             m_StateTime = 0.0f;
-            m_ResultAnimT = 0.0f;
+            m_Tweens.Set(m_ResultAnimT, 0.0f);
         }
     }
     else if (m_State == AppState::RESULT)
     {
-        if (m_ContentAlpha < 1.0f)
-            m_ContentAlpha += deltaTime * 3.0f;
-        m_ResultAnimT += deltaTime * 1.5f;
+        // Result timer runs past both auto-transition points
+        m_Tweens.MoveTo(m_ContentAlpha, 1.0f, 3.0f);
+        m_Tweens.MoveTo(m_ResultAnimT, 2.5f, 1.5f);
 
         // Auto-transitions
-        if (!m_WasSuccess && m_ResultAnimT > 2.0f)
+        float resultAnimT = m_Tweens.Get(m_ResultAnimT);
+        if (!m_WasSuccess && resultAnimT > 2.0f)
         {
             m_State = AppState::TRANSITION_TO_LOGIN;
         }
-        else if (m_WasSuccess && m_ResultAnimT > 1.5f)
+        else if (m_WasSuccess && resultAnimT > 1.5f)
         {
             m_State = AppState::TRANSITION_TO_MAINMENU;
-            m_ContentAlpha = 1.0f; // Start Fade out
+            m_Tweens.Set(m_ContentAlpha, 1.0f); // Start Fade out
         }
     }
     else if (m_State == AppState::TRANSITION_TO_LOGIN)
     {
-        m_ContentAlpha -= deltaTime * 3.0f;
-        if (m_ContentAlpha <= 0.0f)
+        m_Tweens.MoveTo(m_ContentAlpha, 0.0f, 3.0f);
+        if (m_Tweens.Get(m_ContentAlpha) <= 0.0f)
         {
-            m_ContentAlpha = 0.0f;
             m_State = AppState::LOGIN;
             memset(m_LicenseKey, 0, 64);
         }
     }
     else if (m_State == AppState::TRANSITION_TO_MAINMENU)
     {
-        m_ContentAlpha -= deltaTime * 3.0f;
-        if (m_ContentAlpha <= 0.0f)
+        m_Tweens.MoveTo(m_ContentAlpha, 0.0f, 3.0f);
+        if (m_Tweens.Get(m_ContentAlpha) <= 0.0f)
         {
-            m_ContentAlpha = 0.0f;
             m_State = AppState::MAIN_MENU;
             m_StateTime = 0.0f;
         }
     }
     else if (m_State == AppState::MAIN_MENU)
     {
-        if (m_ContentAlpha < 1.0f)
-            m_ContentAlpha += deltaTime * 2.0f;
+        m_Tweens.MoveTo(m_ContentAlpha, 1.0f, 2.0f);
     }
     else if (m_State == AppState::TRANSITION_TO_LAUNCHING)
     {
-        m_ContentAlpha -= deltaTime * 3.0f;
-        if (m_ContentAlpha <= 0.0f)
+        m_Tweens.MoveTo(m_ContentAlpha, 0.0f, 3.0f);
+        if (m_Tweens.Get(m_ContentAlpha) <= 0.0f)
         {
-            m_ContentAlpha = 0.0f;
             m_State = AppState::LAUNCHING;
-            m_LaunchAnimT = 0.0f;
+            m_Tweens.Set(m_LaunchAnimT, 0.0f);
         }
     }
     else if (m_State == AppState::LAUNCHING)
     {
-        // Fade In Launch Screen
-        if (m_ContentAlpha < 1.0f)
-            m_ContentAlpha += deltaTime * 2.0f;
-        m_LaunchAnimT += deltaTime;
+        // Fade In Launch Screen, the progress bar loops on the launch timer
+        m_Tweens.MoveTo(m_ContentAlpha, 1.0f, 2.0f);
+        m_Tweens.MoveTo(m_LaunchAnimT, FLT_MAX, 1.0f);
 
-        // Launch then Quit
-        if (m_LaunchAnimT > 2.1f && m_LaunchStart)
-        {
-            if (m_LaunchResultFuture.valid())
-            {
-                auto status = m_LaunchResultFuture.wait_for(std::chrono::milliseconds(0));
-                if (status == std::future_status::ready)
-                {
-                    bool result = m_LaunchResultFuture.get();
-                    if (result)
-                        g_Closing = true;
-                }
-            }
-        }
+        // Launch then Quit, see LaunchFlow
     }
     // ---------------------------
 
-    float windowScale = 1.0f;
     float windowAlphaMod = 1.0f;
 
     ImGui::SetNextWindowSize(ImVec2(380, 520));
@@ -781,13 +867,9 @@ void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
 
     // Shake Calculation
     float shakeOffset = 0.0f;
-    if (m_ErrorShakeT > 0.0f)
-    {
-        m_ErrorShakeT -= deltaTime * 2.0f;
-        if (m_ErrorShakeT < 0.0f)
-            m_ErrorShakeT = 0.0f;
-        shakeOffset = sinf(m_ErrorShakeT * 30.0f) * 10.0f * m_ErrorShakeT;
-    }
+    float shakeT = m_Tweens.Get(m_ErrorShakeT);
+    if (shakeT > 0.0f)
+        shakeOffset = sinf(shakeT * 30.0f) * 10.0f * shakeT;
 
     // Draw Glass Panel (Decomposed)
     ImDrawList* drawList = ImGui::GetWindowDrawList();
@@ -797,12 +879,13 @@ void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
     // 1. Shadow
     DrawBlurShadow(
         drawList, panelStart, ImVec2(panelStart.x + panelSize.x, panelStart.y + panelSize.y),
-        theme::GLASS_SHADOW_SIZE, theme::GLASS_SHADOW_LAYERS, 12.0f, easedAlpha * windowAlphaMod);
+        theme::GLASS_SHADOW_SIZE, theme::GetEffects().GlassShadowLayers, 12.0f,
+        easedAlpha * windowAlphaMod);
 
     // 2. Glass Background Fill
     drawList->AddRectFilled(
         panelStart, ImVec2(panelStart.x + panelSize.x, panelStart.y + panelSize.y),
-        theme::GetColorU32(theme::FadeColor(theme::GLASS_BG, easedAlpha * windowAlphaMod)), 12.0f);
+        theme::GLASS_BG_U32.Get(easedAlpha * windowAlphaMod), 12.0f);
 
     // 3. Background Animation (Clipped to Panel)
     drawList->PushClipRect(panelStart,
@@ -835,19 +918,13 @@ void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
         ImVec2 drawPos = ImVec2(panelStart.x + blob.Pos.x, panelStart.y + blob.Pos.y);
 
         // Only draw if alpha > 0
-        if (easedAlpha > 0.01f)
+        if (easedAlpha > 0.01f && m_BlobTexture != ImTextureID_Invalid &&
+            theme::GetEffects().BackgroundBlobs)
         {
-            DrawBlurShadow(drawList, drawPos, drawPos, blob.Size, 20, blob.Size, easedAlpha * 0.3f);
-            // Add colored core
-            int numLayers = 24;
-            for (int i = 0; i < numLayers; i++)
-            {
-                float f = (float)i / numLayers;
-                float r = blob.Size * (1.0f - f * 0.5f);
-                float a = (1.0f - f) * 0.1f * easedAlpha * windowAlphaMod;
-                drawList->AddCircleFilled(drawPos, r,
-                                          theme::GetColorU32(theme::FadeColor(blob.Color, a)));
-            }
+            // Pre-baked shadow + colored core, one quad per blob
+            ImVec4 tint(blob.Color.x, blob.Color.y, blob.Color.z, easedAlpha * windowAlphaMod);
+            m_BlobSprite.Draw(drawList, m_BlobTexture, blob.SpriteIndex, drawPos,
+                              theme::GetColorU32(tint));
         }
     }
 
@@ -856,8 +933,7 @@ void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
     // 4. Glass Border
     drawList->AddRect(
         panelStart, ImVec2(panelStart.x + panelSize.x, panelStart.y + panelSize.y),
-        theme::GetColorU32(theme::FadeColor(theme::GLASS_BORDER, easedAlpha * windowAlphaMod)),
-        12.0f, 0, 1.5f);
+        theme::GLASS_BORDER_U32.Get(easedAlpha * windowAlphaMod), 12.0f, 0, 1.5f);
 
     // Window Controls
     if (m_State != AppState::LAUNCHING)
@@ -867,7 +943,7 @@ void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
         // Minimize
         ImVec2 minPos = ImGui::GetCursorScreenPos();
         if (ImGui::InvisibleButton(OBF("##Min"), ImVec2(30, 30)))
-            ShowWindow((HWND)platformHandle, SW_MINIMIZE);
+            m_Platform.Minimize();
         bool minHovered = ImGui::IsItemHovered();
         ImGui::SetCursorScreenPos(ImVec2(minPos.x + 8, minPos.y + 4));
         ImGui::TextColored(
@@ -893,19 +969,13 @@ void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
     // Dragging (Manual to avoid Modal Loop freeze)
     bool mouseDown = ImGui::IsMouseDown(0);
 
-    // Start Dragging
-    if (mouseDown && !m_IsDragging)
+    // Start Dragging (not right after a replayed frame, content items weren't hovered-tested)
+    if (mouseDown && !m_IsDragging && !m_ContentReplayed)
     {
         if (!ImGui::IsAnyItemActive() && !ImGui::IsAnyItemHovered() && ImGui::IsWindowHovered())
         {
-            if (platformHandle)
-            {
-                m_IsDragging = true;
-                POINT cv;
-                GetCursorPos(&cv);
-                m_DragLastX = cv.x;
-                m_DragLastY = cv.y;
-            }
+            m_IsDragging = true;
+            m_Platform.GetCursorPos(m_DragLastX, m_DragLastY);
         }
     }
 
@@ -914,49 +984,74 @@ void Menu::Render(float deltaTime, void* platformHandle, ID3D11Device* device)
         m_IsDragging = false;
 
     // Process Dragging
-    if (m_IsDragging && platformHandle)
+    if (m_IsDragging)
     {
-        POINT cv;
-        GetCursorPos(&cv);
+        long x, y;
+        m_Platform.GetCursorPos(x, y);
 
-        int dx = cv.x - m_DragLastX;
-        int dy = cv.y - m_DragLastY;
+        long dx = x - m_DragLastX;
+        long dy = y - m_DragLastY;
 
         if (dx != 0 || dy != 0)
         {
-            RECT rect;
-            GetWindowRect((HWND)platformHandle, &rect);
-            SetWindowPos((HWND)platformHandle, NULL, rect.left + dx, rect.top + dy, 0, 0,
-                         SWP_NOSIZE | SWP_NOZORDER);
-            m_DragLastX = cv.x;
-            m_DragLastY = cv.y;
+            m_Platform.MoveWindow(dx, dy);
+            m_DragLastX = x;
+            m_DragLastY = y;
         }
     }
 
     // Dispatch Content
-    float finalAlpha = easedAlpha * m_ContentAlpha * windowAlphaMod;
+    float finalAlpha = easedAlpha * m_Tweens.Get(m_ContentAlpha) * windowAlphaMod;
 
+    ScreenFn screen = nullptr;
     if (m_State == AppState::LOGIN || m_State == AppState::TRANSITION_TO_LOADING)
     {
-        DrawLoginScreen(panelStart, panelSize, finalAlpha);
+        screen = &Menu::DrawLoginScreen;
     }
     else if (m_State == AppState::LOADING || m_State == AppState::TRANSITION_FROM_LOADING)
     {
-        DrawLoadingScreen(panelStart, panelSize, finalAlpha);
+        screen = &Menu::DrawLoadingScreen;
     }
     else if (m_State == AppState::RESULT || m_State == AppState::TRANSITION_TO_LOGIN ||
              m_State == AppState::TRANSITION_TO_MAINMENU)
     {
-        DrawResultScreen(panelStart, panelSize, finalAlpha);
+        screen = &Menu::DrawResultScreen;
     }
     else if (m_State == AppState::MAIN_MENU || m_State == AppState::TRANSITION_TO_LAUNCHING)
     {
-        DrawMainMenu(panelStart, panelSize, finalAlpha);
+        screen = &Menu::DrawMainMenu;
     }
     else if (m_State == AppState::LAUNCHING)
     {
-        DrawLaunchingScreen(panelStart, panelSize, finalAlpha);
+        screen = &Menu::DrawLaunchingScreen;
+    }
+
+    // Fades and shake reuse the last recorded geometry of the same screen
+    ImVec2 contentOffset(shakeOffset, 0.0f);
+    bool replayed = false;
+    if (screen && screen == m_RetainedScreen && m_RetainedQuality == theme::GetQuality() &&
+        CanReplayContent())
+        replayed = m_RetainedContent.Replay(drawList, finalAlpha, contentOffset);
+
+    if (!replayed && screen)
+    {
+        m_RetainedContent.BeginRecord(drawList);
+        (this->*screen)(panelStart, panelSize, finalAlpha);
+
+        // Only keep a copy when the next frames can use it
+        if (CanReplayContent())
+        {
+            m_RetainedContent.EndRecord(drawList, finalAlpha, contentOffset);
+            m_RetainedScreen = screen;
+            m_RetainedQuality = theme::GetQuality();
+        }
+        else
+        {
+            m_RetainedContent.Invalidate();
+            m_RetainedScreen = nullptr;
+        }
     }
+    m_ContentReplayed = replayed;
 
     ImGui::End();
 }
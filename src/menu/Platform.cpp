@@ -0,0 +1,41 @@
+#include "69/menu/Platform.h"
+
+#include <cstdio>
+
+namespace menu
+{
+
+void NullPlatform::GetCursorPos(long& x, long& y)
+{
+    x = m_CursorX;
+    y = m_CursorY;
+}
+
+void NullPlatform::MoveWindow(long dx, long dy)
+{
+    m_WindowX += dx;
+    m_WindowY += dy;
+}
+
+void NullPlatform::Minimize()
+{
+    m_Minimized = true;
+}
+
+void NullPlatform::Quit()
+{
+    m_Quit = true;
+}
+
+void NullPlatform::Log(const char* message)
+{
+    fputs(message, stderr);
+}
+
+void NullPlatform::SetCursorPos(long x, long y)
+{
+    m_CursorX = x;
+    m_CursorY = y;
+}
+
+} // namespace menu
@@ -0,0 +1,76 @@
+#include "69/menu/QualityController.h"
+
+#include <algorithm>
+
+namespace menu
+{
+
+static const float TARGET_FRAME_TIME = 1.0f / 50.0f;
+static const float DOWNGRADE_RATIO = 1.2f; // p90 above target * ratio drops a tier
+static const float UPGRADE_RATIO = 0.85f;  // p90 below target * ratio allows climbing back
+static const int WINDOW_SIZE = 90;
+static const int UPGRADE_DELAY = 180;     // Frames at a tier before trying the next one up
+static const int MAX_UPGRADE_DELAY = 3600;
+
+QualityController::QualityController() : m_Window(WINDOW_SIZE, 0.0f), m_UpgradeDelay(UPGRADE_DELAY)
+{
+}
+
+void QualityController::AddFrame(float seconds)
+{
+    if (m_Forced)
+        return;
+
+    m_Window[m_WindowPos] = seconds;
+    m_WindowPos = (m_WindowPos + 1) % WINDOW_SIZE;
+    m_WindowCount = std::min(m_WindowCount + 1, WINDOW_SIZE);
+    m_FramesAtTier++;
+
+    // Judge a tier only on frames rendered with it
+    if (m_WindowCount < WINDOW_SIZE || m_FramesAtTier < WINDOW_SIZE)
+        return;
+
+    float p90 = GetWindowP90();
+    if (p90 > TARGET_FRAME_TIME * DOWNGRADE_RATIO && m_Tier != theme::Quality::LOW)
+    {
+        // The last upgrade didn't hold, be slower to try again
+        if (m_JustUpgraded)
+            m_UpgradeDelay = std::min(m_UpgradeDelay * 2, MAX_UPGRADE_DELAY);
+
+        SetTier((theme::Quality)((int)m_Tier - 1));
+        m_JustUpgraded = false;
+    }
+    else if (p90 < TARGET_FRAME_TIME * UPGRADE_RATIO && m_Tier != theme::Quality::HIGH &&
+             m_FramesAtTier >= m_UpgradeDelay)
+    {
+        SetTier((theme::Quality)((int)m_Tier + 1));
+        m_JustUpgraded = true;
+    }
+    else if (m_FramesAtTier >= m_UpgradeDelay)
+    {
+        // Upgrade survived a full delay
+        m_JustUpgraded = false;
+    }
+}
+
+void QualityController::Force(theme::Quality tier)
+{
+    m_Forced = true;
+    m_Tier = tier;
+}
+
+float QualityController::GetWindowP90() const
+{
+    std::vector<float> samples(m_Window.begin(), m_Window.begin() + m_WindowCount);
+    int rank = (m_WindowCount * 90 + 99) / 100 - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+}
+
+void QualityController::SetTier(theme::Quality tier)
+{
+    m_Tier = tier;
+    m_FramesAtTier = 0;
+}
+
+} // namespace menu
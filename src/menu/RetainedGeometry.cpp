@@ -0,0 +1,220 @@
+#include "69/menu/RetainedGeometry.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define RETAINED_USE_SSE2
+#endif
+
+namespace menu
+{
+namespace retained
+{
+
+static_assert(sizeof(ImDrawVert) == 20 && offsetof(ImDrawVert, col) == 16,
+              "TransformVertices expects the default ImDrawVert layout");
+
+void TransformVertices(const ImDrawVert* src, ImDrawVert* dst, int count, ImVec2 offset,
+                       int alphaScale)
+{
+    int i = 0;
+
+#ifdef RETAINED_USE_SSE2
+    // 4 vertices are 20 dwords = 5 registers: [x y u v] [c x y u] [v c x y] [u v c x] [y u v c]
+    const __m128 add[5] = {
+        _mm_setr_ps(offset.x, offset.y, 0.0f, 0.0f), _mm_setr_ps(0.0f, offset.x, offset.y, 0.0f),
+        _mm_setr_ps(0.0f, 0.0f, offset.x, offset.y), _mm_setr_ps(0.0f, 0.0f, 0.0f, offset.x),
+        _mm_setr_ps(offset.y, 0.0f, 0.0f, 0.0f)};
+    const __m128i posMask[5] = {_mm_setr_epi32(-1, -1, 0, 0), _mm_setr_epi32(0, -1, -1, 0),
+                                _mm_setr_epi32(0, 0, -1, -1), _mm_setr_epi32(0, 0, 0, -1),
+                                _mm_setr_epi32(-1, 0, 0, 0)};
+    const __m128i colMask[5] = {_mm_setzero_si128(), _mm_setr_epi32(-1, 0, 0, 0),
+                                _mm_setr_epi32(0, -1, 0, 0), _mm_setr_epi32(0, 0, -1, 0),
+                                _mm_setr_epi32(0, 0, 0, -1)};
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i scale = _mm_set1_epi32(alphaScale);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const float* s = &src[i].pos.x;
+        float* d = &dst[i].pos.x;
+        for (int r = 0; r < 5; r++)
+        {
+            __m128 v = _mm_loadu_ps(s + r * 4);
+            __m128i bits = _mm_castps_si128(v);
+
+            // Positions, only taken from the position lanes
+            __m128i moved = _mm_castps_si128(_mm_add_ps(v, add[r]));
+
+            // Colors, alpha * scale fits in 16 bits since scale <= 257
+            __m128i alpha = _mm_srli_epi32(bits, 24);
+            alpha = _mm_srli_epi32(_mm_mullo_epi16(alpha, scale), 8);
+            __m128i col = _mm_or_si128(_mm_and_si128(bits, rgbMask), _mm_slli_epi32(alpha, 24));
+
+            __m128i out = _mm_andnot_si128(_mm_or_si128(posMask[r], colMask[r]), bits);
+            out = _mm_or_si128(out, _mm_and_si128(moved, posMask[r]));
+            out = _mm_or_si128(out, _mm_and_si128(col, colMask[r]));
+            _mm_storeu_si128((__m128i*)(d + r * 4), out);
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i].pos = ImVec2(src[i].pos.x + offset.x, src[i].pos.y + offset.y);
+        dst[i].uv = src[i].uv;
+        ImU32 alpha = (((src[i].col >> IM_COL32_A_SHIFT) & 0xFF) * alphaScale) >> 8;
+        dst[i].col = (src[i].col & ~IM_COL32_A_MASK) | (alpha << IM_COL32_A_SHIFT);
+    }
+}
+
+void RebaseIndices(const ImDrawIdx* src, ImDrawIdx* dst, int count, unsigned int base)
+{
+    int i = 0;
+
+#ifdef RETAINED_USE_SSE2
+    if constexpr (sizeof(ImDrawIdx) == 2)
+    {
+        const __m128i add = _mm_set1_epi16((short)base);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_add_epi16(v, add));
+        }
+    }
+    else
+    {
+        const __m128i add = _mm_set1_epi32((int)base);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_add_epi32(v, add));
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+        dst[i] = (ImDrawIdx)(src[i] + base);
+}
+
+} // namespace retained
+
+void RetainedGeometry::BeginRecord(ImDrawList* drawList)
+{
+    m_CmdStart = drawList->CmdBuffer.Size - 1;
+    m_VtxStart = drawList->VtxBuffer.Size;
+    m_IdxStart = drawList->IdxBuffer.Size;
+}
+
+void RetainedGeometry::EndRecord(ImDrawList* drawList, float alpha, ImVec2 offset)
+{
+    Invalidate();
+
+    // Nothing to scale from
+    if (alpha <= 0.01f)
+        return;
+
+    int vtxEnd = drawList->VtxBuffer.Size;
+    int idxEnd = drawList->IdxBuffer.Size;
+    if (sizeof(ImDrawIdx) == 2 && vtxEnd - m_VtxStart >= (1 << 16))
+        return;
+
+    // Split the recorded indices by draw command (texture / clip rect changes)
+    for (int c = std::max(m_CmdStart, 0); c < drawList->CmdBuffer.Size; c++)
+    {
+        const ImDrawCmd& cmd = drawList->CmdBuffer[c];
+        int begin = std::max((int)cmd.IdxOffset, m_IdxStart);
+        int end = std::min((int)(cmd.IdxOffset + cmd.ElemCount), idxEnd);
+        if (end <= begin)
+            continue;
+
+        // Callbacks and large meshes split with VtxOffset aren't worth replaying
+        if (cmd.UserCallback || cmd.VtxOffset != 0)
+        {
+            m_Segments.clear();
+            return;
+        }
+
+        m_Segments.push_back({cmd.ClipRect, cmd.TexRef, begin - m_IdxStart, end - begin});
+    }
+
+    m_Vertices.assign(drawList->VtxBuffer.Data + m_VtxStart, drawList->VtxBuffer.Data + vtxEnd);
+    m_Indices.resize(idxEnd - m_IdxStart);
+    for (int i = m_IdxStart; i < idxEnd; i++)
+    {
+        int idx = (int)drawList->IdxBuffer[i] - m_VtxStart;
+        if (idx < 0)
+        {
+            Invalidate();
+            return;
+        }
+        m_Indices[i - m_IdxStart] = (ImDrawIdx)idx;
+    }
+
+    m_Alpha = alpha;
+    m_Offset = offset;
+    m_FontUvScale = ImGui::GetIO().Fonts->TexUvScale;
+    m_Valid = true;
+}
+
+bool RetainedGeometry::Replay(ImDrawList* drawList, float alpha, ImVec2 offset) const
+{
+    if (!m_Valid)
+        return false;
+
+    // Can only fade out from the recorded alpha
+    if (alpha > m_Alpha * 1.004f)
+        return false;
+
+    // Glyph UVs are stale once the font atlas has grown
+    ImVec2 fontUvScale = ImGui::GetIO().Fonts->TexUvScale;
+    if (fontUvScale.x != m_FontUvScale.x || fontUvScale.y != m_FontUvScale.y)
+        return false;
+
+    int alphaScale = std::clamp((int)(alpha / m_Alpha * 256.0f + 0.5f), 0, 256);
+    ImVec2 delta(offset.x - m_Offset.x, offset.y - m_Offset.y);
+    int vtxCount = (int)m_Vertices.size();
+
+    unsigned int base = 0;
+    bool first = true;
+    for (const auto& segment : m_Segments)
+    {
+        drawList->PushClipRect(ImVec2(segment.ClipRect.x, segment.ClipRect.y),
+                               ImVec2(segment.ClipRect.z, segment.ClipRect.w));
+        drawList->PushTexture(segment.TexRef);
+
+        // All vertices go with the first segment, the others only add indices
+        drawList->PrimReserve(segment.IdxCount, first ? vtxCount : 0);
+        if (first)
+        {
+            base = drawList->_VtxCurrentIdx;
+            retained::TransformVertices(m_Vertices.data(), drawList->_VtxWritePtr, vtxCount,
+                                        delta, alphaScale);
+            drawList->_VtxWritePtr += vtxCount;
+            drawList->_VtxCurrentIdx += vtxCount;
+            first = false;
+        }
+
+        retained::RebaseIndices(m_Indices.data() + segment.IdxOffset, drawList->_IdxWritePtr,
+                                segment.IdxCount, base);
+        drawList->_IdxWritePtr += segment.IdxCount;
+
+        drawList->PopTexture();
+        drawList->PopClipRect();
+    }
+
+    return true;
+}
+
+void RetainedGeometry::Invalidate()
+{
+    m_Valid = false;
+    m_Segments.clear();
+    m_Vertices.clear();
+    m_Indices.clear();
+}
+
+} // namespace menu
@@ -0,0 +1,176 @@
+#include "69/menu/SdfAtlas.h"
+
+#include "69/menu/Raster.h"
+#include "69/menu/SdfBaker.h"
+#include "imgui/imgui_internal.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace menu
+{
+
+// DrawNeonRect strokes from the outermost glow to the sharp line: extra width, alpha
+static const float NEON_EXTRA_WIDTH[3] = {6.0f, 2.0f, 0.0f};
+static const float NEON_ALPHA[3] = {40.0f / 255.0f, 80.0f / 255.0f, 200.0f / 255.0f};
+
+SdfAtlas::~SdfAtlas()
+{
+    SetTextureFactory(nullptr);
+}
+
+void SdfAtlas::SetTextureFactory(ITextureFactory* textures)
+{
+    if (textures == m_Textures)
+        return;
+
+    if (m_Textures)
+    {
+        for (auto& entry : m_Entries)
+        {
+            if (entry.Texture != ImTextureID_Invalid)
+                m_Textures->DestroyTexture(entry.Texture);
+        }
+    }
+    m_Entries.clear();
+    m_Textures = textures;
+}
+
+void SdfAtlas::WarmNeonRect(float thickness, float rounding, int layers)
+{
+    Find(Shape::NEON_RECT, rounding, thickness, layers);
+}
+
+void SdfAtlas::WarmRing(float radius, float thickness)
+{
+    Find(Shape::RING, radius, thickness, 1);
+}
+
+const SdfAtlas::Entry* SdfAtlas::Find(Shape kind, float size, float thickness, int layers)
+{
+    for (const auto& entry : m_Entries)
+    {
+        if (entry.Kind == kind && entry.Size == size && entry.Thickness == thickness &&
+            entry.Layers == layers)
+            return entry.Texture != ImTextureID_Invalid ? &entry : nullptr;
+    }
+
+    if (!m_Textures)
+        return nullptr;
+
+    Entry entry = {};
+    entry.Kind = kind;
+    entry.Size = size;
+    entry.Thickness = thickness;
+    entry.Layers = layers;
+
+    raster::Stroke strokes[3];
+    int strokeCount = 0;
+    float widest = thickness;
+    if (kind == Shape::NEON_RECT)
+    {
+        // Outer glows are the ones dropped when there are fewer layers
+        for (int i = 3 - std::clamp(layers, 1, 3); i < 3; i++)
+            strokes[strokeCount++] = {thickness + NEON_EXTRA_WIDTH[i], NEON_ALPHA[i]};
+        widest = strokes[0].Width;
+    }
+    else
+    {
+        strokes[strokeCount++] = {thickness, 1.0f};
+    }
+
+    // Half the widest stroke plus the AA fringe on each side of the outline
+    entry.Margin = (int)std::ceil(widest * 0.5f) + 2;
+    float half;
+    if (kind == Shape::NEON_RECT)
+    {
+        // Smallest rect that still has straight edges between the corners and an empty center
+        half = (float)std::max((int)std::ceil(size) + 1, entry.Margin + 1);
+    }
+    else
+    {
+        // AddCircle strokes the path half a pixel inside the radius
+        half = size - 0.5f;
+    }
+    entry.TextureSize = (int)std::ceil(half) * 2 + entry.Margin * 2;
+
+    float rounding = kind == Shape::NEON_RECT
+                         ? raster::ClampRounding(size, half * 2.0f, half * 2.0f)
+                         : half;
+    std::vector<unsigned char> pixels((size_t)entry.TextureSize * entry.TextureSize * 4);
+    raster::BakeRoundedRectStrokes(pixels.data(), entry.TextureSize, entry.TextureSize, half, half,
+                                   rounding, strokes, strokeCount);
+
+    entry.Texture = m_Textures->CreateTexture(pixels.data(), entry.TextureSize, entry.TextureSize);
+    m_Entries.push_back(entry);
+    return entry.Texture != ImTextureID_Invalid ? &m_Entries.back() : nullptr;
+}
+
+bool SdfAtlas::DrawNeonRect(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, ImU32 color,
+                            float thickness, float intensity, float rounding, int layers)
+{
+    const Entry* entry = Find(Shape::NEON_RECT, rounding, thickness, layers);
+    if (!entry)
+        return false;
+
+    // AddRect strokes the path half a pixel inside the rect
+    ImVec2 bMin(pMin.x + 0.5f, pMin.y + 0.5f);
+    ImVec2 bMax(pMax.x - 0.5f, pMax.y - 0.5f);
+    float baseSize = (float)(entry->TextureSize - entry->Margin * 2);
+    if (bMax.x - bMin.x < baseSize || bMax.y - bMin.y < baseSize)
+        return false;
+
+    float margin = (float)entry->Margin;
+    float corner = (float)entry->TextureSize * 0.5f;
+    const float xs[4] = {bMin.x - margin, bMin.x - margin + corner, bMax.x + margin - corner,
+                         bMax.x + margin};
+    const float ys[4] = {bMin.y - margin, bMin.y - margin + corner, bMax.y + margin - corner,
+                         bMax.y + margin};
+    const float uvs[4] = {0.0f, 0.5f, 0.5f, 1.0f};
+    ImU32 col = (color & ~IM_COL32_A_MASK) |
+                ((ImU32)IM_F32_TO_INT8_SAT(intensity) << IM_COL32_A_SHIFT);
+
+    // 4x4 vertex grid, the 8 border quads (the center is empty)
+    drawList->PushTexture(entry->Texture);
+    drawList->PrimReserve(8 * 6, 16);
+    ImDrawIdx base = (ImDrawIdx)drawList->_VtxCurrentIdx;
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+            drawList->PrimWriteVtx(ImVec2(xs[x], ys[y]), ImVec2(uvs[x], uvs[y]), col);
+    }
+    for (int y = 0; y < 3; y++)
+    {
+        for (int x = 0; x < 3; x++)
+        {
+            if (x == 1 && y == 1)
+                continue;
+
+            ImDrawIdx i0 = (ImDrawIdx)(base + y * 4 + x);
+            drawList->PrimWriteIdx(i0);
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 1));
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 5));
+            drawList->PrimWriteIdx(i0);
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 5));
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 4));
+        }
+    }
+    drawList->PopTexture();
+    return true;
+}
+
+bool SdfAtlas::DrawRing(ImDrawList* drawList, ImVec2 center, float radius, ImU32 color,
+                        float thickness)
+{
+    const Entry* entry = Find(Shape::RING, radius, thickness, 1);
+    if (!entry)
+        return false;
+
+    float half = (float)entry->TextureSize * 0.5f;
+    drawList->AddImage(entry->Texture, ImVec2(center.x - half, center.y - half),
+                       ImVec2(center.x + half, center.y + half), ImVec2(0.0f, 0.0f),
+                       ImVec2(1.0f, 1.0f), color);
+    return true;
+}
+
+} // namespace menu
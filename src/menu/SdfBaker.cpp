@@ -0,0 +1,150 @@
+#include "69/menu/SdfBaker.h"
+
+#include "69/menu/Raster.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SDF_USE_SSE2
+#endif
+
+namespace menu
+{
+namespace raster
+{
+
+// Below this many pixels a thread costs more than it saves
+static const int THREAD_MIN_PIXELS = 128 * 128;
+static const int MAX_THREADS = 4;
+
+struct StrokeJob
+{
+    unsigned char* Rgba;
+    int Width;
+    float Cx, Cy;
+    float Hx, Hy, R;
+    const Stroke* Strokes;
+    int StrokeCount;
+};
+
+static float StrokeAlpha(const StrokeJob& job, float x, float y)
+{
+    float d = std::fabs(RoundedRectDistance(x, y, job.Cx, job.Cy, job.Hx, job.Hy, job.R));
+    float keep = 1.0f;
+    for (int i = 0; i < job.StrokeCount; i++)
+        keep *= 1.0f - job.Strokes[i].Alpha * Coverage(d - job.Strokes[i].Width * 0.5f);
+    return 1.0f - keep;
+}
+
+static void BakeRows(const StrokeJob& job, int rowBegin, int rowEnd)
+{
+    for (int py = rowBegin; py < rowEnd; py++)
+    {
+        unsigned char* row = job.Rgba + (size_t)py * job.Width * 4;
+        float y = (float)py + 0.5f;
+        int px = 0;
+
+#ifdef SDF_USE_SSE2
+        // 4 pixels of a row at once, same math as RoundedRectDistance / Coverage
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 r = _mm_set1_ps(job.R);
+
+        float qyScalar = std::fabs(y - job.Cy) - (job.Hy - job.R);
+        const __m128 qy = _mm_set1_ps(qyScalar);
+        const __m128 oy2 = _mm_set1_ps(std::max(qyScalar, 0.0f) * std::max(qyScalar, 0.0f));
+        const __m128 cx = _mm_set1_ps(job.Cx);
+        const __m128 innerX = _mm_set1_ps(job.Hx - job.R);
+
+        for (; px + 4 <= job.Width; px += 4)
+        {
+            __m128i xi = _mm_setr_epi32(px, px + 1, px + 2, px + 3);
+            __m128 x = _mm_add_ps(_mm_cvtepi32_ps(xi), half);
+            __m128 qx = _mm_sub_ps(_mm_andnot_ps(signMask, _mm_sub_ps(x, cx)), innerX);
+            __m128 ox = _mm_max_ps(qx, zero);
+            __m128 outside = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ox, ox), oy2));
+            __m128 inside = _mm_min_ps(_mm_max_ps(qx, qy), zero);
+            __m128 d = _mm_sub_ps(_mm_add_ps(outside, inside), r);
+            d = _mm_andnot_ps(signMask, d);
+
+            __m128 keep = one;
+            for (int i = 0; i < job.StrokeCount; i++)
+            {
+                __m128 w = _mm_set1_ps(job.Strokes[i].Width * 0.5f);
+                __m128 cov = _mm_sub_ps(half, _mm_sub_ps(d, w));
+                cov = _mm_min_ps(_mm_max_ps(cov, zero), one);
+                __m128 a = _mm_mul_ps(_mm_set1_ps(job.Strokes[i].Alpha), cov);
+                keep = _mm_mul_ps(keep, _mm_sub_ps(one, a));
+            }
+
+            // IM_F32_TO_INT8_SAT
+            __m128 alpha = _mm_sub_ps(one, keep);
+            alpha = _mm_add_ps(_mm_mul_ps(alpha, _mm_set1_ps(255.0f)), half);
+            alignas(16) int bytes[4];
+            _mm_store_si128((__m128i*)bytes, _mm_cvttps_epi32(alpha));
+            for (int i = 0; i < 4; i++)
+            {
+                unsigned char* p = row + (px + i) * 4;
+                p[0] = p[1] = p[2] = 255;
+                p[3] = (unsigned char)bytes[i];
+            }
+        }
+#endif
+
+        for (; px < job.Width; px++)
+        {
+            float alpha = StrokeAlpha(job, (float)px + 0.5f, y);
+            unsigned char* p = row + px * 4;
+            p[0] = p[1] = p[2] = 255;
+            p[3] = (unsigned char)(int)(std::min(std::max(alpha, 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+void BakeRoundedRectStrokes(unsigned char* rgba, int width, int height, float hx, float hy,
+                            float r, const Stroke* strokes, int strokeCount)
+{
+    StrokeJob job = {};
+    job.Rgba = rgba;
+    job.Width = width;
+    job.Cx = (float)width * 0.5f;
+    job.Cy = (float)height * 0.5f;
+    job.Hx = hx;
+    job.Hy = hy;
+    job.R = r;
+    job.Strokes = strokes;
+    job.StrokeCount = strokeCount;
+
+    int threads = 1;
+    if (width * height >= THREAD_MIN_PIXELS)
+        threads = std::clamp((int)std::thread::hardware_concurrency(), 1, MAX_THREADS);
+
+    if (threads == 1)
+    {
+        BakeRows(job, 0, height);
+        return;
+    }
+
+    // Every row costs about the same, split them evenly
+    std::vector<std::thread> workers;
+    int rowsPerThread = (height + threads - 1) / threads;
+    for (int t = 1; t < threads; t++)
+    {
+        int begin = std::min(t * rowsPerThread, height);
+        int end = std::min(begin + rowsPerThread, height);
+        workers.emplace_back(BakeRows, std::cref(job), begin, end);
+    }
+    BakeRows(job, 0, std::min(rowsPerThread, height));
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+} // namespace raster
+} // namespace menu
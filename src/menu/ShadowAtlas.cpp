@@ -0,0 +1,147 @@
+#include "69/menu/ShadowAtlas.h"
+
+#include "69/menu/Raster.h"
+#include "69/menu/Theme.h"
+#include "imgui/imgui_internal.h"
+
+#include <cmath>
+
+namespace menu
+{
+
+// DrawBlurShadow offsets the shadow downwards
+static const float SHADOW_OFFSET_TOP = 4.0f;
+static const float SHADOW_OFFSET_BOTTOM = 8.0f;
+
+ShadowAtlas::~ShadowAtlas()
+{
+    SetTextureFactory(nullptr);
+}
+
+void ShadowAtlas::SetTextureFactory(ITextureFactory* textures)
+{
+    if (textures == m_Textures)
+        return;
+
+    if (m_Textures)
+    {
+        for (auto& entry : m_Entries)
+        {
+            if (entry.Texture != ImTextureID_Invalid)
+                m_Textures->DestroyTexture(entry.Texture);
+        }
+    }
+    m_Entries.clear();
+    m_Textures = textures;
+}
+
+const ShadowAtlas::Entry* ShadowAtlas::Find(float rounding, float spread, int layers)
+{
+    for (const auto& entry : m_Entries)
+    {
+        if (entry.Rounding == rounding && entry.Spread == spread && entry.Layers == layers)
+            return entry.Texture != ImTextureID_Invalid ? &entry : nullptr;
+    }
+
+    if (!m_Textures)
+        return nullptr;
+
+    // Shadow of the smallest rect that still has straight edges: corners + 2 flat texels
+    Entry entry = {};
+    entry.Rounding = rounding;
+    entry.Spread = spread;
+    entry.Layers = layers;
+    entry.Margin = (int)std::ceil(spread) + 2;
+    int baseSize = (int)std::ceil(rounding) * 2 + 2;
+    entry.Size = entry.Margin * 2 + baseSize;
+
+    float center = (float)entry.Size * 0.5f;
+    float half = (float)baseSize * 0.5f;
+
+    // Quantized per-layer alpha at full opacity, faded through the vertex color on draw
+    std::vector<float> layerAlpha(layers);
+    for (int i = 0; i < layers; i++)
+    {
+        float op = 1.0f - (float)i / (float)layers;
+        op *= op;
+        layerAlpha[i] = (float)(int)(theme::BLUR_STRENGTH * op) / 255.0f;
+    }
+
+    std::vector<unsigned char> pixels((size_t)entry.Size * entry.Size * 4, 255);
+    for (int py = 0; py < entry.Size; py++)
+    {
+        for (int px = 0; px < entry.Size; px++)
+        {
+            float keep = 1.0f;
+            for (int i = 0; i < layers; i++)
+            {
+                float expansion = spread * (float)i / (float)layers;
+                float extent = half + expansion;
+                float r = raster::ClampRounding(rounding + expansion, extent * 2.0f, extent * 2.0f);
+                float d = raster::RoundedRectDistance((float)px + 0.5f, (float)py + 0.5f, center,
+                                                      center, extent, extent, r);
+                keep *= 1.0f - layerAlpha[i] * raster::Coverage(d);
+            }
+            pixels[((size_t)py * entry.Size + px) * 4 + 3] =
+                (unsigned char)IM_F32_TO_INT8_SAT(1.0f - keep);
+        }
+    }
+
+    entry.Texture = m_Textures->CreateTexture(pixels.data(), entry.Size, entry.Size);
+    m_Entries.push_back(entry);
+    return entry.Texture != ImTextureID_Invalid ? &m_Entries.back() : nullptr;
+}
+
+bool ShadowAtlas::Draw(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, float shadowSize,
+                       int layers, float rounding, float alpha)
+{
+    if (layers <= 0)
+        return true;
+
+    const Entry* entry = Find(rounding, shadowSize, layers);
+    if (!entry)
+        return false;
+
+    // Shadowed rect, too small to hold both corners means the slices would overlap
+    ImVec2 bMin(pMin.x, pMin.y + SHADOW_OFFSET_TOP);
+    ImVec2 bMax(pMax.x, pMax.y + SHADOW_OFFSET_BOTTOM);
+    float baseSize = (float)(entry->Size - entry->Margin * 2);
+    if (bMax.x - bMin.x < baseSize || bMax.y - bMin.y < baseSize)
+        return false;
+
+    float margin = (float)entry->Margin;
+    float corner = (float)entry->Size * 0.5f;
+    const float xs[4] = {bMin.x - margin, bMin.x - margin + corner, bMax.x + margin - corner,
+                         bMax.x + margin};
+    const float ys[4] = {bMin.y - margin, bMin.y - margin + corner, bMax.y + margin - corner,
+                         bMax.y + margin};
+    const float uvs[4] = {0.0f, 0.5f, 0.5f, 1.0f};
+    ImU32 col = IM_COL32(0, 0, 0, IM_F32_TO_INT8_SAT(alpha));
+
+    // 4x4 vertex grid, 9 quads
+    drawList->PushTexture(entry->Texture);
+    drawList->PrimReserve(9 * 6, 16);
+    ImDrawIdx base = (ImDrawIdx)drawList->_VtxCurrentIdx;
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+            drawList->PrimWriteVtx(ImVec2(xs[x], ys[y]), ImVec2(uvs[x], uvs[y]), col);
+    }
+    for (int y = 0; y < 3; y++)
+    {
+        for (int x = 0; x < 3; x++)
+        {
+            ImDrawIdx i0 = (ImDrawIdx)(base + y * 4 + x);
+            drawList->PrimWriteIdx(i0);
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 1));
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 5));
+            drawList->PrimWriteIdx(i0);
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 5));
+            drawList->PrimWriteIdx((ImDrawIdx)(i0 + 4));
+        }
+    }
+    drawList->PopTexture();
+    return true;
+}
+
+} // namespace menu
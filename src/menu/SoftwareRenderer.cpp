@@ -0,0 +1,672 @@
+#include "69/menu/SoftwareRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#else
+#error "SoftwareRenderer needs SSE2"
+#endif
+
+namespace menu
+{
+
+using MemoryTexture = MemoryTextureFactory::MemoryTexture;
+
+// Vertices are snapped to 1/16 pixel, edge functions are exact integers
+static const int SUBPIXEL_BITS = 4;
+static const int SUBPIXEL = 1 << SUBPIXEL_BITS;
+static const int HALF_PIXEL = SUBPIXEL / 2;
+
+// Vertices further out are dropped: keeps the edge steps of a tile row in 32 bits
+static const float GUARD_BAND = 4096.0f;
+
+// Edge values at a row start are clamped to this, a row of a tile never steps further
+static const int64_t EDGE_CLAMP = 1 << 30;
+
+// Setup work per chunk, below this splitting costs more than it saves
+static const int CHUNK_MIN_TRIANGLES = 256;
+
+enum TriangleFlags
+{
+    FLAT_COLOR = 1 << 0, // Same color on all vertices
+    FLAT_UV = 1 << 1,    // Same uv on all vertices (ImGui's white pixel for untextured shapes)
+};
+
+struct SoftwareRenderer::Batch
+{
+    const ImDrawVert* Vertices;
+    const ImDrawIdx* Indices;
+    int FirstTriangle;
+    int TriangleCount;
+    int ClipMinX, ClipMinY, ClipMaxX, ClipMaxY; // Framebuffer pixels, max exclusive
+    const MemoryTexture* Texture;               // nullptr samples white
+    ImVec2 Offset;                              // Display to framebuffer pixels
+    ImVec2 Scale;
+};
+
+struct SoftwareRenderer::Triangle
+{
+    int MinX, MinY, MaxX, MaxY; // Covered pixels, inclusive
+    int64_t E0[3];              // Edge functions at the center of pixel (0, 0), fill rule included
+    int32_t EA[3];              // Edge steps per pixel in x
+    int32_t EB[3];              // and in y
+    float Planes[6][3];         // R G B A U V: value at pixel (0, 0), step in x, step in y
+    ImU32 Color;                // Vertex color when FLAT_COLOR, the final color if FLAT_UV too
+    ImU32 Texel;                // Sampled color when FLAT_UV
+    int Flags;
+    const MemoryTexture* Texture;
+};
+
+// ---- Pixel math ----
+
+// x / 255 rounded, exact for x <= 255 * 255
+static inline __m128i Div255(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Channel-wise a * b / 255 of 4 RGBA8 pixels
+static inline __m128i Modulate(__m128i a, __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+    __m128i hi = Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+    return _mm_packus_epi16(lo, hi);
+}
+
+// Two pixels widened to 16 bits: rgb = s * sa + d * (1 - sa), a = sa + da * (1 - sa)
+static inline __m128i BlendWide(__m128i s, __m128i d)
+{
+    const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    __m128i sa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+    __m128i sourceFactor = _mm_or_si128(sa, alphaLanes); // 255 on the alpha channel
+    __m128i destFactor = _mm_sub_epi16(_mm_set1_epi16(255), sa);
+    return Div255(
+        _mm_add_epi16(_mm_mullo_epi16(s, sourceFactor), _mm_mullo_epi16(d, destFactor)));
+}
+
+// Blends 4 source pixels over dst where mask is set
+static inline void BlendOver(ImU32* dst, __m128i src, __m128i mask)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i d = _mm_loadu_si128((const __m128i*)dst);
+    __m128i lo = BlendWide(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(d, zero));
+    __m128i hi = BlendWide(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(d, zero));
+    __m128i blended = _mm_packus_epi16(lo, hi);
+    _mm_storeu_si128((__m128i*)dst,
+                     _mm_or_si128(_mm_and_si128(mask, blended), _mm_andnot_si128(mask, d)));
+}
+
+static inline void StoreMasked(ImU32* dst, __m128i src, __m128i mask)
+{
+    __m128i d = _mm_loadu_si128((const __m128i*)dst);
+    _mm_storeu_si128((__m128i*)dst,
+                     _mm_or_si128(_mm_and_si128(mask, src), _mm_andnot_si128(mask, d)));
+}
+
+// Interpolated 0..255 channels to 4 IM_COL32 pixels
+static inline __m128i PackColor(__m128 r, __m128 g, __m128 b, __m128 a)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    __m128i ri = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(r, zero), max));
+    __m128i gi = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(g, zero), max));
+    __m128i bi = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(b, zero), max));
+    __m128i ai = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(a, zero), max));
+    return _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)),
+                        _mm_or_si128(_mm_slli_epi32(bi, 16), _mm_slli_epi32(ai, 24)));
+}
+
+// a + (b - a) * weight / 256 on all four channels
+static inline ImU32 Lerp(ImU32 a, ImU32 b, ImU32 weight)
+{
+    ImU32 rb = (((a & 0x00FF00FF) * (256 - weight) + (b & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;
+    ImU32 ag = (((a >> 8) & 0x00FF00FF) * (256 - weight) + ((b >> 8) & 0x00FF00FF) * weight) &
+               0xFF00FF00;
+    return rb | ag;
+}
+
+// Bilinear filtering with wrapping, like the DX11 backend's sampler
+static ImU32 Sample(const MemoryTexture* texture, float u, float v)
+{
+    if (!texture)
+        return 0xFFFFFFFF;
+
+    float tu = u * (float)texture->Width - 0.5f;
+    float tv = v * (float)texture->Height - 0.5f;
+    if (!(std::fabs(tu) < 1e6f && std::fabs(tv) < 1e6f))
+        return 0;
+
+    float fu = std::floor(tu);
+    float fv = std::floor(tv);
+    ImU32 wu = (ImU32)((tu - fu) * 256.0f + 0.5f);
+    ImU32 wv = (ImU32)((tv - fv) * 256.0f + 0.5f);
+    int x0 = ((int)fu % texture->Width + texture->Width) % texture->Width;
+    int y0 = ((int)fv % texture->Height + texture->Height) % texture->Height;
+    int x1 = x0 + 1 == texture->Width ? 0 : x0 + 1;
+    int y1 = y0 + 1 == texture->Height ? 0 : y0 + 1;
+
+    const unsigned char* pixels = texture->Pixels.data();
+    auto fetch = [&](int x, int y) {
+        ImU32 texel;
+        memcpy(&texel, pixels + ((size_t)y * texture->Width + x) * 4, 4);
+        return texel;
+    };
+    return Lerp(Lerp(fetch(x0, y0), fetch(x1, y0), wu), Lerp(fetch(x0, y1), fetch(x1, y1), wu),
+                wv);
+}
+
+static ImU32 ModulateOne(ImU32 a, ImU32 b)
+{
+    return (ImU32)_mm_cvtsi128_si32(Modulate(_mm_cvtsi32_si128((int)a), _mm_cvtsi32_si128((int)b)));
+}
+
+// ---- Setup ----
+
+bool SoftwareRenderer::SetupTriangle(const Batch& batch, const ImDrawIdx* indices,
+                                     Triangle& triangle)
+{
+    const ImDrawVert* v[3];
+    int x[3], y[3];
+    for (int i = 0; i < 3; i++)
+    {
+        v[i] = &batch.Vertices[indices[i]];
+        float px = (v[i]->pos.x - batch.Offset.x) * batch.Scale.x;
+        float py = (v[i]->pos.y - batch.Offset.y) * batch.Scale.y;
+        if (!(std::fabs(px) < GUARD_BAND && std::fabs(py) < GUARD_BAND))
+            return false;
+        x[i] = (int)std::lrint(px * SUBPIXEL);
+        y[i] = (int)std::lrint(py * SUBPIXEL);
+    }
+
+    // Counter-clockwise on screen (y down) from here on, ImGui emits both windings
+    int64_t area = (int64_t)(x[1] - x[0]) * (y[2] - y[0]) - (int64_t)(x[2] - x[0]) * (y[1] - y[0]);
+    if (area == 0)
+        return false;
+    if (area < 0)
+    {
+        std::swap(v[1], v[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+    }
+
+    // Pixels whose center is in the bounds, inside the clip rect
+    int minX = std::min({x[0], x[1], x[2]});
+    int maxX = std::max({x[0], x[1], x[2]});
+    int minY = std::min({y[0], y[1], y[2]});
+    int maxY = std::max({y[0], y[1], y[2]});
+    triangle.MinX = std::max((minX - HALF_PIXEL + SUBPIXEL - 1) >> SUBPIXEL_BITS, batch.ClipMinX);
+    triangle.MaxX = std::min((maxX - HALF_PIXEL) >> SUBPIXEL_BITS, batch.ClipMaxX - 1);
+    triangle.MinY = std::max((minY - HALF_PIXEL + SUBPIXEL - 1) >> SUBPIXEL_BITS, batch.ClipMinY);
+    triangle.MaxY = std::min((maxY - HALF_PIXEL) >> SUBPIXEL_BITS, batch.ClipMaxY - 1);
+    if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+        return false;
+
+    // Edge i runs from vertex i to the next, >= 0 inside. A pixel center exactly on an edge
+    // belongs to one side only (the edge's own sign, flipped on the neighbour sharing it), so
+    // translucent meshes are blended once everywhere.
+    for (int i = 0; i < 3; i++)
+    {
+        int j = (i + 1) % 3;
+        int32_t a = y[i] - y[j];
+        int32_t b = x[j] - x[i];
+        int64_t c = -(int64_t)a * x[i] - (int64_t)b * y[i];
+        bool owned = a > 0 || (a == 0 && b > 0);
+        triangle.E0[i] = c + (int64_t)(a + b) * HALF_PIXEL - (owned ? 0 : 1);
+        triangle.EA[i] = a * SUBPIXEL;
+        triangle.EB[i] = b * SUBPIXEL;
+    }
+
+    // Attribute planes on the snapped positions
+    float fx[3], fy[3];
+    for (int i = 0; i < 3; i++)
+    {
+        fx[i] = (float)x[i] / SUBPIXEL;
+        fy[i] = (float)y[i] / SUBPIXEL;
+    }
+    float dx1 = fx[1] - fx[0], dy1 = fy[1] - fy[0];
+    float dx2 = fx[2] - fx[0], dy2 = fy[2] - fy[0];
+    float invArea = 1.0f / (dx1 * dy2 - dx2 * dy1);
+
+    float values[6][3];
+    for (int i = 0; i < 3; i++)
+    {
+        ImU32 col = v[i]->col;
+        values[0][i] = (float)(col & 0xFF);
+        values[1][i] = (float)((col >> 8) & 0xFF);
+        values[2][i] = (float)((col >> 16) & 0xFF);
+        values[3][i] = (float)(col >> 24);
+        values[4][i] = v[i]->uv.x;
+        values[5][i] = v[i]->uv.y;
+    }
+    for (int k = 0; k < 6; k++)
+    {
+        float d1 = values[k][1] - values[k][0];
+        float d2 = values[k][2] - values[k][0];
+        float stepX = (d1 * dy2 - d2 * dy1) * invArea;
+        float stepY = (d2 * dx1 - d1 * dx2) * invArea;
+        triangle.Planes[k][0] = values[k][0] + stepX * (0.5f - fx[0]) + stepY * (0.5f - fy[0]);
+        triangle.Planes[k][1] = stepX;
+        triangle.Planes[k][2] = stepY;
+    }
+
+    triangle.Flags = 0;
+    triangle.Texture = batch.Texture;
+    if (v[0]->col == v[1]->col && v[0]->col == v[2]->col)
+    {
+        triangle.Flags |= FLAT_COLOR;
+        triangle.Color = v[0]->col;
+    }
+    if (v[0]->uv.x == v[1]->uv.x && v[0]->uv.x == v[2]->uv.x && v[0]->uv.y == v[1]->uv.y &&
+        v[0]->uv.y == v[2]->uv.y)
+    {
+        triangle.Flags |= FLAT_UV;
+        triangle.Texel = Sample(batch.Texture, v[0]->uv.x, v[0]->uv.y);
+    }
+    if (triangle.Flags == (FLAT_COLOR | FLAT_UV))
+    {
+        triangle.Color = ModulateOne(triangle.Color, triangle.Texel);
+        if ((triangle.Color >> 24) == 0)
+            return false;
+    }
+    return true;
+}
+
+void SoftwareRenderer::SetupChunk(int chunk)
+{
+    int total = (int)m_Triangles.size();
+    int begin = (int)((int64_t)total * chunk / m_ChunkCount);
+    int end = (int)((int64_t)total * (chunk + 1) / m_ChunkCount);
+    std::vector<uint32_t>* bins = &m_Bins[(size_t)chunk * m_TilesX * m_TilesY];
+
+    auto batch =
+        std::upper_bound(m_Batches.begin(), m_Batches.end(), begin,
+                         [](int index, const Batch& b) { return index < b.FirstTriangle; });
+    --batch;
+    for (int i = begin; i < end; i++)
+    {
+        while (i >= batch->FirstTriangle + batch->TriangleCount)
+            ++batch;
+
+        Triangle& triangle = m_Triangles[i];
+        const ImDrawIdx* indices = batch->Indices + (size_t)(i - batch->FirstTriangle) * 3;
+        if (!SetupTriangle(*batch, indices, triangle))
+            continue;
+
+        int tileMinX = triangle.MinX / TILE_SIZE, tileMaxX = triangle.MaxX / TILE_SIZE;
+        int tileMinY = triangle.MinY / TILE_SIZE, tileMaxY = triangle.MaxY / TILE_SIZE;
+        for (int ty = tileMinY; ty <= tileMaxY; ty++)
+        {
+            for (int tx = tileMinX; tx <= tileMaxX; tx++)
+                bins[ty * m_TilesX + tx].push_back((uint32_t)i);
+        }
+    }
+}
+
+// ---- Rasterization ----
+
+void SoftwareRenderer::DrawTriangle(const Triangle& triangle, ImU32* pixels, int pitch,
+                                    int clipMinX, int clipMinY, int clipMaxX, int clipMaxY)
+{
+    int minX = std::max(triangle.MinX, clipMinX);
+    int maxX = std::min(triangle.MaxX, clipMaxX);
+    int minY = std::max(triangle.MinY, clipMinY);
+    int maxY = std::min(triangle.MaxY, clipMaxY);
+    if (minX > maxX || minY > maxY)
+        return;
+
+    // Groups of 4 pixels aligned on 4, the pitch is padded so the last one stays in the row
+    int startX = minX & ~3;
+    const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i firstX = _mm_set1_epi32(minX - 1);
+    const __m128i lastX = _mm_set1_epi32(maxX + 1);
+    const __m128i minusOne = _mm_set1_epi32(-1);
+
+    __m128i laneSteps[3], groupSteps[3];
+    for (int i = 0; i < 3; i++)
+    {
+        int32_t step = triangle.EA[i];
+        laneSteps[i] = _mm_setr_epi32(0, step, step * 2, step * 3);
+        groupSteps[i] = _mm_set1_epi32(step * 4);
+    }
+
+    const bool flat = triangle.Flags == (FLAT_COLOR | FLAT_UV);
+    const bool opaque = flat && (triangle.Color >> 24) == 255;
+    const __m128i flatColor = _mm_set1_epi32((int)triangle.Color);
+    const __m128i flatTexel = _mm_set1_epi32((int)triangle.Texel);
+    const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+    // Planes that vary: R G B A unless the color is flat, U V unless the uv is
+    const int firstPlane = (triangle.Flags & FLAT_COLOR) ? 4 : 0;
+    const int endPlane = (triangle.Flags & FLAT_UV) ? 4 : 6;
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        ImU32* row = pixels + (size_t)y * pitch;
+
+        __m128i edges[3];
+        for (int i = 0; i < 3; i++)
+        {
+            int64_t e = triangle.E0[i] + (int64_t)triangle.EA[i] * startX +
+                        (int64_t)triangle.EB[i] * y;
+            e = std::clamp(e, -EDGE_CLAMP, EDGE_CLAMP);
+            edges[i] = _mm_add_epi32(_mm_set1_epi32((int32_t)e), laneSteps[i]);
+        }
+
+        __m128 planes[6], planeSteps[6];
+        for (int k = firstPlane; k < endPlane; k++)
+        {
+            const float* plane = triangle.Planes[k];
+            float value = plane[0] + plane[1] * (float)startX + plane[2] * (float)y;
+            planes[k] =
+                _mm_add_ps(_mm_set1_ps(value), _mm_mul_ps(_mm_set1_ps(plane[1]), laneOffsets));
+            planeSteps[k] = _mm_set1_ps(plane[1] * 4.0f);
+        }
+
+        for (int x = startX; x <= maxX; x += 4)
+        {
+            __m128i xs = _mm_add_epi32(_mm_set1_epi32(x), lanes);
+            __m128i mask = _mm_and_si128(_mm_cmpgt_epi32(xs, firstX), _mm_cmplt_epi32(xs, lastX));
+            __m128i inside = _mm_or_si128(edges[0], _mm_or_si128(edges[1], edges[2]));
+            mask = _mm_and_si128(mask, _mm_cmpgt_epi32(inside, minusOne));
+
+            if (_mm_movemask_epi8(mask) != 0)
+            {
+                if (opaque)
+                {
+                    StoreMasked(row + x, flatColor, mask);
+                }
+                else if (flat)
+                {
+                    BlendOver(row + x, flatColor, mask);
+                }
+                else
+                {
+                    __m128i color = (triangle.Flags & FLAT_COLOR)
+                                        ? flatColor
+                                        : PackColor(planes[0], planes[1], planes[2], planes[3]);
+                    __m128i texel = flatTexel;
+                    if (!(triangle.Flags & FLAT_UV))
+                    {
+                        alignas(16) float u[4], v[4];
+                        alignas(16) ImU32 texels[4];
+                        _mm_store_ps(u, planes[4]);
+                        _mm_store_ps(v, planes[5]);
+                        for (int lane = 0; lane < 4; lane++)
+                            texels[lane] = Sample(triangle.Texture, u[lane], v[lane]);
+                        texel = _mm_load_si128((const __m128i*)texels);
+                    }
+                    BlendOver(row + x, Modulate(color, texel), mask);
+                }
+            }
+
+            for (int i = 0; i < 3; i++)
+                edges[i] = _mm_add_epi32(edges[i], groupSteps[i]);
+            for (int k = firstPlane; k < endPlane; k++)
+                planes[k] = _mm_add_ps(planes[k], planeSteps[k]);
+        }
+    }
+}
+
+void SoftwareRenderer::RasterizeTile(int tile)
+{
+    int minX = (tile % m_TilesX) * TILE_SIZE;
+    int minY = (tile / m_TilesX) * TILE_SIZE;
+    int maxX = std::min(minX + TILE_SIZE, m_Width) - 1;
+    int maxY = std::min(minY + TILE_SIZE, m_Height) - 1;
+
+    // Padding columns are cleared with the last tile of the row
+    int clearEnd = std::min(minX + TILE_SIZE, m_Pitch);
+    for (int y = minY; y <= maxY; y++)
+    {
+        ImU32* row = &m_Pixels[(size_t)y * m_Pitch];
+        std::fill(row + minX, row + clearEnd, m_ClearColor);
+    }
+
+    // Chunks hold consecutive triangles, so this is submission order
+    size_t tileCount = (size_t)m_TilesX * m_TilesY;
+    for (int chunk = 0; chunk < m_ChunkCount; chunk++)
+    {
+        for (uint32_t index : m_Bins[chunk * tileCount + tile])
+        {
+            DrawTriangle(m_Triangles[index], m_Pixels.data(), m_Pitch, minX, minY, maxX, maxY);
+        }
+    }
+}
+
+// ---- Frame ----
+
+SoftwareRenderer::SoftwareRenderer(MemoryTextureFactory& textures, int threads)
+    : m_Textures(textures)
+{
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    m_ThreadCount = std::clamp(threads, 1, MAX_THREADS);
+    for (int i = 1; i < m_ThreadCount; i++)
+        m_Workers.emplace_back(&SoftwareRenderer::WorkerLoop, this);
+}
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_all();
+    for (auto& worker : m_Workers)
+        worker.join();
+}
+
+void SoftwareRenderer::Init()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererUserData = this;
+    io.BackendRendererName = "69_software";
+    io.BackendFlags |=
+        ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures;
+}
+
+void SoftwareRenderer::Shutdown()
+{
+    for (ImTextureData* texture : ImGui::GetPlatformIO().Textures)
+    {
+        if (texture->RefCount != 1 || texture->TexID == ImTextureID_Invalid)
+            continue;
+        m_Textures.DestroyTexture(texture->TexID);
+        texture->SetTexID(ImTextureID_Invalid);
+        texture->SetStatus(ImTextureStatus_Destroyed);
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererUserData = nullptr;
+    io.BackendRendererName = nullptr;
+    io.BackendFlags &=
+        ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+}
+
+// Block of an ImGui texture as RGBA, Alpha8 is widened to white
+static const unsigned char* GetRgba(ImTextureData* texture, int x, int y, int width, int height,
+                                    std::vector<unsigned char>& buffer, int& pitch)
+{
+    if (texture->Format == ImTextureFormat_RGBA32)
+    {
+        pitch = texture->GetPitch();
+        return (const unsigned char*)texture->GetPixelsAt(x, y);
+    }
+
+    pitch = width * 4;
+    buffer.resize((size_t)pitch * height);
+    for (int row = 0; row < height; row++)
+    {
+        const unsigned char* alpha = (const unsigned char*)texture->GetPixelsAt(x, y + row);
+        ImU32* out = (ImU32*)&buffer[(size_t)row * pitch];
+        for (int i = 0; i < width; i++)
+            out[i] = 0x00FFFFFF | ((ImU32)alpha[i] << 24);
+    }
+    return buffer.data();
+}
+
+void SoftwareRenderer::UpdateTexture(ImTextureData* texture)
+{
+    std::vector<unsigned char> buffer;
+    int pitch = 0;
+    if (texture->Status == ImTextureStatus_WantCreate)
+    {
+        const unsigned char* pixels =
+            GetRgba(texture, 0, 0, texture->Width, texture->Height, buffer, pitch);
+        texture->SetTexID(m_Textures.CreateTexture(pixels, texture->Width, texture->Height));
+        texture->SetStatus(ImTextureStatus_OK);
+    }
+    else if (texture->Status == ImTextureStatus_WantUpdates)
+    {
+        for (const ImTextureRect& rect : texture->Updates)
+        {
+            const unsigned char* pixels = GetRgba(texture, rect.x, rect.y, rect.w, rect.h, buffer,
+                                                  pitch);
+            m_Textures.UpdateTexture(texture->TexID, rect.x, rect.y, rect.w, rect.h, pixels,
+                                     pitch);
+        }
+        texture->SetStatus(ImTextureStatus_OK);
+    }
+    else if (texture->Status == ImTextureStatus_WantDestroy && texture->UnusedFrames > 0)
+    {
+        m_Textures.DestroyTexture(texture->TexID);
+        texture->SetTexID(ImTextureID_Invalid);
+        texture->SetStatus(ImTextureStatus_Destroyed);
+    }
+}
+
+void SoftwareRenderer::Render(ImDrawData* drawData, ImU32 clearColor)
+{
+    if (drawData->Textures)
+    {
+        for (ImTextureData* texture : *drawData->Textures)
+        {
+            if (texture->Status != ImTextureStatus_OK)
+                UpdateTexture(texture);
+        }
+    }
+
+    // Minimized
+    int width = (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+    int height = (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (width != m_Width || height != m_Height)
+    {
+        m_Width = width;
+        m_Height = height;
+        m_Pitch = (width + 3) & ~3;
+        m_Pixels.assign((size_t)m_Pitch * height, clearColor);
+    }
+    m_ClearColor = clearColor;
+    m_TilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+    // Draw commands as ranges of one list of triangles
+    ImVec2 offset = drawData->DisplayPos;
+    ImVec2 scale = drawData->FramebufferScale;
+    m_Batches.clear();
+    int triangleCount = 0;
+    for (const ImDrawList* list : drawData->CmdLists)
+    {
+        for (const ImDrawCmd& cmd : list->CmdBuffer)
+        {
+            // Callbacks would run before anything is drawn, the menu uses none
+            if (cmd.UserCallback || cmd.ElemCount < 3)
+                continue;
+
+            Batch batch;
+            batch.ClipMinX = std::max((int)((cmd.ClipRect.x - offset.x) * scale.x), 0);
+            batch.ClipMinY = std::max((int)((cmd.ClipRect.y - offset.y) * scale.y), 0);
+            batch.ClipMaxX = std::min((int)((cmd.ClipRect.z - offset.x) * scale.x), width);
+            batch.ClipMaxY = std::min((int)((cmd.ClipRect.w - offset.y) * scale.y), height);
+            if (batch.ClipMinX >= batch.ClipMaxX || batch.ClipMinY >= batch.ClipMaxY)
+                continue;
+
+            batch.Vertices = list->VtxBuffer.Data + cmd.VtxOffset;
+            batch.Indices = list->IdxBuffer.Data + cmd.IdxOffset;
+            batch.FirstTriangle = triangleCount;
+            batch.TriangleCount = (int)cmd.ElemCount / 3;
+            batch.Texture = MemoryTextureFactory::Get(cmd.GetTexID());
+            batch.Offset = offset;
+            batch.Scale = scale;
+            m_Batches.push_back(batch);
+            triangleCount += batch.TriangleCount;
+        }
+    }
+    m_Triangles.resize(triangleCount);
+
+    int tileCount = m_TilesX * m_TilesY;
+    m_ChunkCount = triangleCount == 0 ? 0
+                                      : std::clamp(triangleCount / CHUNK_MIN_TRIANGLES, 1,
+                                                   m_ThreadCount * 4);
+    if (m_Bins.size() < (size_t)m_ChunkCount * tileCount)
+        m_Bins.resize((size_t)m_ChunkCount * tileCount);
+    for (size_t i = 0; i < (size_t)m_ChunkCount * tileCount; i++)
+        m_Bins[i].clear();
+
+    RunParallel(&SoftwareRenderer::SetupChunk, m_ChunkCount);
+    RunParallel(&SoftwareRenderer::RasterizeTile, tileCount);
+}
+
+// ---- Workers ----
+
+void SoftwareRenderer::RunParallel(void (SoftwareRenderer::*job)(int), int count)
+{
+    if (m_Workers.empty() || count <= 1)
+    {
+        for (int i = 0; i < count; i++)
+            (this->*job)(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Job = job;
+        m_ItemCount = count;
+        m_NextItem = 0;
+        m_Running = (int)m_Workers.size();
+        m_Generation++;
+    }
+    m_Wake.notify_all();
+
+    RunItems();
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Done.wait(lock, [this]() { return m_Running == 0; });
+}
+
+void SoftwareRenderer::RunItems()
+{
+    for (int item = m_NextItem++; item < m_ItemCount; item = m_NextItem++)
+        (this->*m_Job)(item);
+}
+
+void SoftwareRenderer::WorkerLoop()
+{
+    uint64_t generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Wake.wait(lock, [&]() { return m_Stop || m_Generation != generation; });
+            if (m_Stop)
+                return;
+            generation = m_Generation;
+        }
+
+        RunItems();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (--m_Running == 0)
+            m_Done.notify_one();
+    }
+}
+
+} // namespace menu
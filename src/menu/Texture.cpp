@@ -0,0 +1,57 @@
+#include "69/menu/Texture.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace menu
+{
+
+using MemoryTexture = MemoryTextureFactory::MemoryTexture;
+
+static auto FindTexture(std::vector<std::unique_ptr<MemoryTexture>>& textures, ImTextureID id)
+{
+    return std::find_if(textures.begin(), textures.end(), [id](const auto& texture) {
+        return (ImTextureID)(size_t)texture.get() == id;
+    });
+}
+
+ImTextureID MemoryTextureFactory::CreateTexture(const unsigned char* pixels, int width,
+                                                int height, int /*mipCount*/)
+{
+    if (!pixels || width <= 0 || height <= 0)
+        return ImTextureID_Invalid;
+
+    auto texture = std::make_unique<MemoryTexture>();
+    texture->Width = width;
+    texture->Height = height;
+    texture->Pixels.assign(pixels, pixels + (size_t)width * height * 4);
+    m_Textures.push_back(std::move(texture));
+    return (ImTextureID)(size_t)m_Textures.back().get();
+}
+
+void MemoryTextureFactory::DestroyTexture(ImTextureID texture)
+{
+    auto it = FindTexture(m_Textures, texture);
+    if (it != m_Textures.end())
+        m_Textures.erase(it);
+}
+
+void MemoryTextureFactory::UpdateTexture(ImTextureID texture, int x, int y, int width,
+                                         int height, const unsigned char* pixels, int pitch)
+{
+    auto it = FindTexture(m_Textures, texture);
+    if (it == m_Textures.end())
+        return;
+
+    MemoryTexture* target = it->get();
+    if (x < 0 || y < 0 || x + width > target->Width || y + height > target->Height)
+        return;
+
+    for (int row = 0; row < height; row++)
+    {
+        memcpy(&target->Pixels[((size_t)(y + row) * target->Width + x) * 4],
+               pixels + (size_t)row * pitch, (size_t)width * 4);
+    }
+}
+
+} // namespace menu
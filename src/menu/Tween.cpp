@@ -0,0 +1,126 @@
+#include "69/menu/Tween.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TWEEN_USE_SSE2
+#endif
+
+namespace menu
+{
+
+// Closer than this to the target snaps onto it
+static const float SETTLE_EPSILON = 0.001f;
+
+Tween TweenSet::Add(float value)
+{
+    Tween tween;
+    tween.Index = m_Count++;
+
+    // Grow by a whole group of 4
+    if (tween.Index == (int)m_Value.size())
+    {
+        size_t size = m_Value.size() + 4;
+        m_Value.resize(size, 0.0f);
+        m_Target.resize(size, 0.0f);
+        m_Rate.resize(size, 0.0f);
+        m_Speed.resize(size, 0.0f);
+    }
+
+    Set(tween, value);
+    return tween;
+}
+
+void TweenSet::SmoothTo(Tween tween, float target, float rate)
+{
+    m_Target[tween.Index] = target;
+    m_Rate[tween.Index] = rate;
+    m_Speed[tween.Index] = 0.0f;
+    if (m_Value[tween.Index] != target)
+        m_Animating = true;
+}
+
+void TweenSet::MoveTo(Tween tween, float target, float speed)
+{
+    m_Target[tween.Index] = target;
+    m_Rate[tween.Index] = 0.0f;
+    m_Speed[tween.Index] = speed;
+    if (m_Value[tween.Index] != target)
+        m_Animating = true;
+}
+
+void TweenSet::Set(Tween tween, float value)
+{
+    m_Value[tween.Index] = value;
+    m_Target[tween.Index] = value;
+}
+
+void TweenSet::Update(float deltaTime)
+{
+    // exp(-x) ~ 1 / (1 + x + x^2/2 + x^3/6): stays in (0, 1] and never overshoots for big steps
+    int size = (int)m_Value.size();
+    int i = 0;
+    bool animating = false;
+
+#ifdef TWEEN_USE_SSE2
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sixth = _mm_set1_ps(1.0f / 6.0f);
+    const __m128 epsilon = _mm_set1_ps(SETTLE_EPSILON);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 allBits = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    __m128 moving = _mm_setzero_ps();
+
+    for (; i + 4 <= size; i += 4)
+    {
+        __m128 value = _mm_loadu_ps(&m_Value[i]);
+        __m128 target = _mm_loadu_ps(&m_Target[i]);
+        __m128 x = _mm_mul_ps(_mm_loadu_ps(&m_Rate[i]), dt);
+        __m128 step = _mm_mul_ps(_mm_loadu_ps(&m_Speed[i]), dt);
+
+        // Exponential part
+        __m128 poly = _mm_add_ps(half, _mm_mul_ps(x, sixth));
+        poly = _mm_add_ps(one, _mm_mul_ps(x, poly));
+        poly = _mm_add_ps(one, _mm_mul_ps(x, poly));
+        __m128 decay = _mm_div_ps(one, poly);
+        value = _mm_add_ps(value, _mm_mul_ps(_mm_sub_ps(target, value), _mm_sub_ps(one, decay)));
+
+        // Constant speed part
+        __m128 delta = _mm_sub_ps(target, value);
+        delta = _mm_min_ps(_mm_max_ps(delta, _mm_xor_ps(step, signMask)), step);
+        value = _mm_add_ps(value, delta);
+
+        // Snap when close enough
+        __m128 distance = _mm_andnot_ps(signMask, _mm_sub_ps(target, value));
+        __m128 settled = _mm_cmplt_ps(distance, epsilon);
+        value = _mm_or_ps(_mm_and_ps(settled, target), _mm_andnot_ps(settled, value));
+        moving = _mm_or_ps(moving, _mm_andnot_ps(settled, allBits));
+
+        _mm_storeu_ps(&m_Value[i], value);
+    }
+    animating = _mm_movemask_ps(moving) != 0;
+#endif
+
+    for (; i < size; i++)
+    {
+        float x = m_Rate[i] * deltaTime;
+        float decay = 1.0f / (1.0f + x * (1.0f + x * (0.5f + x * (1.0f / 6.0f))));
+        float value = m_Value[i] + (m_Target[i] - m_Value[i]) * (1.0f - decay);
+
+        float step = m_Speed[i] * deltaTime;
+        value += std::clamp(m_Target[i] - value, -step, step);
+
+        if (std::fabs(m_Target[i] - value) < SETTLE_EPSILON)
+            value = m_Target[i];
+        else
+            animating = true;
+        m_Value[i] = value;
+    }
+
+    m_Animating = animating;
+}
+
+} // namespace menu
@@ -0,0 +1,40 @@
+#include "69/menu/Win32Platform.h"
+
+#include <windows.h>
+
+namespace menu
+{
+
+void Win32Platform::GetCursorPos(long& x, long& y)
+{
+    POINT cursor = {};
+    ::GetCursorPos(&cursor);
+    x = cursor.x;
+    y = cursor.y;
+}
+
+void Win32Platform::MoveWindow(long dx, long dy)
+{
+    RECT rect;
+    if (!GetWindowRect((HWND)m_Hwnd, &rect))
+        return;
+    SetWindowPos((HWND)m_Hwnd, NULL, rect.left + dx, rect.top + dy, 0, 0,
+                 SWP_NOSIZE | SWP_NOZORDER);
+}
+
+void Win32Platform::Minimize()
+{
+    ShowWindow((HWND)m_Hwnd, SW_MINIMIZE);
+}
+
+void Win32Platform::Quit()
+{
+    PostQuitMessage(0);
+}
+
+void Win32Platform::Log(const char* message)
+{
+    OutputDebugStringA(message);
+}
+
+} // namespace menu
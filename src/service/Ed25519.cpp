@@ -0,0 +1,709 @@
+#include "69/service/Ed25519.h"
+
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace service
+{
+
+// SHA-512 (FIPS 180-4)
+
+static const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static const uint64_t SHA512_INIT[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+static const size_t SHA512_BLOCK_SIZE = 128;
+
+static uint64_t RotateRight(uint64_t x, int n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+class Sha512State
+{
+  public:
+    Sha512State()
+    {
+        memcpy(m_Hash, SHA512_INIT, sizeof(m_Hash));
+    }
+
+    void Update(const void* data, size_t size)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        m_Size += size;
+
+        // Top up a partial block first, then whole blocks straight from the input
+        if (m_Buffered > 0)
+        {
+            size_t space = SHA512_BLOCK_SIZE - m_Buffered;
+            size_t take = size < space ? size : space;
+            memcpy(m_Buffer + m_Buffered, bytes, take);
+            m_Buffered += take;
+            bytes += take;
+            size -= take;
+            if (m_Buffered < SHA512_BLOCK_SIZE)
+                return;
+            Compress(m_Buffer);
+            m_Buffered = 0;
+        }
+
+        for (; size >= SHA512_BLOCK_SIZE; bytes += SHA512_BLOCK_SIZE, size -= SHA512_BLOCK_SIZE)
+            Compress(bytes);
+
+        memcpy(m_Buffer, bytes, size);
+        m_Buffered = size;
+    }
+
+    void Final(uint8_t digest[SHA512_SIZE])
+    {
+        // 0x80, zeros, then the length in bits as a 128-bit big endian number
+        uint64_t bits = (uint64_t)m_Size * 8;
+        uint64_t bitsHigh = (uint64_t)m_Size >> 61;
+        uint8_t padding[SHA512_BLOCK_SIZE * 2] = {0x80};
+        size_t paddingSize = (m_Buffered < 112 ? 112 : 240) - m_Buffered;
+        for (int i = 0; i < 8; i++)
+        {
+            padding[paddingSize + i] = (uint8_t)(bitsHigh >> (56 - i * 8));
+            padding[paddingSize + 8 + i] = (uint8_t)(bits >> (56 - i * 8));
+        }
+        Update(padding, paddingSize + 16);
+
+        for (int i = 0; i < 64; i++)
+            digest[i] = (uint8_t)(m_Hash[i / 8] >> (56 - (i % 8) * 8));
+    }
+
+  private:
+    void Compress(const uint8_t block[SHA512_BLOCK_SIZE])
+    {
+        uint64_t w[80];
+        for (int i = 0; i < 16; i++)
+        {
+            w[i] = 0;
+            for (int j = 0; j < 8; j++)
+                w[i] = (w[i] << 8) | block[i * 8 + j];
+        }
+        for (int i = 16; i < 80; i++)
+        {
+            uint64_t s0 = RotateRight(w[i - 15], 1) ^ RotateRight(w[i - 15], 8) ^ (w[i - 15] >> 7);
+            uint64_t s1 = RotateRight(w[i - 2], 19) ^ RotateRight(w[i - 2], 61) ^ (w[i - 2] >> 6);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        // a b c d e f g h
+        uint64_t v[8];
+        memcpy(v, m_Hash, sizeof(v));
+        for (int i = 0; i < 80; i++)
+        {
+            uint64_t s1 = RotateRight(v[4], 14) ^ RotateRight(v[4], 18) ^ RotateRight(v[4], 41);
+            uint64_t ch = (v[4] & v[5]) ^ (~v[4] & v[6]);
+            uint64_t t1 = v[7] + s1 + ch + SHA512_K[i] + w[i];
+            uint64_t s0 = RotateRight(v[0], 28) ^ RotateRight(v[0], 34) ^ RotateRight(v[0], 39);
+            uint64_t maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+
+            memmove(v + 1, v, 7 * sizeof(uint64_t));
+            v[4] += t1;
+            v[0] = t1 + s0 + maj;
+        }
+
+        for (int i = 0; i < 8; i++)
+            m_Hash[i] += v[i];
+    }
+
+    uint64_t m_Hash[8];
+    uint8_t m_Buffer[SHA512_BLOCK_SIZE];
+    size_t m_Buffered = 0;
+    unsigned long long m_Size = 0;
+};
+
+void Sha512(const void* data, size_t size, uint8_t digest[SHA512_SIZE])
+{
+    Sha512State state;
+    state.Update(data, size);
+    state.Final(digest);
+}
+
+void HmacSha512(const void* key, size_t keySize, const void* data, size_t size,
+                uint8_t digest[SHA512_SIZE])
+{
+    // A key longer than a block is hashed first, then zero padded to one block
+    uint8_t block[SHA512_BLOCK_SIZE] = {};
+    if (keySize > SHA512_BLOCK_SIZE)
+        Sha512(key, keySize, block);
+    else if (keySize > 0)
+        memcpy(block, key, keySize);
+
+    uint8_t pad[SHA512_BLOCK_SIZE];
+    for (size_t i = 0; i < SHA512_BLOCK_SIZE; i++)
+        pad[i] = block[i] ^ 0x36;
+    uint8_t inner[SHA512_SIZE];
+    Sha512State innerState;
+    innerState.Update(pad, sizeof(pad));
+    innerState.Update(data, size);
+    innerState.Final(inner);
+
+    for (size_t i = 0; i < SHA512_BLOCK_SIZE; i++)
+        pad[i] = block[i] ^ 0x5c;
+    Sha512State outerState;
+    outerState.Update(pad, sizeof(pad));
+    outerState.Update(inner, sizeof(inner));
+    outerState.Final(digest);
+}
+
+// 64 x 64 -> 128 bit products for the field multiply
+struct Wide
+{
+    uint64_t Low;
+    uint64_t High;
+};
+
+static Wide MulWide(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    return {(uint64_t)product, (uint64_t)(product >> 64)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+    Wide product;
+    product.Low = _umul128(a, b, &product.High);
+    return product;
+#else
+    // Four 32 x 32 products on 32-bit builds
+    uint64_t low = (a & 0xffffffff) * (b & 0xffffffff);
+    uint64_t middle1 = (a >> 32) * (b & 0xffffffff);
+    uint64_t middle2 = (a & 0xffffffff) * (b >> 32);
+    uint64_t high = (a >> 32) * (b >> 32);
+    uint64_t middle = (low >> 32) + (middle1 & 0xffffffff) + (middle2 & 0xffffffff);
+    return {(middle << 32) | (low & 0xffffffff),
+            high + (middle1 >> 32) + (middle2 >> 32) + (middle >> 32)};
+#endif
+}
+
+static void AddWide(Wide& sum, Wide x)
+{
+    sum.Low += x.Low;
+    sum.High += x.High + (sum.Low < x.Low ? 1 : 0);
+}
+
+// Field arithmetic mod p = 2^255 - 19, five unsigned limbs of 51 bits.
+// Limbs are kept within a few units of 51 bits, so sums of five products fit in 128 bits
+// and the top carry times 19 fits in 64.
+
+struct Fe
+{
+    uint64_t V[5];
+};
+
+static const uint64_t LIMB_MASK = ((uint64_t)1 << 51) - 1;
+
+static Fe MakeFe(uint64_t small)
+{
+    return {{small, 0, 0, 0, 0}};
+}
+
+// Limbs back to about 51 bits, the overflow of the top one wraps around times 19.
+// Carries are taken from every limb at once rather than rippled, the result may sit a few
+// units above 2^51 which the products leave room for.
+static void Carry(Fe& h)
+{
+    uint64_t carries[5];
+    for (int i = 0; i < 5; i++)
+        carries[i] = h.V[i] >> 51;
+
+    h.V[0] = (h.V[0] & LIMB_MASK) + 19 * carries[4];
+    for (int i = 1; i < 5; i++)
+        h.V[i] = (h.V[i] & LIMB_MASK) + carries[i - 1];
+}
+
+static Fe Add(const Fe& a, const Fe& b)
+{
+    Fe h;
+    for (int i = 0; i < 5; i++)
+        h.V[i] = a.V[i] + b.V[i];
+    Carry(h);
+    return h;
+}
+
+// Plus 2p first, so limbs never go below zero
+static Fe Sub(const Fe& a, const Fe& b)
+{
+    Fe h;
+    h.V[0] = a.V[0] + 2 * (LIMB_MASK - 18) - b.V[0];
+    for (int i = 1; i < 5; i++)
+        h.V[i] = a.V[i] + 2 * LIMB_MASK - b.V[i];
+    Carry(h);
+    return h;
+}
+
+static Fe Neg(const Fe& a)
+{
+    return Sub(MakeFe(0), a);
+}
+
+static Fe Reduce(Wide t[5])
+{
+    Fe h;
+    uint64_t carry = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        AddWide(t[i], {carry, 0});
+        h.V[i] = t[i].Low & LIMB_MASK;
+        carry = (t[i].Low >> 51) | (t[i].High << 13);
+    }
+    h.V[0] += 19 * carry;
+    h.V[1] += h.V[0] >> 51;
+    h.V[0] &= LIMB_MASK;
+    return h;
+}
+
+static Fe Mul(const Fe& a, const Fe& b)
+{
+    // Products reaching 2^255 and above come back times 19
+    uint64_t b1 = 19 * b.V[1], b2 = 19 * b.V[2], b3 = 19 * b.V[3], b4 = 19 * b.V[4];
+
+    Wide t[5];
+    t[0] = MulWide(a.V[0], b.V[0]);
+    AddWide(t[0], MulWide(a.V[1], b4));
+    AddWide(t[0], MulWide(a.V[2], b3));
+    AddWide(t[0], MulWide(a.V[3], b2));
+    AddWide(t[0], MulWide(a.V[4], b1));
+
+    t[1] = MulWide(a.V[0], b.V[1]);
+    AddWide(t[1], MulWide(a.V[1], b.V[0]));
+    AddWide(t[1], MulWide(a.V[2], b4));
+    AddWide(t[1], MulWide(a.V[3], b3));
+    AddWide(t[1], MulWide(a.V[4], b2));
+
+    t[2] = MulWide(a.V[0], b.V[2]);
+    AddWide(t[2], MulWide(a.V[1], b.V[1]));
+    AddWide(t[2], MulWide(a.V[2], b.V[0]));
+    AddWide(t[2], MulWide(a.V[3], b4));
+    AddWide(t[2], MulWide(a.V[4], b3));
+
+    t[3] = MulWide(a.V[0], b.V[3]);
+    AddWide(t[3], MulWide(a.V[1], b.V[2]));
+    AddWide(t[3], MulWide(a.V[2], b.V[1]));
+    AddWide(t[3], MulWide(a.V[3], b.V[0]));
+    AddWide(t[3], MulWide(a.V[4], b4));
+
+    t[4] = MulWide(a.V[0], b.V[4]);
+    AddWide(t[4], MulWide(a.V[1], b.V[3]));
+    AddWide(t[4], MulWide(a.V[2], b.V[2]));
+    AddWide(t[4], MulWide(a.V[3], b.V[1]));
+    AddWide(t[4], MulWide(a.V[4], b.V[0]));
+
+    return Reduce(t);
+}
+
+// Mul(a, a) with the symmetric products counted once
+static Fe Square(const Fe& a)
+{
+    uint64_t a0Twice = 2 * a.V[0], a1Twice = 2 * a.V[1], a2Twice = 2 * a.V[2];
+    uint64_t a3Twice = 2 * a.V[3];
+    uint64_t a3Wrap = 19 * a.V[3], a4Wrap = 19 * a.V[4];
+
+    Wide t[5];
+    t[0] = MulWide(a.V[0], a.V[0]);
+    AddWide(t[0], MulWide(a1Twice, a4Wrap));
+    AddWide(t[0], MulWide(a2Twice, a3Wrap));
+
+    t[1] = MulWide(a0Twice, a.V[1]);
+    AddWide(t[1], MulWide(a2Twice, a4Wrap));
+    AddWide(t[1], MulWide(a.V[3], a3Wrap));
+
+    t[2] = MulWide(a0Twice, a.V[2]);
+    AddWide(t[2], MulWide(a.V[1], a.V[1]));
+    AddWide(t[2], MulWide(a3Twice, a4Wrap));
+
+    t[3] = MulWide(a0Twice, a.V[3]);
+    AddWide(t[3], MulWide(a1Twice, a.V[2]));
+    AddWide(t[3], MulWide(a.V[4], a4Wrap));
+
+    t[4] = MulWide(a0Twice, a.V[4]);
+    AddWide(t[4], MulWide(a1Twice, a.V[3]));
+    AddWide(t[4], MulWide(a.V[2], a.V[2]));
+
+    return Reduce(t);
+}
+
+// a^(2^count)
+static Fe SquareTimes(Fe a, int count)
+{
+    for (int i = 0; i < count; i++)
+        a = Square(a);
+    return a;
+}
+
+// a^(2^250 - 1), the common start of the exponents below, and a^11 on the way
+static Fe Pow2250Minus1(const Fe& a, Fe& a11)
+{
+    Fe a2 = Square(a);
+    Fe a9 = Mul(SquareTimes(a2, 2), a);
+    a11 = Mul(a9, a2);
+    Fe t5 = Mul(Square(a11), a9); // 2^5 - 1
+    Fe t10 = Mul(SquareTimes(t5, 5), t5);
+    Fe t20 = Mul(SquareTimes(t10, 10), t10);
+    Fe t40 = Mul(SquareTimes(t20, 20), t20);
+    Fe t50 = Mul(SquareTimes(t40, 10), t10);
+    Fe t100 = Mul(SquareTimes(t50, 50), t50);
+    Fe t200 = Mul(SquareTimes(t100, 100), t100);
+    return Mul(SquareTimes(t200, 50), t50);
+}
+
+// a^(p - 2)
+static Fe Invert(const Fe& a)
+{
+    Fe a11;
+    Fe t250 = Pow2250Minus1(a, a11);
+    return Mul(SquareTimes(t250, 5), a11);
+}
+
+// a^((p - 5) / 8), for square roots
+static Fe Pow22523(const Fe& a)
+{
+    Fe a11;
+    Fe t250 = Pow2250Minus1(a, a11);
+    return Mul(SquareTimes(t250, 2), a);
+}
+
+static uint64_t Load64(const uint8_t bytes[8])
+{
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--)
+        value = (value << 8) | bytes[i];
+    return value;
+}
+
+// Low 255 bits, the top one is left to the caller
+static Fe FromBytes(const uint8_t bytes[32])
+{
+    uint64_t w0 = Load64(bytes), w1 = Load64(bytes + 8), w2 = Load64(bytes + 16);
+    uint64_t w3 = Load64(bytes + 24);
+    return {{w0 & LIMB_MASK, ((w0 >> 51) | (w1 << 13)) & LIMB_MASK,
+             ((w1 >> 38) | (w2 << 26)) & LIMB_MASK, ((w2 >> 25) | (w3 << 39)) & LIMB_MASK,
+             (w3 >> 12) & LIMB_MASK}};
+}
+
+// Canonical encoding, the value fully reduced below p
+static void ToBytes(uint8_t bytes[32], Fe h)
+{
+    // Every limb within 51 bits, the value is then below 2^255
+    uint64_t carry;
+    do
+    {
+        carry = 0;
+        for (int i = 0; i < 5; i++)
+        {
+            h.V[i] += carry;
+            carry = h.V[i] >> 51;
+            h.V[i] &= LIMB_MASK;
+        }
+        h.V[0] += 19 * carry;
+    } while (carry != 0);
+
+    // q = 1 when h >= p, that is when h + 19 reaches 2^255
+    uint64_t q = (h.V[0] + 19) >> 51;
+    for (int i = 1; i < 5; i++)
+        q = (h.V[i] + q) >> 51;
+
+    // h - q * p, dropping the 2^255
+    h.V[0] += 19 * q;
+    for (int i = 0; i < 4; i++)
+    {
+        h.V[i + 1] += h.V[i] >> 51;
+        h.V[i] &= LIMB_MASK;
+    }
+    h.V[4] &= LIMB_MASK;
+
+    uint64_t words[4] = {h.V[0] | (h.V[1] << 51), (h.V[1] >> 13) | (h.V[2] << 38),
+                         (h.V[2] >> 26) | (h.V[3] << 25), (h.V[3] >> 39) | (h.V[4] << 12)};
+    for (int i = 0; i < 32; i++)
+        bytes[i] = (uint8_t)(words[i / 8] >> ((i % 8) * 8));
+}
+
+static bool IsEqual(const Fe& a, const Fe& b)
+{
+    uint8_t bytesA[32], bytesB[32];
+    ToBytes(bytesA, a);
+    ToBytes(bytesB, b);
+    return memcmp(bytesA, bytesB, 32) == 0;
+}
+
+static bool IsNegative(const Fe& a)
+{
+    uint8_t bytes[32];
+    ToBytes(bytes, a);
+    return bytes[0] & 1;
+}
+
+// Points of -x^2 + y^2 = 1 + d x^2 y^2 in extended coordinates, x = X/Z, y = Y/Z, xy = T/Z
+
+struct Point
+{
+    Fe X, Y, Z, T;
+};
+
+// Multiples 0 to 15 of a point, for 4-bit windows
+struct PointTable
+{
+    Point Multiples[16];
+};
+
+struct CurveConstants
+{
+    Fe D;
+    Fe D2;     // 2d
+    Fe SqrtM1; // sqrt(-1)
+    PointTable Base;
+};
+
+static const Point IDENTITY = {{{0}}, {{1}}, {{1}}, {{0}}};
+
+static Point AddPoints(const Point& p, const Point& q, const Fe& d2)
+{
+    Fe a = Mul(Sub(p.Y, p.X), Sub(q.Y, q.X));
+    Fe b = Mul(Add(p.Y, p.X), Add(q.Y, q.X));
+    Fe c = Mul(Mul(p.T, d2), q.T);
+    Fe d = Mul(Add(p.Z, p.Z), q.Z);
+    Fe e = Sub(b, a);
+    Fe f = Sub(d, c);
+    Fe g = Add(d, c);
+    Fe h = Add(b, a);
+    return {Mul(e, f), Mul(g, h), Mul(f, g), Mul(e, h)};
+}
+
+// T is only needed when an addition follows, doubling doesn't read it
+static Point DoublePoint(const Point& p, bool withT)
+{
+    Fe a = Square(p.X);
+    Fe b = Square(p.Y);
+    Fe c = Square(p.Z);
+    c = Add(c, c);
+    Fe h = Add(a, b);
+    Fe e = Sub(h, Square(Add(p.X, p.Y)));
+    Fe g = Sub(a, b);
+    Fe f = Add(c, g);
+    return {Mul(e, f), Mul(g, h), Mul(f, g), withT ? Mul(e, h) : Fe()};
+}
+
+static void MakeTable(PointTable& table, const Point& point, const Fe& d2)
+{
+    table.Multiples[0] = IDENTITY;
+    table.Multiples[1] = point;
+    for (int i = 2; i < 16; i++)
+        table.Multiples[i] = AddPoints(table.Multiples[i - 1], point, d2);
+}
+
+// RFC 8032 5.1.3, false for a y not below p or one with no x
+static bool DecodePoint(Point& point, const uint8_t bytes[32], const Fe& d, const Fe& sqrtM1)
+{
+    Fe y = FromBytes(bytes);
+    bool negative = bytes[31] >> 7;
+
+    uint8_t canonical[32];
+    ToBytes(canonical, y);
+    canonical[31] |= bytes[31] & 0x80;
+    if (memcmp(canonical, bytes, 32) != 0)
+        return false;
+
+    // x^2 = u / v
+    Fe y2 = Square(y);
+    Fe u = Sub(y2, MakeFe(1));
+    Fe v = Add(Mul(d, y2), MakeFe(1));
+
+    // x = u v^3 (u v^7)^((p - 5) / 8)
+    Fe v3 = Mul(Square(v), v);
+    Fe uv3 = Mul(u, v3);
+    Fe x = Mul(uv3, Pow22523(Mul(uv3, Mul(v3, v))));
+
+    Fe vx2 = Mul(v, Square(x));
+    if (!IsEqual(vx2, u))
+    {
+        if (!IsEqual(vx2, Neg(u)))
+            return false;
+        x = Mul(x, sqrtM1);
+    }
+
+    uint8_t xBytes[32];
+    ToBytes(xBytes, x);
+    bool zero = true;
+    for (uint8_t b : xBytes)
+        zero = zero && b == 0;
+    if (zero && negative)
+        return false;
+    if ((xBytes[0] & 1) != negative)
+        x = Neg(x);
+
+    point = {x, y, MakeFe(1), Mul(x, y)};
+    return true;
+}
+
+static void EncodePoint(uint8_t bytes[32], const Point& point)
+{
+    Fe zInverse = Invert(point.Z);
+    Fe x = Mul(point.X, zInverse);
+    ToBytes(bytes, Mul(point.Y, zInverse));
+    bytes[31] |= IsNegative(x) ? 0x80 : 0;
+}
+
+static CurveConstants MakeCurveConstants()
+{
+    CurveConstants curve;
+    curve.D = Mul(Neg(MakeFe(121665)), Invert(MakeFe(121666)));
+    curve.D2 = Add(curve.D, curve.D);
+
+    // 2^((p - 1) / 4), that is 2^(2^253 - 5)
+    Fe unused;
+    curve.SqrtM1 = Mul(SquareTimes(Pow2250Minus1(MakeFe(2), unused), 3), MakeFe(8));
+
+    // y = 4/5, positive x
+    uint8_t encoded[32];
+    memset(encoded, 0x66, sizeof(encoded));
+    encoded[0] = 0x58;
+    Point base;
+    DecodePoint(base, encoded, curve.D, curve.SqrtM1);
+    MakeTable(curve.Base, base, curve.D2);
+    return curve;
+}
+
+// Built on first use
+static const CurveConstants& GetCurveConstants()
+{
+    static const CurveConstants curve = MakeCurveConstants();
+    return curve;
+}
+
+// Group order L = 2^252 + 27742317777372353535851937790883648493, little endian
+static const uint8_t ORDER[32] = {0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+                                  0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+                                  0,    0,    0,    0,    0,    0,    0,    0,
+                                  0,    0,    0,    0,    0,    0,    0,    0x10};
+
+static bool IsBelowOrder(const uint8_t scalar[32])
+{
+    for (int i = 31; i >= 0; i--)
+    {
+        if (scalar[i] != ORDER[i])
+            return scalar[i] < ORDER[i];
+    }
+    return false;
+}
+
+// 512-bit hash mod L, one byte per limb: folds the top bytes down with 2^252 = -(L - 2^252)
+static void ReduceScalar(uint8_t scalar[32], const uint8_t hash[64])
+{
+    int64_t x[64];
+    for (int i = 0; i < 64; i++)
+        x[i] = hash[i];
+
+    for (int i = 63; i >= 32; i--)
+    {
+        int64_t carry = 0;
+        int j = i - 32;
+        for (; j < i - 12; j++)
+        {
+            x[j] += carry - 16 * x[i] * ORDER[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    int64_t carry = 0;
+    for (int j = 0; j < 32; j++)
+    {
+        x[j] += carry - (x[31] >> 4) * ORDER[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (int j = 0; j < 32; j++)
+        x[j] -= carry * ORDER[j];
+    for (int i = 0; i < 32; i++)
+    {
+        if (i < 31)
+            x[i + 1] += x[i] >> 8;
+        scalar[i] = (uint8_t)(x[i] & 255);
+    }
+}
+
+static int GetNibble(const uint8_t scalar[32], int index)
+{
+    return (scalar[index / 2] >> ((index & 1) * 4)) & 15;
+}
+
+bool VerifyEd25519(const uint8_t publicKey[ED25519_PUBLIC_KEY_SIZE], const void* message,
+                   size_t size, const uint8_t signature[ED25519_SIGNATURE_SIZE])
+{
+    const CurveConstants& curve = GetCurveConstants();
+
+    const uint8_t* r = signature;
+    const uint8_t* s = signature + 32;
+    if (!IsBelowOrder(s))
+        return false;
+
+    Point a;
+    if (!DecodePoint(a, publicKey, curve.D, curve.SqrtM1))
+        return false;
+
+    // k = SHA-512(R || A || message) mod L
+    uint8_t hash[SHA512_SIZE];
+    Sha512State state;
+    state.Update(r, 32);
+    state.Update(publicKey, ED25519_PUBLIC_KEY_SIZE);
+    state.Update(message, size);
+    state.Final(hash);
+    uint8_t k[32];
+    ReduceScalar(k, hash);
+
+    // [s]B - [k]A, both scalars walked together 4 bits at a time from the top
+    Point minusA = {Neg(a.X), a.Y, a.Z, Neg(a.T)};
+    PointTable minusATable;
+    MakeTable(minusATable, minusA, curve.D2);
+
+    Point sum = IDENTITY;
+    for (int i = 63; i >= 0; i--)
+    {
+        for (int bit = 0; bit < 4; bit++)
+            sum = DoublePoint(sum, bit == 3);
+
+        int sNibble = GetNibble(s, i);
+        int kNibble = GetNibble(k, i);
+        if (sNibble != 0)
+            sum = AddPoints(sum, curve.Base.Multiples[sNibble], curve.D2);
+        if (kNibble != 0)
+            sum = AddPoints(sum, minusATable.Multiples[kNibble], curve.D2);
+    }
+
+    // Has to come out as R itself, so its encoding is compared as is
+    uint8_t encoded[32];
+    EncodePoint(encoded, sum);
+    return memcmp(encoded, r, 32) == 0;
+}
+
+} // namespace service
@@ -0,0 +1,276 @@
+#include "69/service/EndpointPool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace service
+{
+
+// Latency window per endpoint, and how many answers it takes before trusting its p95
+static const int LATENCY_SAMPLES = 32;
+static const int MIN_LATENCY_SAMPLES = 8;
+
+// Hedge delay without enough samples, and the range a measured one is kept in
+static const std::chrono::milliseconds DEFAULT_HEDGE_DELAY(1000);
+static const std::chrono::milliseconds MIN_HEDGE_DELAY(50);
+static const std::chrono::milliseconds MAX_HEDGE_DELAY(3000);
+
+// How often a wait re-checks the token
+static const std::chrono::milliseconds STOP_POLL(50);
+
+// Attempt threads for the whole process: an attempt and its hedge for a login, a launch and a
+// refresh at once, plus room for a couple left hung in a socket
+static const int MAX_ATTEMPT_THREADS = 8;
+
+// Threads attempts run on, kept between requests. Not the Executor: the caller may be one of its
+// workers, and an attempt waiting in its queue behind blocked ones (or run inline) can't be
+// hedged. Grows up to MAX_ATTEMPT_THREADS, a hung attempt keeps its thread until the socket
+// times out. With every thread busy an attempt fails at once instead of queueing.
+// Leaked like the Executor, its threads may be blocked.
+class AttemptThreads
+{
+  public:
+    static AttemptThreads& Get()
+    {
+        static AttemptThreads* threads = new AttemptThreads();
+        return *threads;
+    }
+
+    // False when every thread is busy, the task is dropped
+    bool Run(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Idle <= (int)m_Tasks.size())
+            {
+                if (m_Threads >= MAX_ATTEMPT_THREADS)
+                    return false;
+                m_Threads++;
+                std::thread(&AttemptThreads::WorkerLoop, this).detach();
+            }
+            m_Tasks.push_back(std::move(task));
+        }
+        m_Wake.notify_one();
+        return true;
+    }
+
+  private:
+    void WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Idle++;
+                m_Wake.wait(lock, [this]() { return !m_Tasks.empty(); });
+                m_Idle--;
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex m_Mutex; // Guards everything below
+    std::condition_variable m_Wake;
+    std::deque<std::function<void()>> m_Tasks;
+    int m_Threads = 0;
+    int m_Idle = 0; // Waiting for a task
+};
+
+struct EndpointPool::State
+{
+    struct Latencies
+    {
+        std::vector<float> Samples; // Milliseconds, ring buffer
+        int Next = 0;
+    };
+
+    std::mutex Mutex; // Guards everything below
+    std::vector<Latencies> Endpoints;
+    int Preferred = 0; // Last endpoint that answered
+    std::minstd_rand Random;
+};
+
+// One attempt and its hedge, whichever answers first
+struct EndpointPool::Race
+{
+    std::mutex Mutex; // Guards everything below
+    std::condition_variable Changed;
+    int Running = 0;
+    bool Answered = false;
+    int Winner = -1;
+    HttpResponse Response; // The answer, or the last failure until there is one
+};
+
+// Anything but no answer, a server error or a rate limit is final
+static bool IsAnswer(const HttpResponse& response)
+{
+    return response.Status != 0 && response.Status < 500 && response.Status != 429;
+}
+
+HttpResponse EndpointPool::TimedSend(const std::shared_ptr<State>& state, int endpoint,
+                                     const std::string& url, const SendFn& send)
+{
+    auto start = std::chrono::steady_clock::now();
+    HttpResponse response = send(url);
+    if (!IsAnswer(response))
+        return response;
+
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::lock_guard<std::mutex> lock(state->Mutex);
+    auto& latencies = state->Endpoints[endpoint];
+    if ((int)latencies.Samples.size() < LATENCY_SAMPLES)
+        latencies.Samples.push_back(elapsed.count());
+    else
+        latencies.Samples[latencies.Next] = elapsed.count();
+    latencies.Next = (latencies.Next + 1) % LATENCY_SAMPLES;
+    return response;
+}
+
+EndpointPool::EndpointPool(std::vector<std::string> urls, RetryPolicy policy)
+    : m_Urls(std::move(urls)), m_Policy(policy), m_State(std::make_shared<State>())
+{
+    m_State->Endpoints.resize(m_Urls.size());
+    auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
+    m_State->Random.seed((unsigned int)seed);
+}
+
+std::chrono::milliseconds EndpointPool::GetHedgeDelay(int endpoint) const
+{
+    std::vector<float> samples;
+    {
+        std::lock_guard<std::mutex> lock(m_State->Mutex);
+        samples = m_State->Endpoints[endpoint].Samples;
+    }
+    if ((int)samples.size() < MIN_LATENCY_SAMPLES)
+        return DEFAULT_HEDGE_DELAY;
+
+    auto p95 = samples.begin() + (samples.size() * 95) / 100;
+    std::nth_element(samples.begin(), p95, samples.end());
+    return std::clamp(std::chrono::milliseconds((long long)*p95), MIN_HEDGE_DELAY,
+                      MAX_HEDGE_DELAY);
+}
+
+HttpResponse EndpointPool::Send(const SendFn& send, const CancellationToken& token)
+{
+    HttpResponse response;
+    if (m_Urls.empty())
+        return response;
+
+    int first;
+    {
+        std::lock_guard<std::mutex> lock(m_State->Mutex);
+        first = m_State->Preferred;
+    }
+
+    // Every retry moves on to the next endpoint
+    for (int attempt = 0; attempt < m_Policy.MaxAttempts; attempt++)
+    {
+        if (attempt > 0 && !Backoff(attempt, token))
+            break;
+        if (token.ShouldStop())
+            break;
+
+        response = Attempt((first + attempt) % (int)m_Urls.size(), send, token);
+        if (IsAnswer(response))
+            break;
+    }
+    return response;
+}
+
+// Sleeps before a retry, false if the token stopped meanwhile
+bool EndpointPool::Backoff(int retry, const CancellationToken& token)
+{
+    // Base * 2^(retry - 1), the upper half of it picked at random so clients spread out
+    auto delay = m_Policy.BaseDelay * (1 << std::min(retry - 1, 16));
+    delay = std::min(delay, m_Policy.MaxDelay);
+    {
+        std::lock_guard<std::mutex> lock(m_State->Mutex);
+        std::uniform_int_distribution<long long> jitter(delay.count() / 2, delay.count());
+        delay = std::chrono::milliseconds(jitter(m_State->Random));
+    }
+
+    auto wake = std::chrono::steady_clock::now() + delay;
+    while (std::chrono::steady_clock::now() < wake)
+    {
+        if (token.ShouldStop())
+            return false;
+        std::this_thread::sleep_until(std::min(std::chrono::steady_clock::now() + STOP_POLL, wake));
+    }
+    return !token.ShouldStop();
+}
+
+// Sends on an attempt thread, a hung attempt keeps it and Send returns without it.
+// Without a free thread the attempt fails like one that got no answer.
+void EndpointPool::Launch(const std::shared_ptr<Race>& race, int endpoint, const SendFn& send)
+{
+    {
+        std::lock_guard<std::mutex> lock(race->Mutex);
+        race->Running++;
+    }
+
+    auto task = [state = m_State, race, endpoint, url = m_Urls[endpoint], send]() {
+        HttpResponse response = TimedSend(state, endpoint, url, send);
+
+        std::lock_guard<std::mutex> lock(race->Mutex);
+        race->Running--;
+        if (!race->Answered)
+        {
+            race->Answered = IsAnswer(response);
+            race->Winner = endpoint;
+            race->Response = std::move(response);
+        }
+        race->Changed.notify_all();
+    };
+
+    if (!AttemptThreads::Get().Run(std::move(task)))
+    {
+        std::lock_guard<std::mutex> lock(race->Mutex);
+        race->Running--;
+        race->Changed.notify_all();
+    }
+}
+
+HttpResponse EndpointPool::Attempt(int endpoint, const SendFn& send,
+                                   const CancellationToken& token)
+{
+    auto race = std::make_shared<Race>();
+    Launch(race, endpoint, send);
+
+    // The hedge goes to the next endpoint once this one is slower than it usually is
+    bool hedged = !m_Policy.Hedge || m_Urls.size() < 2;
+    auto hedgeAt = std::chrono::steady_clock::now() + GetHedgeDelay(endpoint);
+
+    std::unique_lock<std::mutex> lock(race->Mutex);
+    while (!race->Answered && race->Running > 0 && !token.ShouldStop())
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (!hedged && now >= hedgeAt)
+        {
+            hedged = true;
+            lock.unlock();
+            Launch(race, (endpoint + 1) % (int)m_Urls.size(), send);
+            lock.lock();
+            continue;
+        }
+
+        auto wake = now + STOP_POLL;
+        race->Changed.wait_until(lock, hedged ? wake : std::min(wake, hedgeAt));
+    }
+
+    // Attempts still out are abandoned, they only hold the race
+    if (!race->Answered)
+        return token.ShouldStop() ? HttpResponse() : race->Response;
+
+    std::lock_guard<std::mutex> stateLock(m_State->Mutex);
+    m_State->Preferred = race->Winner;
+    return race->Response;
+}
+
+} // namespace service
@@ -0,0 +1,55 @@
+#include "69/service/Executor.h"
+
+#include <thread>
+
+namespace service
+{
+
+// Login, launch and a background refresh at once, with one to spare
+static const int WORKER_COUNT = 4;
+static const size_t QUEUE_CAPACITY = 16; // Per priority
+
+Executor& Executor::Get()
+{
+    // Leaked on purpose, destroying it would mean joining workers that may be blocked
+    static Executor* executor = new Executor(WORKER_COUNT, QUEUE_CAPACITY);
+    return *executor;
+}
+
+Executor::Executor(int workers, size_t capacity) : m_Capacity(capacity)
+{
+    for (int i = 0; i < workers; i++)
+        std::thread(&Executor::WorkerLoop, this).detach();
+}
+
+bool Executor::Submit(Priority priority, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto& queue = m_Queues[(int)priority];
+        if (queue.size() >= m_Capacity)
+            return false;
+        queue.push_back(std::move(task));
+    }
+    m_Wake.notify_one();
+    return true;
+}
+
+void Executor::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Wake.wait(lock, [this]() { return !m_Queues[0].empty() || !m_Queues[1].empty(); });
+
+            auto& queue = m_Queues[0].empty() ? m_Queues[1] : m_Queues[0];
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace service
@@ -0,0 +1,203 @@
+#include "69/service/HttpClient.h"
+
+#include "69/service/Metrics.h"
+
+#include <Windows.h>
+#include <chrono>
+#include <winhttp.h>
+
+namespace service
+{
+
+// Connect / send / receive timeouts (ms), resolve is left to the system
+static const int CONNECT_TIMEOUT = 5000;
+static const int SEND_TIMEOUT = 10000;
+static const int RECEIVE_TIMEOUT = 10000;
+
+static std::wstring Widen(const std::string& text)
+{
+    if (text.empty())
+        return std::wstring();
+
+    int length = MultiByteToWideChar(CP_UTF8, 0, text.data(), (int)text.size(), nullptr, 0);
+    std::wstring wide(length, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, text.data(), (int)text.size(), &wide[0], length);
+    return wide;
+}
+
+// When each connection phase started, filled in by OnRequestStatus while the request is
+// being sent. Stays empty for phases a pooled connection skips.
+struct RequestTimes
+{
+    std::chrono::steady_clock::time_point Resolving;
+    std::chrono::steady_clock::time_point Resolved;
+    std::chrono::steady_clock::time_point Connecting;
+    std::chrono::steady_clock::time_point Connected;
+    std::chrono::steady_clock::time_point Sending; // TLS handshake done, if any
+};
+
+static void CALLBACK OnRequestStatus(HINTERNET, DWORD_PTR context, DWORD status, LPVOID, DWORD)
+{
+    RequestTimes* times = (RequestTimes*)context;
+    if (!times)
+        return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (status == WINHTTP_CALLBACK_STATUS_RESOLVING_NAME)
+        times->Resolving = now;
+    else if (status == WINHTTP_CALLBACK_STATUS_NAME_RESOLVED)
+        times->Resolved = now;
+    else if (status == WINHTTP_CALLBACK_STATUS_CONNECTING_TO_SERVER)
+        times->Connecting = now;
+    else if (status == WINHTTP_CALLBACK_STATUS_CONNECTED_TO_SERVER)
+        times->Connected = now;
+    else if (status == WINHTTP_CALLBACK_STATUS_SENDING_REQUEST)
+        times->Sending = now;
+}
+
+static void RecordPhase(Metric metric, std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end)
+{
+    if (start != std::chrono::steady_clock::time_point() && end >= start)
+        Metrics::Record(metric, end - start);
+}
+
+HttpClient::HttpClient()
+{
+    m_Session = WinHttpOpen(L"69-ImGui-Loader", WINHTTP_ACCESS_TYPE_AUTOMATIC_PROXY,
+                            WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+    if (m_Session)
+        WinHttpSetTimeouts(m_Session, 0, CONNECT_TIMEOUT, SEND_TIMEOUT, RECEIVE_TIMEOUT);
+}
+
+HttpClient::~HttpClient()
+{
+    for (auto& connection : m_Connections)
+        WinHttpCloseHandle(connection.second);
+    if (m_Session)
+        WinHttpCloseHandle(m_Session);
+}
+
+void* HttpClient::GetConnection(const std::wstring& host, int port)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    std::wstring key = host + L":" + std::to_wstring(port);
+    auto it = m_Connections.find(key);
+    if (it != m_Connections.end())
+        return it->second;
+
+    HINTERNET connection = WinHttpConnect(m_Session, host.c_str(), (INTERNET_PORT)port, 0);
+    if (connection)
+        m_Connections[key] = connection;
+    return connection;
+}
+
+bool HttpClient::Warm(const std::string& url)
+{
+    // Any answer at all means the connection is up and pooled
+    std::string empty;
+    return Send(L"HEAD", url, nullptr, empty).Status != 0;
+}
+
+HttpResponse HttpClient::Get(const std::string& url)
+{
+    std::string empty;
+    return Send(L"GET", url, nullptr, empty);
+}
+
+HttpResponse HttpClient::Post(const std::string& url, const std::string& body,
+                              const std::string& contentType)
+{
+    return Send(L"POST", url, &body, contentType);
+}
+
+HttpResponse HttpClient::Send(const wchar_t* verb, const std::string& url, const std::string* body,
+                              const std::string& contentType)
+{
+    HttpResponse response;
+    if (!m_Session)
+        return response;
+
+    // Split the URL
+    std::wstring wideUrl = Widen(url);
+    URL_COMPONENTS parts = {};
+    parts.dwStructSize = sizeof(parts);
+    parts.dwHostNameLength = (DWORD)-1;
+    parts.dwUrlPathLength = (DWORD)-1;
+    parts.dwExtraInfoLength = (DWORD)-1;
+    if (!WinHttpCrackUrl(wideUrl.c_str(), (DWORD)wideUrl.size(), 0, &parts))
+        return response;
+
+    std::wstring host(parts.lpszHostName, parts.dwHostNameLength);
+    std::wstring path(parts.lpszUrlPath, parts.dwUrlPathLength);
+    path.append(parts.lpszExtraInfo, parts.dwExtraInfoLength);
+    bool secure = parts.nScheme == INTERNET_SCHEME_HTTPS;
+
+    HINTERNET connection = GetConnection(host, parts.nPort);
+    if (!connection)
+        return response;
+
+    HINTERNET request =
+        WinHttpOpenRequest(connection, verb, path.empty() ? L"/" : path.c_str(), nullptr,
+                           WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES,
+                           secure ? WINHTTP_FLAG_SECURE : 0);
+    if (!request)
+        return response;
+
+    // Phases of a synchronous request are reported on this thread, during the calls below
+    RequestTimes times;
+    WinHttpSetStatusCallback(request, OnRequestStatus,
+                             WINHTTP_CALLBACK_FLAG_RESOLVE_NAME |
+                                 WINHTTP_CALLBACK_FLAG_CONNECT_TO_SERVER |
+                                 WINHTTP_CALLBACK_FLAG_SEND_REQUEST,
+                             0);
+    ScopedLatency total(Metric::HTTP_REQUEST);
+
+    std::wstring headers;
+    if (body)
+        headers = L"Content-Type: " + Widen(contentType);
+
+    void* data = body ? (void*)body->data() : WINHTTP_NO_REQUEST_DATA;
+    DWORD length = body ? (DWORD)body->size() : 0;
+    const wchar_t* extraHeaders = headers.empty() ? WINHTTP_NO_ADDITIONAL_HEADERS : headers.c_str();
+    bool sent = WinHttpSendRequest(request, extraHeaders, (DWORD)headers.size(), data, length,
+                                   length, (DWORD_PTR)&times);
+    auto sentTime = std::chrono::steady_clock::now();
+
+    RecordPhase(Metric::HTTP_DNS, times.Resolving, times.Resolved);
+    RecordPhase(Metric::HTTP_CONNECT, times.Connecting, times.Connected);
+    if (secure)
+        RecordPhase(Metric::HTTP_TLS, times.Connected, times.Sending);
+
+    if (sent && WinHttpReceiveResponse(request, nullptr))
+    {
+        auto headersTime = std::chrono::steady_clock::now();
+        Metrics::Record(Metric::HTTP_WAIT, headersTime - sentTime);
+
+        DWORD status = 0;
+        DWORD statusSize = sizeof(status);
+        WinHttpQueryHeaders(request, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                            WINHTTP_HEADER_NAME_BY_INDEX, &status, &statusSize,
+                            WINHTTP_NO_HEADER_INDEX);
+
+        // Read the whole body, the connection only goes back to the pool once it is drained
+        DWORD available = 0;
+        while (WinHttpQueryDataAvailable(request, &available) && available > 0)
+        {
+            size_t offset = response.Body.size();
+            response.Body.resize(offset + available);
+            DWORD read = 0;
+            if (!WinHttpReadData(request, &response.Body[offset], available, &read))
+                break;
+            response.Body.resize(offset + read);
+        }
+        Metrics::Record(Metric::HTTP_BODY, std::chrono::steady_clock::now() - headersTime);
+        response.Status = (int)status;
+    }
+
+    WinHttpCloseHandle(request);
+    return response;
+}
+
+} // namespace service
@@ -1,42 +1,603 @@
 #include "69/service/KeyauthService.h"
 
+#include "69/service/Ed25519.h"
+#include "69/service/LoginCache.h"
+#include "69/service/Metrics.h"
 #include "keyauth/keyauth.hpp"
 #include "obfuscate/obfuscate.h"
 
 #include <Windows.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sddl.h>
+#include <sstream>
 
 namespace service
 {
 
-bool KeyauthService::ValidateUser(const std::string& licenseKey)
+// Re-init before the server side session could have expired
+static const std::chrono::minutes SESSION_LIFETIME(10);
+
+// How often a call waiting for the session re-checks its token
+static const std::chrono::milliseconds LOCK_POLL(50);
+
+// Guards the token file, written by logins and background checks alike
+static std::mutex g_TokenFileMutex;
+
+// API endpoints in order of preference, a session that can't be opened moves to the next
+static std::vector<std::string> GetApiUrls()
 {
-    // TODO : Your licensing logic
-    KeyAuth::API api(std::string(OBF("Surakarndragon's Application")),
-                     std::string(OBF("mCoqYG4Adm")), std::string(OBF("1.0")),
-                     std::string(OBF("https://keyauth.win/api/1.3/")));
+    // TODO : Your API mirrors
+    return {std::string(OBF("https://keyauth.win/api/1.3/"))};
+}
 
-    api.init();
+static std::vector<std::string> SplitUrls(const std::string& urls)
+{
+    std::vector<std::string> split;
+    size_t start = 0;
+    while (start < urls.size())
+    {
+        size_t end = std::min(urls.find(',', start), urls.size());
+        if (end > start)
+            split.push_back(urls.substr(start, end - start));
+        start = end + 1;
+    }
+    return split;
+}
+
+// App variables the menu needs after login
+static std::vector<std::string> GetRequiredVariables()
+{
+    // TODO : Your app variables
+    return {};
+}
 
-    if (!api.response.success)
+// Ed25519 key the login server signs license tokens with, nullptr while it is all zero.
+// Without a key every login goes to the server.
+static const uint8_t* GetTokenPublicKey()
+{
+    // TODO : Your login server's public key. Not the one scripts/login_server.py prints, its
+    // signing seed is published with it: only put that one here to test against the stand-in.
+    static const uint8_t KEY[ED25519_PUBLIC_KEY_SIZE] = {};
+    for (uint8_t byte : KEY)
+    {
+        if (byte != 0)
+            return KEY;
+    }
+    return nullptr;
+}
+
+// File kept across starts, empty without a local app data folder
+static std::string GetDataPath(const char* name)
+{
+    char folder[MAX_PATH];
+    DWORD length = GetEnvironmentVariableA("LOCALAPPDATA", folder, MAX_PATH);
+    if (length == 0 || length >= MAX_PATH)
+        return std::string();
+
+    std::string path = std::string(folder) + "\\69-ImGui-Loader";
+    CreateDirectoryA(path.c_str(), nullptr);
+    return path + "\\" + name;
+}
+
+// Last license token, see LoginWithToken
+static std::string GetTokenPath()
+{
+    return GetDataPath("license.token");
+}
+
+// Last accepted login, see LoginCache.h
+static std::string GetLoginCachePath()
+{
+    return GetDataPath("login.cache");
+}
+
+// Windows account SID, what KeyAuth identifies a machine by as well
+static std::string ReadHwid()
+{
+    std::string hwid;
+    HANDLE token;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &token))
+        return hwid;
+
+    DWORD size = 0;
+    GetTokenInformation(token, TokenUser, nullptr, 0, &size);
+    std::vector<uint8_t> buffer(size);
+    char* sid = nullptr;
+    if (size > 0 && GetTokenInformation(token, TokenUser, buffer.data(), size, &size) &&
+        ConvertSidToStringSidA(((TOKEN_USER*)buffer.data())->User.Sid, &sid))
+    {
+        hwid = sid;
+        LocalFree(sid);
+    }
+    CloseHandle(token);
+    return hwid;
+}
+
+static const std::string& GetHwid()
+{
+    static const std::string hwid = ReadHwid();
+    return hwid;
+}
+
+static std::string ToHex(const uint8_t* bytes, size_t size)
+{
+    static const char HEX[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < size; i++)
+    {
+        hex += HEX[bytes[i] >> 4];
+        hex += HEX[bytes[i] & 15];
+    }
+    return hex;
+}
+
+static bool FromHex(const std::string& hex, uint8_t* bytes, size_t size)
+{
+    if (hex.size() != size * 2)
         return false;
 
-    api.license(licenseKey);
+    for (size_t i = 0; i < size; i++)
+    {
+        char digits[3] = {hex[i * 2], hex[i * 2 + 1], 0};
+        char* end;
+        bytes[i] = (uint8_t)std::strtoul(digits, &end, 16);
+        if (end != digits + 2)
+            return false;
+    }
+    return true;
+}
+
+// Salt of the user claim, random per token
+static const size_t TOKEN_SALT_SIZE = 16;
+
+// Tokens name the license by an HMAC keyed with it over a random salt, so the key never lands
+// on disk and a token can't be looked up in a table of hashed keys
+static std::string HashLicenseKey(const std::string& licenseKey, const std::string& saltHex)
+{
+    uint8_t salt[TOKEN_SALT_SIZE];
+    if (!FromHex(saltHex, salt, sizeof(salt)))
+        return std::string();
+
+    uint8_t digest[SHA512_SIZE];
+    HmacSha512(licenseKey.data(), licenseKey.size(), salt, sizeof(salt), digest);
+    return ToHex(digest, sizeof(digest));
+}
+
+static LoginBundle MakeFailedLogin(OperationResult result)
+{
+    LoginBundle bundle;
+    bundle.Result = result;
+    return bundle;
+}
+
+static std::string UrlEncode(const std::string& text)
+{
+    static const char HEX[] = "0123456789ABCDEF";
+    std::string encoded;
+    for (unsigned char c : text)
+    {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~')
+        {
+            encoded += (char)c;
+        }
+        else
+        {
+            encoded += '%';
+            encoded += HEX[c >> 4];
+            encoded += HEX[c & 15];
+        }
+    }
+    return encoded;
+}
+
+// Tab separated fields of one line, with \\, \t and \n unescaped
+static std::vector<std::string> SplitFields(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    for (size_t i = 0; i < line.size(); i++)
+    {
+        char c = line[i];
+        if (c == '\t')
+        {
+            fields.emplace_back();
+        }
+        else if (c == '\\' && i + 1 < line.size())
+        {
+            char next = line[++i];
+            fields.back() += next == 't' ? '\t' : next == 'n' ? '\n' : next;
+        }
+        else if (c != '\r')
+        {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+// Calls fn(line) for every line of body
+template <class Fn>
+static void ForEachLine(const std::string& body, Fn fn)
+{
+    size_t start = 0;
+    while (start < body.size())
+    {
+        size_t end = std::min(body.find('\n', start), body.size());
+        fn(body.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+// sub, app and var records, in the login answer and the token claims alike
+static void ReadBundleRecord(const std::vector<std::string>& fields, LoginBundle& bundle)
+{
+    const std::string& type = fields[0];
+    if (type == "sub" && fields.size() >= 3)
+        bundle.Subscriptions.push_back({fields[1], fields[2]});
+    else if (type == "app" && fields.size() >= 4)
+        bundle.Software.push_back({fields[3], (int)std::strtol(fields[2].c_str(), nullptr, 10),
+                                   (int)std::strtol(fields[1].c_str(), nullptr, 10)});
+    else if (type == "var" && fields.size() >= 3)
+        bundle.Variables[fields[1]] = fields[2];
+}
+
+static bool HasRequiredVariables(const LoginBundle& bundle)
+{
+    for (const std::string& name : GetRequiredVariables())
+    {
+        if (bundle.Variables.find(name) == bundle.Variables.end())
+            return false;
+    }
+    return true;
+}
+
+// Login server answer, one record per line:
+//   result <ok | error message>
+//   sub    <name> <expiry>
+//   app    <id> <icon index> <name>
+//   var    <name> <value>
+//   token  <claims> <signature>   Optional, see LoginWithToken. Its line goes to tokenRecord.
+static LoginBundle ParseLoginBundle(const std::string& body, std::string& tokenRecord)
+{
+    LoginBundle bundle;
+    bool accepted = false;
+    ForEachLine(body, [&](const std::string& line) {
+        std::vector<std::string> fields = SplitFields(line);
+        if (fields[0] == "result" && fields.size() >= 2)
+            accepted = fields[1] == "ok";
+        else if (fields[0] == "token")
+            tokenRecord = line;
+        else
+            ReadBundleRecord(fields, bundle);
+    });
+
+    if (!accepted || !HasRequiredVariables(bundle))
+        return MakeFailedLogin(OperationResult::DENIED);
 
-    if (api.response.success && !api.user_data.username.empty() && !api.user_data.ip.empty() &&
-        !api.user_data.hwid.empty())
+    bundle.Result = OperationResult::SUCCESS;
+    return bundle;
+}
+
+// License token record: token <claims> <Ed25519 signature of the claims, hex>.
+// The claims are records as well:
+//   user <salt, 16 bytes hex> <HMAC-SHA-512 of the salt keyed with the license key, hex>
+//   hwid <machine it was issued to>
+//   exp  <unix time>
+// then sub, app and var as in the login answer.
+// Succeeds for a valid signature over this key and this machine, before expiry.
+static LoginBundle LoginWithToken(const std::string& record, const std::string& licenseKey)
+{
+    ScopedLatency latency(Metric::LICENSE_TOKEN);
+
+    std::vector<std::string> fields = SplitFields(record);
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    if (fields.size() < 3 || fields[0] != "token" ||
+        !FromHex(fields[2], signature, sizeof(signature)))
+        return MakeFailedLogin(OperationResult::FAILURE);
+
+    // No key configured, or a signature that doesn't check out
+    const std::string& claims = fields[1];
+    const uint8_t* publicKey = GetTokenPublicKey();
+    if (!publicKey || !VerifyEd25519(publicKey, claims.data(), claims.size(), signature))
+        return MakeFailedLogin(OperationResult::FAILURE);
+
+    LoginBundle bundle;
+    std::string salt, user, hwid;
+    long long expiry = 0;
+    ForEachLine(claims, [&](const std::string& line) {
+        std::vector<std::string> claim = SplitFields(line);
+        if (claim[0] == "user" && claim.size() >= 3)
+        {
+            salt = claim[1];
+            user = claim[2];
+        }
+        else if (claim[0] == "hwid" && claim.size() >= 2)
+            hwid = claim[1];
+        else if (claim[0] == "exp" && claim.size() >= 2)
+            expiry = std::strtoll(claim[1].c_str(), nullptr, 10);
+        else
+            ReadBundleRecord(claim, bundle);
+    });
+
+    // HashLicenseKey is empty for a malformed salt, an empty claim must not match it
+    if (user.empty() || user != HashLicenseKey(licenseKey, salt) || hwid.empty() ||
+        hwid != GetHwid() || expiry <= (long long)std::time(nullptr) ||
+        !HasRequiredVariables(bundle))
+        return MakeFailedLogin(OperationResult::FAILURE);
+
+    bundle.Result = OperationResult::SUCCESS;
+    return bundle;
+}
+
+static std::string ReadTokenFile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(g_TokenFileMutex);
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// Through a temporary file, a crash never leaves half a token behind
+static void WriteTokenFile(const std::string& path, const std::string& record)
+{
+    std::lock_guard<std::mutex> lock(g_TokenFileMutex);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << record;
+        if (!file)
+            return;
+    }
+    MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+}
+
+static void DeleteTokenFile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(g_TokenFileMutex);
+    DeleteFileA(path.c_str());
+}
+
+// The cached login follows the server's answers: kept when accepted, dropped when refused
+static void UpdateLoginCache(const std::string& licenseKey, const LoginBundle& bundle)
+{
+    if (bundle.Result == OperationResult::SUCCESS)
+        SaveCachedLogin(GetLoginCachePath(), GetHwid(), licenseKey, bundle);
+    else if (bundle.Result == OperationResult::DENIED)
+        ClearCachedLogin(GetLoginCachePath());
+}
+
+KeyauthService::KeyauthService(const std::string& loginServerUrls)
+    : m_Session(std::make_shared<Session>())
+{
+    // The login servers do the KeyAuth side themselves, only their connections need warming.
+    // Every mirror, a hedged request shouldn't pay for a cold connection.
+    Executor& executor = Executor::Get();
+    std::vector<std::string> servers = SplitUrls(loginServerUrls);
+    if (!servers.empty())
+    {
+        m_Http = std::make_shared<HttpClient>();
+        for (const std::string& url : servers)
+            executor.Submit(Executor::Priority::BACKGROUND,
+                            [http = m_Http, url]() { http->Warm(url); });
+        m_LoginServers = std::make_shared<EndpointPool>(std::move(servers));
+        return;
+    }
+
+    // keyauth.lib opens its own connections, warming one here wouldn't be the one it uses.
+    // On the executor so closing never waits on a slow init.
+    executor.Submit(Executor::Priority::BACKGROUND, [session = m_Session]() {
+        std::lock_guard<std::timed_mutex> lock(session->Mutex);
+        EnsureSession(*session, false, CancellationToken());
+    });
+}
+
+bool KeyauthService::EnsureSession(Session& session, bool forceInit,
+                                   const CancellationToken& token)
+{
+    bool expired = std::chrono::steady_clock::now() - session.Start > SESSION_LIFETIME;
+    if (session.Valid && !forceInit && !expired)
         return true;
 
-    return false;
+    // Starts from the endpoint that worked last, fails over to the others in turn.
+    // The session lives on the server it was opened on, so requests are never hedged here.
+    std::vector<std::string> urls = GetApiUrls();
+    session.Valid = false;
+    for (size_t i = 0; i < urls.size() && !token.ShouldStop(); i++)
+    {
+        size_t index = (session.UrlIndex + i) % urls.size();
+
+        // TODO : Your licensing logic
+        session.Api = std::make_unique<KeyAuth::API>(
+            std::string(OBF("Surakarndragon's Application")), std::string(OBF("mCoqYG4Adm")),
+            std::string(OBF("1.0")), urls[index]);
+        {
+            ScopedLatency latency(Metric::KEYAUTH_INIT);
+            session.Api->init();
+        }
+
+        if (session.Api->response.success)
+        {
+            session.Valid = true;
+            session.UrlIndex = index;
+            break;
+        }
+    }
+
+    session.Start = std::chrono::steady_clock::now();
+    return session.Valid;
+}
+
+LoginBundle KeyauthService::Login(const std::string& licenseKey, const CancellationToken& token)
+{
+    ScopedLatency latency(Metric::LOGIN);
+    if (!m_LoginServers)
+    {
+        LoginBundle bundle = LoginWithKeyAuth(licenseKey, token);
+        UpdateLoginCache(licenseKey, bundle);
+        return bundle;
+    }
+
+    // A token from an earlier login answers without the network. The caller revalidates it,
+    // which refreshes the token or drops it once the license is refused.
+    std::string path = GetTokenPath();
+    if (!path.empty())
+    {
+        LoginBundle offline = LoginWithToken(ReadTokenFile(path), licenseKey);
+        if (offline.Result == OperationResult::SUCCESS)
+        {
+            offline.Offline = true;
+            return offline;
+        }
+    }
+
+    return LoginWithServer(licenseKey, token);
+}
+
+bool KeyauthService::GetCachedLogin(std::string& licenseKey, LoginBundle& bundle)
+{
+    return LoadCachedLogin(GetLoginCachePath(), GetHwid(), licenseKey, bundle);
+}
+
+LoginBundle KeyauthService::Revalidate(const std::string& licenseKey,
+                                       const CancellationToken& token)
+{
+    if (m_LoginServers)
+        return LoginWithServer(licenseKey, token);
+
+    LoginBundle bundle = LoginWithKeyAuth(licenseKey, token);
+    UpdateLoginCache(licenseKey, bundle);
+    return bundle;
+}
+
+OperationResult KeyauthService::ValidateUser(const std::string& licenseKey,
+                                             const CancellationToken& token)
+{
+    ScopedLatency latency(Metric::VALIDATE_USER);
+    LoginBundle login = Login(licenseKey, token);
+    if (login.Offline)
+        return Revalidate(licenseKey, token).Result;
+    return login.Result;
+}
+
+// One POST, the server answers validation, subscriptions, catalog and variables together.
+// Login only reads server state, so it is safe to retry and hedge across the mirrors.
+LoginBundle KeyauthService::LoginWithServer(const std::string& licenseKey,
+                                            const CancellationToken& token)
+{
+    if (token.ShouldStop())
+        return MakeFailedLogin(token.GetStopResult());
+
+    std::string variables;
+    for (const std::string& name : GetRequiredVariables())
+        variables += (variables.empty() ? "" : ",") + name;
+
+    std::string request = "key=" + UrlEncode(licenseKey) + "&hwid=" + UrlEncode(GetHwid()) +
+                          "&vars=" + UrlEncode(variables);
+    HttpResponse response = m_LoginServers->Send(
+        [http = m_Http, request](const std::string& url) { return http->Post(url, request); },
+        token);
+    if (token.ShouldStop())
+        return MakeFailedLogin(token.GetStopResult());
+    if (!response.Ok())
+        return MakeFailedLogin(OperationResult::FAILURE);
+
+    // An answer replaces the token: with the new one, or with none once the license is refused
+    std::string tokenRecord;
+    LoginBundle bundle = ParseLoginBundle(response.Body, tokenRecord);
+    std::string path = GetTokenPath();
+    if (!path.empty())
+    {
+        if (bundle.Result != OperationResult::SUCCESS)
+            DeleteTokenFile(path);
+        else if (LoginWithToken(tokenRecord, licenseKey).Result == OperationResult::SUCCESS)
+            WriteTokenFile(path, tokenRecord);
+    }
+    UpdateLoginCache(licenseKey, bundle);
+    return bundle;
+}
+
+// license() already carries the subscriptions, the catalog is local.
+// Variables are one more round trip each here, keep GetRequiredVariables() short.
+LoginBundle KeyauthService::LoginWithKeyAuth(const std::string& licenseKey,
+                                             const CancellationToken& token)
+{
+    // Keep a reference, the session has to outlive a call that ends up abandoned
+    std::shared_ptr<Session> session = m_Session;
+
+    // Waits for the warm-up if it is still running, unless told to stop
+    std::unique_lock<std::timed_mutex> lock(session->Mutex, std::defer_lock);
+    while (!lock.try_lock_for(LOCK_POLL))
+    {
+        if (token.ShouldStop())
+            return MakeFailedLogin(token.GetStopResult());
+    }
+
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        if (token.ShouldStop())
+            return MakeFailedLogin(token.GetStopResult());
+        if (!EnsureSession(*session, attempt > 0, token))
+            return MakeFailedLogin(OperationResult::FAILURE);
+
+        if (token.ShouldStop())
+            return MakeFailedLogin(token.GetStopResult());
+        {
+            ScopedLatency latency(Metric::KEYAUTH_LICENSE);
+            session->Api->license(licenseKey);
+        }
+
+        const KeyAuth::UserData& user = session->Api->user_data;
+        if (session->Api->response.success && !user.username.empty() && !user.ip.empty() &&
+            !user.hwid.empty())
+        {
+            LoginBundle bundle;
+            for (const KeyAuth::Subscription& subscription : user.subscriptions)
+                bundle.Subscriptions.push_back({subscription.name, subscription.expiry});
+            bundle.Software = GetAvailableSoftware();
+
+            for (const std::string& name : GetRequiredVariables())
+            {
+                if (token.ShouldStop())
+                    return MakeFailedLogin(token.GetStopResult());
+                ScopedLatency latency(Metric::KEYAUTH_VAR);
+                bundle.Variables[name] = session->Api->var(name);
+                if (!session->Api->response.success)
+                    return MakeFailedLogin(OperationResult::FAILURE);
+            }
+
+            bundle.Result = OperationResult::SUCCESS;
+            return bundle;
+        }
+
+        // Only a dead session is worth a second try, anything else is the license refused
+        std::string message = session->Api->response.message;
+        std::transform(message.begin(), message.end(), message.begin(),
+                       [](unsigned char c) { return (char)std::tolower(c); });
+        if (message.find(OBF("session")) == std::string::npos)
+            return MakeFailedLogin(OperationResult::DENIED);
+    }
+
+    return MakeFailedLogin(OperationResult::FAILURE);
 }
 
 std::vector<SoftwareItem> KeyauthService::GetAvailableSoftware()
 {
+    ScopedLatency latency(Metric::GET_AVAILABLE_SOFTWARE);
+
     // TODO : Your available software
     return {{std::string(OBF("FPS Boost System")), 0, 0}};
 }
 
-bool KeyauthService::LaunchSoftware(int id)
+OperationResult KeyauthService::LaunchSoftware(int id, const CancellationToken& token)
 {
+    ScopedLatency latency(Metric::LAUNCH_SOFTWARE);
+    if (token.ShouldStop())
+        return token.GetStopResult();
+
     // TODO : Your launching software logic
     if (id == 0)
     {
@@ -49,13 +610,13 @@ bool KeyauthService::LaunchSoftware(int id)
 
         wchar_t cmdLine[] = L"cmd.exe";
         if (!CreateProcessW(NULL, cmdLine, NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
-            return false;
+            return OperationResult::FAILURE;
 
         CloseHandle(pi.hProcess);
         CloseHandle(pi.hThread);
     }
 
-    return true;
+    return OperationResult::SUCCESS;
 }
 
 } // namespace service
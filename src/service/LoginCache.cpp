@@ -0,0 +1,136 @@
+#include "69/service/LoginCache.h"
+
+#include "69/service/LoginRecord.h"
+#include "69/service/Metrics.h"
+
+#include <Windows.h>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <wincrypt.h>
+
+namespace service
+{
+
+// How long a login is trusted without the server
+static const long long CACHE_LIFETIME = 7 * 24 * 3600;
+
+// Extra DPAPI entropy, other programs of the same account can't decrypt the file on its own
+static const char ENTROPY[] = "69-ImGui-Loader login cache";
+
+// Encrypted size limit, the record plus the DPAPI header with room to spare
+static const DWORD MAX_FILE_SIZE = 8192;
+
+// Guards the file, saved from service workers
+static std::mutex g_FileMutex;
+
+static DATA_BLOB MakeEntropy()
+{
+    return {(DWORD)(sizeof(ENTROPY) - 1), (BYTE*)ENTROPY};
+}
+
+// Decrypts into record, false unless it is exactly one
+static bool ReadRecord(const std::string& path, LoginRecord& record)
+{
+    BYTE encrypted[MAX_FILE_SIZE];
+    DWORD size = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_FileMutex);
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        BOOL read = ReadFile(file, encrypted, sizeof(encrypted), &size, nullptr);
+        CloseHandle(file);
+        if (!read || size == 0 || size == sizeof(encrypted))
+            return false;
+    }
+
+    DATA_BLOB input = {size, encrypted};
+    DATA_BLOB entropy = MakeEntropy();
+    DATA_BLOB output = {};
+    if (!CryptUnprotectData(&input, nullptr, &entropy, nullptr, nullptr,
+                            CRYPTPROTECT_UI_FORBIDDEN, &output))
+        return false;
+
+    bool valid = output.cbData == sizeof(LoginRecord);
+    if (valid)
+        memcpy(&record, output.pbData, sizeof(LoginRecord));
+    SecureZeroMemory(output.pbData, output.cbData);
+    LocalFree(output.pbData);
+    return valid;
+}
+
+bool LoadCachedLogin(const std::string& path, const std::string& hwid, std::string& licenseKey,
+                     LoginBundle& bundle)
+{
+    ScopedLatency latency(Metric::LOGIN_CACHE);
+
+    LoginRecord record;
+    if (path.empty() || !ReadRecord(path, record))
+        return false;
+
+    bool valid = UnpackLoginRecord(record, hwid, (long long)std::time(nullptr), licenseKey,
+                                   bundle);
+    SecureZeroMemory(&record, sizeof(record));
+    return valid;
+}
+
+bool SaveCachedLogin(const std::string& path, const std::string& hwid,
+                     const std::string& licenseKey, const LoginBundle& bundle)
+{
+    if (path.empty())
+        return false;
+
+    LoginRecord record;
+    bool fits = PackLoginRecord(hwid, licenseKey, bundle,
+                                (long long)std::time(nullptr) + CACHE_LIFETIME, record);
+
+    DATA_BLOB input = {sizeof(record), (BYTE*)&record};
+    DATA_BLOB entropy = MakeEntropy();
+    DATA_BLOB output = {};
+    bool encrypted = fits && CryptProtectData(&input, nullptr, &entropy, nullptr, nullptr,
+                                              CRYPTPROTECT_UI_FORBIDDEN, &output);
+    SecureZeroMemory(&record, sizeof(record));
+
+    // A login that can't be kept replaces the previous one all the same
+    if (!encrypted)
+    {
+        ClearCachedLogin(path);
+        return false;
+    }
+
+    // Through a temporary file, a crash never leaves half a record behind
+    std::lock_guard<std::mutex> lock(g_FileMutex);
+    std::string temporary = path + ".tmp";
+    HANDLE file = CreateFileA(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    bool written = false;
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        DWORD size = 0;
+        written = WriteFile(file, output.pbData, output.cbData, &size, nullptr) &&
+                  size == output.cbData;
+        CloseHandle(file);
+    }
+    LocalFree(output.pbData);
+
+    written = written && MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+    if (!written)
+    {
+        DeleteFileA(temporary.c_str());
+        DeleteFileA(path.c_str());
+    }
+    return written;
+}
+
+void ClearCachedLogin(const std::string& path)
+{
+    if (path.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(g_FileMutex);
+    DeleteFileA(path.c_str());
+}
+
+} // namespace service
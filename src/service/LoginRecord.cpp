@@ -0,0 +1,94 @@
+#include "69/service/LoginRecord.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace service
+{
+
+static const uint32_t RECORD_MAGIC = 0x4336394C; // "L69C"
+static const uint32_t RECORD_VERSION = 1;
+
+template <size_t N>
+static bool WriteField(char (&field)[N], const std::string& value)
+{
+    if (value.size() >= N || value.find('\0') != std::string::npos)
+        return false;
+    memcpy(field, value.c_str(), value.size() + 1);
+    return true;
+}
+
+template <size_t N>
+static bool IsTerminated(const char (&field)[N])
+{
+    return memchr(field, 0, N) != nullptr;
+}
+
+bool PackLoginRecord(const std::string& hwid, const std::string& licenseKey,
+                     const LoginBundle& bundle, long long expiry, LoginRecord& record)
+{
+    record = LoginRecord();
+    record.Magic = RECORD_MAGIC;
+    record.Version = RECORD_VERSION;
+    record.Expiry = expiry;
+    bool fits = WriteField(record.Hwid, hwid) && WriteField(record.LicenseKey, licenseKey) &&
+                bundle.Subscriptions.size() <= std::size(record.Subscriptions) &&
+                bundle.Software.size() <= std::size(record.Software) &&
+                bundle.Variables.size() <= std::size(record.Variables);
+
+    for (size_t i = 0; fits && i < bundle.Subscriptions.size(); i++)
+        fits = WriteField(record.Subscriptions[i].Name, bundle.Subscriptions[i].Name) &&
+               WriteField(record.Subscriptions[i].Expiry, bundle.Subscriptions[i].Expiry);
+    for (size_t i = 0; fits && i < bundle.Software.size(); i++)
+    {
+        record.Software[i].ID = bundle.Software[i].ID;
+        record.Software[i].IconIndex = bundle.Software[i].IconIndex;
+        fits = WriteField(record.Software[i].Name, bundle.Software[i].Name);
+    }
+    uint32_t variableCount = 0;
+    for (auto it = bundle.Variables.begin(); fits && it != bundle.Variables.end(); ++it)
+    {
+        fits = WriteField(record.Variables[variableCount].Name, it->first) &&
+               WriteField(record.Variables[variableCount].Value, it->second);
+        variableCount++;
+    }
+    record.SubscriptionCount = (uint32_t)bundle.Subscriptions.size();
+    record.SoftwareCount = (uint32_t)bundle.Software.size();
+    record.VariableCount = variableCount;
+    return fits;
+}
+
+bool UnpackLoginRecord(const LoginRecord& record, const std::string& hwid, long long now,
+                       std::string& licenseKey, LoginBundle& bundle)
+{
+    bool valid = record.Magic == RECORD_MAGIC && record.Version == RECORD_VERSION &&
+                 record.Expiry > now && IsTerminated(record.Hwid) && !hwid.empty() &&
+                 hwid == record.Hwid && IsTerminated(record.LicenseKey) &&
+                 record.SubscriptionCount <= std::size(record.Subscriptions) &&
+                 record.SoftwareCount <= std::size(record.Software) &&
+                 record.VariableCount <= std::size(record.Variables);
+    for (uint32_t i = 0; valid && i < record.SubscriptionCount; i++)
+        valid = IsTerminated(record.Subscriptions[i].Name) &&
+                IsTerminated(record.Subscriptions[i].Expiry);
+    for (uint32_t i = 0; valid && i < record.SoftwareCount; i++)
+        valid = IsTerminated(record.Software[i].Name);
+    for (uint32_t i = 0; valid && i < record.VariableCount; i++)
+        valid = IsTerminated(record.Variables[i].Name) && IsTerminated(record.Variables[i].Value);
+    if (!valid)
+        return false;
+
+    licenseKey = record.LicenseKey;
+    bundle = LoginBundle();
+    bundle.Result = OperationResult::SUCCESS;
+    for (uint32_t i = 0; i < record.SubscriptionCount; i++)
+        bundle.Subscriptions.push_back(
+            {record.Subscriptions[i].Name, record.Subscriptions[i].Expiry});
+    for (uint32_t i = 0; i < record.SoftwareCount; i++)
+        bundle.Software.push_back(
+            {record.Software[i].Name, record.Software[i].IconIndex, record.Software[i].ID});
+    for (uint32_t i = 0; i < record.VariableCount; i++)
+        bundle.Variables[record.Variables[i].Name] = record.Variables[i].Value;
+    return true;
+}
+
+} // namespace service
@@ -0,0 +1,186 @@
+#include "69/service/Metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace service
+{
+
+static LatencyHistogram g_Histograms[(int)Metric::COUNT];
+static std::mutex g_WriteMutex; // One writer at a time, they share the temporary file
+
+const char* GetMetricName(Metric metric)
+{
+    switch (metric)
+    {
+    case Metric::LOGIN:
+        return "login";
+    case Metric::VALIDATE_USER:
+        return "validate_user";
+    case Metric::GET_AVAILABLE_SOFTWARE:
+        return "get_available_software";
+    case Metric::LAUNCH_SOFTWARE:
+        return "launch_software";
+    case Metric::KEYAUTH_INIT:
+        return "keyauth_init";
+    case Metric::KEYAUTH_LICENSE:
+        return "keyauth_license";
+    case Metric::KEYAUTH_VAR:
+        return "keyauth_var";
+    case Metric::LICENSE_TOKEN:
+        return "license_token";
+    case Metric::LOGIN_CACHE:
+        return "login_cache";
+    case Metric::HTTP_DNS:
+        return "http_dns";
+    case Metric::HTTP_CONNECT:
+        return "http_connect";
+    case Metric::HTTP_TLS:
+        return "http_tls";
+    case Metric::HTTP_WAIT:
+        return "http_wait";
+    case Metric::HTTP_BODY:
+        return "http_body";
+    case Metric::HTTP_REQUEST:
+        return "http_request";
+    case Metric::COUNT:
+        break;
+    }
+    return "unknown";
+}
+
+// Values below 2 * 8 get a bucket each, above that the top 4 bits pick it
+int LatencyHistogram::GetBucket(uint32_t micros)
+{
+    const uint32_t linear = 2u << SUB_BUCKET_BITS;
+    if (micros < linear)
+        return (int)micros;
+
+    int shift = (int)std::bit_width(micros) - 1 - SUB_BUCKET_BITS;
+    return (shift << SUB_BUCKET_BITS) + (int)(micros >> shift);
+}
+
+uint32_t LatencyHistogram::GetBucketStart(int bucket)
+{
+    const int half = 1 << SUB_BUCKET_BITS;
+    if (bucket < half * 2)
+        return (uint32_t)bucket;
+
+    int shift = bucket / half - 1;
+    return (uint32_t)(bucket - shift * half) << shift;
+}
+
+void LatencyHistogram::Record(std::chrono::steady_clock::duration latency)
+{
+    long long micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    uint32_t value = (uint32_t)std::clamp<long long>(micros, 0, UINT32_MAX);
+
+    m_Counts[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    m_SumMicros.fetch_add(value, std::memory_order_relaxed);
+
+    uint32_t max = m_MaxMicros.load(std::memory_order_relaxed);
+    while (value > max && !m_MaxMicros.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::Read(Snapshot& snapshot) const
+{
+    snapshot.Count = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        snapshot.Counts[i] = m_Counts[i].load(std::memory_order_relaxed);
+        snapshot.Count += snapshot.Counts[i];
+    }
+    snapshot.SumMicros = m_SumMicros.load(std::memory_order_relaxed);
+    snapshot.MaxMicros = m_MaxMicros.load(std::memory_order_relaxed);
+}
+
+// Middle of the bucket holding the percentile, never above the largest value seen
+double LatencyHistogram::Snapshot::GetPercentileMs(double percentile) const
+{
+    if (Count == 0)
+        return 0.0;
+
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)(Count - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += Counts[i];
+        if (seen < rank)
+            continue;
+
+        double start = (double)GetBucketStart(i);
+        double end = i + 1 < BUCKET_COUNT ? (double)GetBucketStart(i + 1) : start;
+        return std::min((start + end) * 0.5, (double)MaxMicros) / 1000.0;
+    }
+    return MaxMicros / 1000.0;
+}
+
+void Metrics::Record(Metric metric, std::chrono::steady_clock::duration latency)
+{
+    g_Histograms[(int)metric].Record(latency);
+}
+
+bool Metrics::WriteJson(const char* path)
+{
+    std::lock_guard<std::mutex> lock(g_WriteMutex);
+    std::string temporary = std::string(path) + ".tmp";
+    {
+        std::ofstream file(temporary);
+        if (!file)
+            return false;
+
+        // Buckets are [start_us, count] pairs of the non-empty ones, enough to merge histograms
+        LatencyHistogram::Snapshot snapshot;
+        file << "{\n";
+        bool first = true;
+        for (int m = 0; m < (int)Metric::COUNT; m++)
+        {
+            g_Histograms[m].Read(snapshot);
+            if (snapshot.Count == 0)
+                continue;
+
+            char summary[384];
+            snprintf(summary, sizeof(summary),
+                     "{\"count\": %llu, \"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p90_ms\": %.3f, "
+                     "\"p99_ms\": %.3f, \"max_ms\": %.3f, \"buckets\": [",
+                     (unsigned long long)snapshot.Count,
+                     snapshot.SumMicros / 1000.0 / (double)snapshot.Count,
+                     snapshot.GetPercentileMs(50.0), snapshot.GetPercentileMs(90.0),
+                     snapshot.GetPercentileMs(99.0), snapshot.MaxMicros / 1000.0);
+
+            if (!first)
+                file << ",\n";
+            file << "  \"" << GetMetricName((Metric)m) << "\": " << summary;
+
+            bool firstBucket = true;
+            for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+            {
+                if (snapshot.Counts[i] == 0)
+                    continue;
+                file << (firstBucket ? "" : ", ") << "[" << LatencyHistogram::GetBucketStart(i)
+                     << ", " << snapshot.Counts[i] << "]";
+                firstBucket = false;
+            }
+            file << "]}";
+            first = false;
+        }
+        file << "\n}\n";
+
+        if (!file)
+            return false;
+    }
+
+    // Replaces an existing file in one step (MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows)
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+} // namespace service
@@ -0,0 +1,92 @@
+#include "69/service/Scheduler.h"
+
+#include <exception>
+
+namespace service
+{
+
+FrameScheduler* FrameScheduler::s_Current = nullptr;
+
+// Makes a scheduler current while its tasks run, restores the previous one after
+class CurrentScope
+{
+  public:
+    explicit CurrentScope(FrameScheduler*& current, FrameScheduler* scheduler)
+        : m_Current(current), m_Previous(current)
+    {
+        m_Current = scheduler;
+    }
+
+    ~CurrentScope()
+    {
+        m_Current = m_Previous;
+    }
+
+  private:
+    FrameScheduler*& m_Current;
+    FrameScheduler* m_Previous;
+};
+
+FrameScheduler::~FrameScheduler()
+{
+    CancelAll();
+}
+
+void FrameScheduler::Spawn(Task<void> task)
+{
+    if (task.IsDone())
+        return;
+
+    // Copy the handle, the task may spawn others and move m_Tasks around
+    std::coroutine_handle<> handle = task.m_Handle;
+    m_Tasks.push_back(std::move(task));
+
+    CurrentScope scope(s_Current, this);
+    handle.resume();
+}
+
+void FrameScheduler::Tick()
+{
+    CurrentScope scope(s_Current, this);
+
+    // Tasks suspending while this runs wait for the next Tick
+    std::vector<Suspended> waiting;
+    waiting.swap(m_Waiting);
+    for (const Suspended& suspended : waiting)
+    {
+        if (suspended.Awaited->IsReady())
+            suspended.Handle.resume();
+        else
+            m_Waiting.push_back(suspended);
+    }
+
+    // Drop finished tasks
+    std::exception_ptr exception;
+    for (auto it = m_Tasks.begin(); it != m_Tasks.end();)
+    {
+        if (!it->IsDone())
+        {
+            ++it;
+            continue;
+        }
+
+        if (!exception)
+            exception = it->m_Handle.promise().Exception;
+        it = m_Tasks.erase(it);
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+void FrameScheduler::CancelAll()
+{
+    for (const Suspended& suspended : m_Waiting)
+        suspended.Awaited->Cancel();
+
+    // Waiters live in the task frames, forget them before destroying those
+    m_Waiting.clear();
+    m_Tasks.clear();
+}
+
+} // namespace service
@@ -0,0 +1,90 @@
+#include "69/service/Service.h"
+
+#include "69/service/Scheduler.h"
+
+namespace service
+{
+
+// fn(const CancellationToken&) -> LoginBundle, run on the Executor
+template <class Fn>
+static Task<LoginBundle> RunLogin(Fn fn, std::chrono::steady_clock::duration timeout)
+{
+    // Filled by the worker, only read once it finished
+    auto bundle = std::make_shared<LoginBundle>();
+    PendingOperation operation = PendingOperation::Start(
+        [fn, bundle](const CancellationToken& token) {
+            *bundle = fn(token);
+            return bundle->Result;
+        },
+        timeout);
+
+    OperationResult result = co_await std::move(operation);
+    if (result != OperationResult::SUCCESS)
+    {
+        LoginBundle failed;
+        failed.Result = result;
+        co_return failed;
+    }
+    co_return std::move(*bundle);
+}
+
+Task<LoginBundle> LoginAsync(std::shared_ptr<IService> service, std::string licenseKey,
+                             std::chrono::steady_clock::duration timeout)
+{
+    return RunLogin(
+        [service, licenseKey](const CancellationToken& token) {
+            return service->Login(licenseKey, token);
+        },
+        timeout);
+}
+
+Task<LoginBundle> RevalidateAsync(std::shared_ptr<IService> service, std::string licenseKey,
+                                  std::chrono::steady_clock::duration timeout)
+{
+    return RunLogin(
+        [service, licenseKey](const CancellationToken& token) {
+            return service->Revalidate(licenseKey, token);
+        },
+        timeout);
+}
+
+Task<OperationResult> ValidateUserAsync(std::shared_ptr<IService> service, std::string licenseKey,
+                                        std::chrono::steady_clock::duration timeout)
+{
+    PendingOperation operation = PendingOperation::Start(
+        [service, licenseKey](const CancellationToken& token) {
+            return service->ValidateUser(licenseKey, token);
+        },
+        timeout);
+    co_return co_await std::move(operation);
+}
+
+Task<std::vector<SoftwareItem>> GetAvailableSoftwareAsync(
+    std::shared_ptr<IService> service, std::chrono::steady_clock::duration timeout)
+{
+    // Filled by the worker, only read once it reported success
+    auto items = std::make_shared<std::vector<SoftwareItem>>();
+    PendingOperation operation = PendingOperation::Start(
+        [service, items](const CancellationToken&) {
+            *items = service->GetAvailableSoftware();
+            return OperationResult::SUCCESS;
+        },
+        timeout);
+
+    if (co_await std::move(operation) != OperationResult::SUCCESS)
+        co_return std::vector<SoftwareItem>();
+    co_return std::move(*items);
+}
+
+Task<OperationResult> LaunchSoftwareAsync(std::shared_ptr<IService> service, int id,
+                                          std::chrono::steady_clock::duration timeout)
+{
+    PendingOperation operation = PendingOperation::Start(
+        [service, id](const CancellationToken& token) {
+            return service->LaunchSoftware(id, token);
+        },
+        timeout);
+    co_return co_await std::move(operation);
+}
+
+} // namespace service
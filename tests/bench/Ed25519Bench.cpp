@@ -0,0 +1,48 @@
+// VerifyEd25519 runs once per start with a token file, before the menu can show the main menu
+#include "69/service/Ed25519.h"
+
+#include "Test.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace service;
+
+static std::vector<uint8_t> FromHex(const char* hex)
+{
+    std::vector<uint8_t> bytes;
+    for (; hex[0] && hex[1]; hex += 2)
+    {
+        char digits[3] = {hex[0], hex[1], 0};
+        bytes.push_back((uint8_t)std::strtoul(digits, nullptr, 16));
+    }
+    return bytes;
+}
+
+// RFC 8032 section 7.1, test 3
+static const char* PUBLIC_KEY = "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025";
+static const char* MESSAGE = "af82";
+static const char* SIGNATURE = "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac"
+                               "18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a";
+
+TEST(VerifyTime)
+{
+    std::vector<uint8_t> publicKey = FromHex(PUBLIC_KEY);
+    std::vector<uint8_t> message = FromHex(MESSAGE);
+    std::vector<uint8_t> signature = FromHex(SIGNATURE);
+
+    bool verified = false;
+    double seconds = test::Measure([&]() {
+        verified = VerifyEd25519(publicKey.data(), message.data(), message.size(),
+                                 signature.data());
+    });
+    test::Report("VerifyEd25519, RFC 8032 test 3", seconds);
+    CHECK(verified);
+
+    // A token sized message, the hash is a small part of it
+    std::string claims(160, 'c');
+    std::vector<uint8_t> digest(SHA512_SIZE);
+    seconds = test::Measure([&]() { Sha512(claims.data(), claims.size(), digest.data()); });
+    test::Report("Sha512, 160 bytes", seconds);
+}
@@ -0,0 +1,66 @@
+#include "69/service/HttpClient.h"
+
+#include "StandInServer.h"
+#include "Test.h"
+
+#include <cstdio>
+
+using service::HttpClient;
+using service::HttpResponse;
+
+static HttpResponse Echo(const StandInServer::Request& request)
+{
+    return {200, request.Body};
+}
+
+// Every request to a host after the first rides the same connection
+TEST(RequestsShareOneConnection)
+{
+    StandInServer server(Echo);
+    HttpClient http;
+    for (int i = 0; i < 5; i++)
+    {
+        HttpResponse response = http.Post(server.GetUrl(), "key=" + std::to_string(i));
+        CHECK(response.Status == 200);
+        CHECK(response.Body == "key=" + std::to_string(i));
+    }
+    CHECK(server.GetRequests() == 5);
+    CHECK(server.GetConnections() == 1);
+}
+
+// Warm opens the connection the first request then uses
+TEST(WarmOpensTheConnectionAhead)
+{
+    StandInServer server(Echo);
+    HttpClient http;
+    CHECK(http.Warm(server.GetUrl()));
+    CHECK(server.GetConnections() == 1);
+
+    CHECK(http.Post(server.GetUrl(), "key").Ok());
+    CHECK(server.GetConnections() == 1);
+}
+
+// Latency per call through the pooled client against a new client (new connection) per call.
+// Loopback has no TLS and no distance, so this is the floor of what reuse saves.
+TEST(PooledAgainstFreshConnections)
+{
+    StandInServer server(Echo);
+    HttpClient pooled;
+    pooled.Warm(server.GetUrl());
+
+    double reused = test::Measure([&]() { pooled.Post(server.GetUrl(), "key"); });
+    int connections = server.GetConnections();
+    int requests = server.GetRequests();
+
+    double fresh = test::Measure([&]() { HttpClient().Post(server.GetUrl(), "key"); });
+    int freshConnections = server.GetConnections() - connections;
+    int freshRequests = server.GetRequests() - requests;
+
+    test::Report("pooled client, per call", reused);
+    test::Report("new client per call", fresh);
+    printf("  pooled: %d requests on %d connection(s), fresh: %d requests on %d\n", requests,
+           connections, freshRequests, freshConnections);
+    printf("  handshakes avoided: %d\n", requests - connections);
+    CHECK(connections == 1);
+    CHECK(freshConnections == freshRequests);
+}
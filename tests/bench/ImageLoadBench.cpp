@@ -0,0 +1,101 @@
+// First frame work of Menu::LoadTexture for the logo and the software icon. Before the images
+// were decoded at build time (scripts/change_*.py) the loader decoded both PNGs with stb_image;
+// now it copies the drawn mip level, with its border, as ImageAtlas::Add does. The copy into
+// the atlas texture itself needs the ImGui sources and isn't measured.
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb/stb_image.h"
+
+#include "69/resource/Logo.h"
+#include "69/resource/Software.h"
+
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static std::vector<unsigned char> ReadFile(const std::string& path)
+{
+    std::vector<unsigned char> data;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+        return data;
+    unsigned char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + n);
+    fclose(file);
+    return data;
+}
+
+// Every level down to 1x1, what the headers held before only the drawn level was kept
+static size_t GetChainSize(int width, int height)
+{
+    size_t size = 0;
+    for (;;)
+    {
+        size += (size_t)width * height * 4;
+        if (width == 1 && height == 1)
+            return size;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+}
+
+// ImageAtlas::Add up to the conversion into the atlas: the image with its edge pixels repeated
+static void CopyPadded(const unsigned char* pixels, int width, int height,
+                       std::vector<unsigned char>& padded)
+{
+    int paddedWidth = width + 2;
+    int paddedHeight = height + 2;
+    padded.resize((size_t)paddedWidth * paddedHeight * 4);
+    for (int y = 0; y < paddedHeight; y++)
+    {
+        int sourceY = y < 1 ? 0 : (y > height ? height - 1 : y - 1);
+        const unsigned char* source = pixels + (size_t)sourceY * width * 4;
+        unsigned char* dest = &padded[(size_t)y * paddedWidth * 4];
+        memcpy(dest, source, 4);
+        memcpy(dest + 4, source, (size_t)width * 4);
+        memcpy(dest + (size_t)(width + 1) * 4, source + (size_t)(width - 1) * 4, 4);
+    }
+}
+
+TEST(FirstFrameImages)
+{
+    std::vector<unsigned char> logoPng = ReadFile(std::string(SCRIPTS_DIR) + "/logo.png");
+    std::vector<unsigned char> softwarePng = ReadFile(std::string(SCRIPTS_DIR) + "/software.png");
+    CHECK(!logoPng.empty() && !softwarePng.empty());
+
+    // The header holds the logo exactly as stb_image decodes it
+    int width = 0, height = 0, channels = 0;
+    unsigned char* logo =
+        stbi_load_from_memory(logoPng.data(), (int)logoPng.size(), &width, &height, &channels, 4);
+    CHECK(logo && width == resource::s_LogoWidth && height == resource::s_LogoHeight);
+    CHECK(logo && memcmp(logo, resource::s_Logo, sizeof(resource::s_Logo)) == 0);
+    stbi_image_free(logo);
+
+    double seconds = test::Measure([&]() {
+        int w, h, c;
+        stbi_image_free(
+            stbi_load_from_memory(logoPng.data(), (int)logoPng.size(), &w, &h, &c, 4));
+        stbi_image_free(
+            stbi_load_from_memory(softwarePng.data(), (int)softwarePng.size(), &w, &h, &c, 4));
+    });
+    test::Report("before: decode both PNGs", seconds);
+
+    std::vector<unsigned char> padded;
+    seconds = test::Measure([&]() {
+        CopyPadded(resource::s_Logo, resource::s_LogoWidth, resource::s_LogoHeight, padded);
+        CopyPadded(resource::s_Software, resource::s_SoftwareWidth, resource::s_SoftwareHeight,
+                   padded);
+    });
+    test::Report("now: copy the drawn levels", seconds);
+
+    // Pixel data in the binary, the software icon is level 1 of its 256 px image
+    printf("  PNGs %zu bytes, full mip chains %zu bytes, drawn levels %zu bytes\n",
+           logoPng.size() + softwarePng.size(),
+           GetChainSize(resource::s_LogoWidth, resource::s_LogoHeight) +
+               GetChainSize(resource::s_SoftwareWidth * 2, resource::s_SoftwareHeight * 2),
+           sizeof(resource::s_Logo) + sizeof(resource::s_Software));
+}
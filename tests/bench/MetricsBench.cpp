@@ -0,0 +1,61 @@
+#include "69/service/Metrics.h"
+
+#include "Test.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace service;
+
+// Metrics are recorded on every service call and HTTP phase, a record has to stay under 1 us
+static const double RECORD_BUDGET = 1e-6;
+
+// test::Report's milliseconds round these to 0
+static void ReportNs(const char* name, double seconds)
+{
+    printf("  %-48s %10.1f ns\n", name, seconds * 1e9);
+}
+
+TEST(RecordTime)
+{
+    int i = 0;
+    double seconds = test::Measure([&i]() {
+        Metrics::Record(Metric::HTTP_WAIT, std::chrono::microseconds(100 + (i++ & 4095)));
+    });
+    ReportNs("Metrics::Record", seconds);
+    if (!test::IsQuick())
+        CHECK(seconds < RECORD_BUDGET);
+
+    // Two clock reads on top
+    seconds = test::Measure([]() { ScopedLatency latency(Metric::HTTP_BODY); });
+    ReportNs("ScopedLatency", seconds);
+    if (!test::IsQuick())
+        CHECK(seconds < RECORD_BUDGET);
+}
+
+// The same histogram from the Executor workers at once, sharing its counters' cache lines
+TEST(ContendedRecordTime)
+{
+    const int threads = 4;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> others;
+    for (int t = 1; t < threads; t++)
+    {
+        others.emplace_back([&stop]() {
+            while (!stop)
+                Metrics::Record(Metric::HTTP_REQUEST, std::chrono::microseconds(500));
+        });
+    }
+
+    double seconds = test::Measure(
+        []() { Metrics::Record(Metric::HTTP_REQUEST, std::chrono::microseconds(500)); });
+    stop = true;
+    for (std::thread& other : others)
+        other.join();
+
+    ReportNs("Metrics::Record, 4 threads", seconds);
+    if (!test::IsQuick())
+        CHECK(seconds < RECORD_BUDGET);
+}
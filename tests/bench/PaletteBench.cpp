@@ -0,0 +1,76 @@
+#include "69/menu/Theme.h"
+
+#include "Test.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+struct PaletteEntry
+{
+    const char* Name;
+    ImVec4 Color;
+    const theme::PackedColor* Packed;
+};
+
+static const PaletteEntry PALETTE[] = {
+    {"GLASS_BG", theme::GLASS_BG, &theme::GLASS_BG_U32},
+    {"GLASS_BORDER", theme::GLASS_BORDER, &theme::GLASS_BORDER_U32},
+    {"ACCENT_COLOR", theme::ACCENT_COLOR, &theme::ACCENT_COLOR_U32},
+    {"TEXT_PRIMARY", theme::TEXT_PRIMARY, &theme::TEXT_PRIMARY_U32},
+    {"INPUT_BG", theme::INPUT_BG, &theme::INPUT_BG_U32},
+    {"BUTTON_TOP", theme::BUTTON_TOP, &theme::BUTTON_TOP_U32},
+    {"BUTTON_BOTTOM", theme::BUTTON_BOTTOM, &theme::BUTTON_BOTTOM_U32},
+    {"ERROR_COLOR", theme::ERROR_COLOR, &theme::ERROR_COLOR_U32},
+    {"SUCCESS_COLOR", theme::SUCCESS_COLOR, &theme::SUCCESS_COLOR_U32},
+    {"WHITE", ImVec4(1.0f, 1.0f, 1.0f, 1.0f), &theme::WHITE_U32},
+};
+
+// The lookup gives what the menu computed before, GetColorU32(FadeColor(color, alpha)):
+// same RGB, alpha off by the quantized fade at most
+TEST(PackedMatchesConversion)
+{
+    for (const PaletteEntry& entry : PALETTE)
+    {
+        int maxError = 0;
+        for (int i = 0; i <= 1000; i++)
+        {
+            float alpha = (float)i / 1000.0f;
+            ImU32 expected = theme::GetColorU32(theme::FadeColor(entry.Color, alpha));
+            ImU32 packed = entry.Packed->Get(alpha);
+            CHECK((expected & ~IM_COL32_A_MASK) == (packed & ~IM_COL32_A_MASK));
+            int a = (int)(expected >> IM_COL32_A_SHIFT);
+            int b = (int)(packed >> IM_COL32_A_SHIFT);
+            maxError = std::max(maxError, std::abs(a - b));
+        }
+        if (maxError > 1)
+            printf("  %s: alpha off by %d\n", entry.Name, maxError);
+        CHECK(maxError <= 1);
+        CHECK(entry.Packed->Get() == theme::GetColorU32(entry.Color));
+    }
+}
+
+// A frame's worth of faded colors, converted against looked up
+TEST(LookupAgainstConversion)
+{
+    static const int COLORS = 1024;
+    float alphas[COLORS];
+    for (int i = 0; i < COLORS; i++)
+        alphas[i] = (float)((i * 37) % 256) / 255.0f;
+
+    volatile ImU32 sink = 0;
+    double converted = test::Measure([&]() {
+        ImU32 sum = 0;
+        for (int i = 0; i < COLORS; i++)
+            sum += theme::GetColorU32(theme::FadeColor(theme::ACCENT_COLOR, alphas[i]));
+        sink = sink + sum;
+    });
+    double lookedUp = test::Measure([&]() {
+        ImU32 sum = 0;
+        for (int i = 0; i < COLORS; i++)
+            sum += theme::ACCENT_COLOR_U32.Get(alphas[i]);
+        sink = sink + sum;
+    });
+    test::Report("1024 GetColorU32(FadeColor)", converted);
+    test::Report("1024 PackedColor::Get", lookedUp);
+}
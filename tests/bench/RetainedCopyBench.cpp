@@ -0,0 +1,100 @@
+// The copy passes of RetainedGeometry::Replay on their own. They need no ImGui context, so this
+// runs with the stub. Replay against a full redraw is RetainedGeometryBench, which needs the
+// ImGui sources.
+#include "69/menu/RetainedGeometry.h"
+
+#include "Test.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace menu;
+
+static std::vector<ImDrawVert> MakeVertices(int count)
+{
+    std::vector<ImDrawVert> vertices(count);
+    for (int i = 0; i < count; i++)
+    {
+        vertices[i].pos = ImVec2((float)(i % 380) + 0.25f, (float)(i / 380) * 1.5f);
+        vertices[i].uv = ImVec2((float)i / (float)count, 1.0f - (float)i / (float)count);
+        vertices[i].col = IM_COL32(i & 0xFF, (i * 7) & 0xFF, (i * 13) & 0xFF, (i * 31) & 0xFF);
+    }
+    return vertices;
+}
+
+// What the scalar tail does, for every vertex
+static ImDrawVert TransformReference(const ImDrawVert& vertex, ImVec2 offset, int alphaScale)
+{
+    ImDrawVert out = vertex;
+    out.pos = ImVec2(vertex.pos.x + offset.x, vertex.pos.y + offset.y);
+    ImU32 alpha = (((vertex.col >> IM_COL32_A_SHIFT) & 0xFF) * alphaScale) >> 8;
+    out.col = (vertex.col & ~IM_COL32_A_MASK) | (alpha << IM_COL32_A_SHIFT);
+    return out;
+}
+
+// SIMD blocks and scalar tails, for every count around a block boundary
+TEST(TransformMatchesReference)
+{
+    const ImVec2 offset(3.5f, -2.0f);
+    for (int count = 0; count <= 13; count++)
+    {
+        for (int alphaScale : {0, 1, 128, 255, 256})
+        {
+            std::vector<ImDrawVert> src = MakeVertices(count);
+            std::vector<ImDrawVert> dst(count);
+            retained::TransformVertices(src.data(), dst.data(), count, offset, alphaScale);
+            for (int i = 0; i < count; i++)
+            {
+                ImDrawVert expected = TransformReference(src[i], offset, alphaScale);
+                CHECK(dst[i].pos.x == expected.pos.x && dst[i].pos.y == expected.pos.y);
+                CHECK(dst[i].uv.x == expected.uv.x && dst[i].uv.y == expected.uv.y);
+                CHECK(dst[i].col == expected.col);
+            }
+        }
+    }
+}
+
+TEST(RebaseMatchesReference)
+{
+    for (int count = 0; count <= 17; count++)
+    {
+        std::vector<ImDrawIdx> src(count), dst(count);
+        for (int i = 0; i < count; i++)
+            src[i] = (ImDrawIdx)(i * 3);
+        retained::RebaseIndices(src.data(), dst.data(), count, 1000);
+        for (int i = 0; i < count; i++)
+            CHECK(dst[i] == (ImDrawIdx)(src[i] + 1000));
+    }
+}
+
+// Per replayed frame, for meshes the size of a simple screen and of a busy one
+TEST(CopyTime)
+{
+    for (int vertices : {2000, 8000})
+    {
+        int indices = vertices * 3 / 2;
+        std::vector<ImDrawVert> srcVertices = MakeVertices(vertices);
+        std::vector<ImDrawVert> dstVertices(vertices);
+        std::vector<ImDrawIdx> srcIndices(indices), dstIndices(indices);
+        for (int i = 0; i < indices; i++)
+            srcIndices[i] = (ImDrawIdx)(i % vertices);
+
+        double seconds = test::Measure([&]() {
+            retained::TransformVertices(srcVertices.data(), dstVertices.data(), vertices,
+                                        ImVec2(1, 1), 200);
+            retained::RebaseIndices(srcIndices.data(), dstIndices.data(), indices, 4);
+        });
+        char name[64];
+        snprintf(name, sizeof(name), "%d vertices, %d indices", vertices, indices);
+        test::Report(name, seconds);
+
+        seconds = test::Measure([&]() {
+            for (int i = 0; i < vertices; i++)
+                dstVertices[i] = TransformReference(srcVertices[i], ImVec2(1, 1), 200);
+            for (int i = 0; i < indices; i++)
+                dstIndices[i] = (ImDrawIdx)(srcIndices[i] + 4);
+        });
+        snprintf(name, sizeof(name), "%d vertices, plain loop", vertices);
+        test::Report(name, seconds);
+    }
+}
@@ -0,0 +1,153 @@
+// Replay against a full redraw of a login-like screen. Needs the ImGui sources, the copy passes
+// alone are timed by RetainedCopyBench.
+#include "69/menu/RetainedGeometry.h"
+
+#include "ImGuiFixture.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace menu;
+
+// Roughly what the login screen emits: panel, logo ring, input, button and their labels
+static void DrawScreen(ImDrawList* drawList, float alpha, ImVec2 offset)
+{
+    auto color = [alpha](int r, int g, int b, int a) {
+        return IM_COL32(r, g, b, (int)(a * alpha));
+    };
+    ImFont* font = ImGui::GetFont();
+    float fontSize = ImGui::GetFontSize();
+    ImVec2 o = offset;
+
+    drawList->AddRectFilled(ImVec2(o.x + 20, o.y + 20), ImVec2(o.x + 360, o.y + 500),
+                            color(18, 18, 24, 240), 16.0f);
+    drawList->AddRect(ImVec2(o.x + 20, o.y + 20), ImVec2(o.x + 360, o.y + 500),
+                      color(255, 255, 255, 20), 16.0f);
+    for (int i = 0; i < 6; i++)
+        drawList->AddCircleFilled(ImVec2(o.x + 190, o.y + 150), 60.0f - i * 6.0f,
+                                  color(120, 90, 255, 30));
+    drawList->AddText(font, fontSize * 1.5f, ImVec2(o.x + 120, o.y + 240),
+                      color(255, 255, 255, 255), "69 ImGui Loader");
+    drawList->AddText(font, fontSize, ImVec2(o.x + 90, o.y + 280), color(160, 160, 170, 255),
+                      "Enter your license key to continue");
+
+    drawList->AddRectFilled(ImVec2(o.x + 40, o.y + 320), ImVec2(o.x + 340, o.y + 360),
+                            color(30, 30, 40, 255), 8.0f);
+    drawList->AddText(font, fontSize, ImVec2(o.x + 54, o.y + 332), color(120, 120, 130, 255),
+                      "XXXX-XXXX-XXXX-XXXX");
+    drawList->AddRectFilled(ImVec2(o.x + 40, o.y + 376), ImVec2(o.x + 340, o.y + 416),
+                            color(120, 90, 255, 255), 8.0f);
+    drawList->AddText(font, fontSize, ImVec2(o.x + 170, o.y + 388), color(255, 255, 255, 255),
+                      "Login");
+}
+
+static void ResetList(ImDrawList& drawList)
+{
+    drawList._ResetForNewFrame();
+    drawList.PushClipRectFullScreen();
+    drawList.PushTexture(ImGui::GetIO().Fonts->TexRef);
+}
+
+static int CountElements(const ImDrawList& drawList)
+{
+    int count = 0;
+    for (const ImDrawCmd& cmd : drawList.CmdBuffer)
+        count += (int)cmd.ElemCount;
+    return count;
+}
+
+// A replay faded to 0.5 and moved matches the screen drawn at 0.5 and moved: same mesh,
+// alpha off by the 8-bit rounding of the scale at most
+TEST(ReplayMatchesRedraw)
+{
+    ImGuiFixture fixture;
+    fixture.NewFrame();
+
+    ImDrawList recorded(ImGui::GetDrawListSharedData());
+    ImDrawList drawn(ImGui::GetDrawListSharedData());
+    ImDrawList replayed(ImGui::GetDrawListSharedData());
+    ResetList(recorded);
+    ResetList(drawn);
+    ResetList(replayed);
+
+    RetainedGeometry geometry;
+    geometry.BeginRecord(&recorded);
+    DrawScreen(&recorded, 1.0f, ImVec2(0, 0));
+    geometry.EndRecord(&recorded, 1.0f, ImVec2(0, 0));
+    CHECK(geometry.IsValid());
+
+    DrawScreen(&drawn, 0.5f, ImVec2(3, -2));
+    CHECK(geometry.Replay(&replayed, 0.5f, ImVec2(3, -2)));
+
+    // Fading in past the recorded alpha has to draw again
+    ImDrawList unused(ImGui::GetDrawListSharedData());
+    ResetList(unused);
+    CHECK(!geometry.Replay(&unused, 1.0f, ImVec2(0, 0)));
+    CHECK(geometry.Replay(&unused, 0.9f, ImVec2(0, 0)));
+
+    CHECK(drawn.VtxBuffer.Size == replayed.VtxBuffer.Size);
+    CHECK(drawn.IdxBuffer.Size == replayed.IdxBuffer.Size);
+    CHECK(CountElements(drawn) == CountElements(replayed));
+    if (drawn.VtxBuffer.Size != replayed.VtxBuffer.Size ||
+        drawn.IdxBuffer.Size != replayed.IdxBuffer.Size)
+        return;
+
+    int positionErrors = 0, maxAlphaError = 0;
+    for (int i = 0; i < drawn.VtxBuffer.Size; i++)
+    {
+        const ImDrawVert& a = drawn.VtxBuffer[i];
+        const ImDrawVert& b = replayed.VtxBuffer[i];
+        if (std::fabs(a.pos.x - b.pos.x) > 1e-3f || std::fabs(a.pos.y - b.pos.y) > 1e-3f ||
+            a.uv.x != b.uv.x || a.uv.y != b.uv.y)
+            positionErrors++;
+        CHECK((a.col & ~IM_COL32_A_MASK) == (b.col & ~IM_COL32_A_MASK));
+        int alphaA = (int)(a.col >> IM_COL32_A_SHIFT);
+        int alphaB = (int)(b.col >> IM_COL32_A_SHIFT);
+        maxAlphaError = std::max(maxAlphaError, std::abs(alphaA - alphaB));
+    }
+    CHECK(positionErrors == 0);
+    CHECK(maxAlphaError <= 1);
+
+    int indexErrors = 0;
+    for (int i = 0; i < drawn.IdxBuffer.Size; i++)
+        indexErrors += drawn.IdxBuffer[i] != replayed.IdxBuffer[i];
+    CHECK(indexErrors == 0);
+
+    fixture.Render();
+}
+
+// Tessellating the screen again against copying the recording, per frame
+TEST(ReplayAgainstRedraw)
+{
+    ImGuiFixture fixture;
+    fixture.NewFrame();
+
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    ResetList(drawList);
+
+    RetainedGeometry geometry;
+    geometry.BeginRecord(&drawList);
+    DrawScreen(&drawList, 1.0f, ImVec2(0, 0));
+    geometry.EndRecord(&drawList, 1.0f, ImVec2(0, 0));
+    CHECK(geometry.IsValid());
+    printf("  %d vertices, %d indices\n", drawList.VtxBuffer.Size, drawList.IdxBuffer.Size);
+
+    float alpha = 1.0f;
+    double redraw = test::Measure([&]() {
+        ResetList(drawList);
+        DrawScreen(&drawList, alpha, ImVec2(1, 1));
+        alpha = alpha > 0.1f ? alpha - 0.01f : 1.0f;
+    });
+    double replay = test::Measure([&]() {
+        ResetList(drawList);
+        geometry.Replay(&drawList, alpha, ImVec2(1, 1));
+        alpha = alpha > 0.1f ? alpha - 0.01f : 1.0f;
+    });
+    test::Report("full redraw", redraw);
+    test::Report("replay", replay);
+
+    fixture.Render();
+}
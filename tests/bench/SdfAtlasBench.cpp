@@ -0,0 +1,113 @@
+// What SdfAtlas changes in the draw data of the login input (neon focus rect) and the result
+// screen (ring), against the tessellated outlines it replaces: CollectDrawStats numbers and the
+// time to emit the geometry. The baked textures are separate from the font atlas, so fewer
+// vertices come with more texture changes.
+#include "69/menu/DrawStats.h"
+#include "69/menu/SdfAtlas.h"
+
+#include "ImGuiFixture.h"
+#include "Test.h"
+
+#include <cstdio>
+#include <functional>
+
+using namespace menu;
+
+static const ImU32 ACCENT = IM_COL32(120, 90, 255, 255);
+static const ImVec2 INPUT_MIN(40, 320);
+static const ImVec2 INPUT_MAX(340, 360);
+static const ImVec2 RING_CENTER(190, 230);
+
+// DrawNeonRect's fallback in Menu.cpp at the highest quality (3 layers)
+static void DrawLayeredNeonRect(ImDrawList* drawList)
+{
+    drawList->AddRect(INPUT_MIN, INPUT_MAX, (ACCENT & 0x00FFFFFF) | (40u << 24), 8.0f, 0, 7.0f);
+    drawList->AddRect(INPUT_MIN, INPUT_MAX, (ACCENT & 0x00FFFFFF) | (80u << 24), 8.0f, 0, 3.0f);
+    drawList->AddRect(INPUT_MIN, INPUT_MAX, (ACCENT & 0x00FFFFFF) | (200u << 24), 8.0f, 0, 1.0f);
+}
+
+// Input background, glow, then text as DrawInput orders them
+static void DrawInput(ImDrawList* drawList, const std::function<void(ImDrawList*)>& glow)
+{
+    drawList->AddRectFilled(INPUT_MIN, INPUT_MAX, IM_COL32(30, 30, 40, 255), 8.0f);
+    glow(drawList);
+    drawList->AddText(ImVec2(INPUT_MIN.x + 14, INPUT_MIN.y + 12), IM_COL32(200, 200, 210, 255),
+                      "XXXX-XXXX-XXXX-XXXX");
+}
+
+// Ring, then the checkmark and caption as DrawResultScreen orders them
+static void DrawResult(ImDrawList* drawList, const std::function<void(ImDrawList*)>& ring)
+{
+    ring(drawList);
+    drawList->AddLine(ImVec2(RING_CENTER.x - 20, RING_CENTER.y + 5),
+                      ImVec2(RING_CENTER.x - 5, RING_CENTER.y + 20), ACCENT, 4.0f);
+    drawList->AddLine(ImVec2(RING_CENTER.x - 5, RING_CENTER.y + 20),
+                      ImVec2(RING_CENTER.x + 20, RING_CENTER.y - 15), ACCENT, 4.0f);
+    drawList->AddText(ImVec2(RING_CENTER.x - 40, RING_CENTER.y + 60),
+                      IM_COL32(255, 255, 255, 255), "Success");
+}
+
+static DrawStats DrawAndReport(ImGuiFixture& fixture, const char* name,
+                               const std::function<void(ImDrawList*)>& draw)
+{
+    fixture.NewFrame();
+    draw(ImGui::GetBackgroundDrawList());
+    DrawStats stats = CollectDrawStats(fixture.Render());
+    printf("  %-28s %d commands, %d vertices, %d indices, %d texture changes\n", name,
+           stats.Commands, stats.Vertices, stats.Indices, stats.TextureChanges);
+
+    // Emitting the geometry alone, into a list of its own
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    double seconds = test::Measure([&]() {
+        drawList._ResetForNewFrame();
+        drawList.PushClipRectFullScreen();
+        drawList.PushTexture(ImGui::GetIO().Fonts->TexRef);
+        draw(&drawList);
+    });
+    test::Report(name, seconds);
+    return stats;
+}
+
+TEST(NeonRectDrawStats)
+{
+    ImGuiFixture fixture;
+    fixture.NewFrame();
+    fixture.Render();
+
+    SdfAtlas atlas;
+    atlas.SetTextureFactory(&fixture.GetTextures());
+    atlas.WarmNeonRect(1.0f, 8.0f, 3);
+
+    DrawStats layered = DrawAndReport(fixture, "login input, outlines", [](ImDrawList* drawList) {
+        DrawInput(drawList, DrawLayeredNeonRect);
+    });
+    DrawStats baked = DrawAndReport(fixture, "login input, baked", [&](ImDrawList* drawList) {
+        DrawInput(drawList, [&](ImDrawList* list) {
+            CHECK(atlas.DrawNeonRect(list, INPUT_MIN, INPUT_MAX, ACCENT, 1.0f, 1.0f, 8.0f, 3));
+        });
+    });
+    CHECK(baked.Vertices < layered.Vertices);
+}
+
+TEST(RingDrawStats)
+{
+    ImGuiFixture fixture;
+    fixture.NewFrame();
+    fixture.Render();
+
+    SdfAtlas atlas;
+    atlas.SetTextureFactory(&fixture.GetTextures());
+    atlas.WarmRing(40.0f, 4.0f);
+
+    DrawStats layered = DrawAndReport(fixture, "result ring, outline", [](ImDrawList* drawList) {
+        DrawResult(drawList, [](ImDrawList* list) {
+            list->AddCircle(RING_CENTER, 40.0f, ACCENT, 0, 4.0f);
+        });
+    });
+    DrawStats baked = DrawAndReport(fixture, "result ring, baked", [&](ImDrawList* drawList) {
+        DrawResult(drawList, [&](ImDrawList* list) {
+            CHECK(atlas.DrawRing(list, RING_CENTER, 40.0f, ACCENT, 4.0f));
+        });
+    });
+    CHECK(baked.Vertices < layered.Vertices);
+}
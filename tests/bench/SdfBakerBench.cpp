@@ -0,0 +1,95 @@
+#include "69/menu/SdfBaker.h"
+
+#include "69/menu/Raster.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace menu;
+
+// DrawNeonRect glow, 3 layers at 1 px (see SdfAtlas.cpp)
+static const raster::Stroke NEON_STROKES[3] = {
+    {7.0f, 40.0f / 255.0f}, {3.0f, 80.0f / 255.0f}, {1.0f, 200.0f / 255.0f}};
+static const raster::Stroke RING_STROKE = {4.0f, 1.0f};
+
+// Plain per-pixel version of the bake
+static std::vector<unsigned char> BakeReference(int width, int height, float hx, float hy,
+                                                float r, const raster::Stroke* strokes,
+                                                int strokeCount)
+{
+    std::vector<unsigned char> alpha((size_t)width * height);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            float d = std::fabs(raster::RoundedRectDistance((float)x + 0.5f, (float)y + 0.5f,
+                                                            width * 0.5f, height * 0.5f, hx, hy,
+                                                            r));
+            float keep = 1.0f;
+            for (int i = 0; i < strokeCount; i++)
+                keep *= 1.0f - strokes[i].Alpha * raster::Coverage(d - strokes[i].Width * 0.5f);
+            alpha[(size_t)y * width + x] = (unsigned char)(int)((1.0f - keep) * 255.0f + 0.5f);
+        }
+    }
+    return alpha;
+}
+
+static int CompareToReference(int width, int height, float hx, float hy, float r,
+                              const raster::Stroke* strokes, int strokeCount)
+{
+    std::vector<unsigned char> rgba((size_t)width * height * 4);
+    raster::BakeRoundedRectStrokes(rgba.data(), width, height, hx, hy, r, strokes, strokeCount);
+    std::vector<unsigned char> reference =
+        BakeReference(width, height, hx, hy, r, strokes, strokeCount);
+
+    int maxError = 0;
+    for (size_t i = 0; i < reference.size(); i++)
+    {
+        if (rgba[i * 4] != 255 || rgba[i * 4 + 1] != 255 || rgba[i * 4 + 2] != 255)
+            maxError = 255;
+        maxError = std::max(maxError, std::abs(rgba[i * 4 + 3] - reference[i]));
+    }
+    return maxError;
+}
+
+// SIMD rows, scalar tails and the threaded split all bake the same pixels
+TEST(BakeMatchesReference)
+{
+    CHECK(CompareToReference(30, 30, 9.0f, 9.0f, 8.0f, NEON_STROKES, 3) <= 1);
+    CHECK(CompareToReference(88, 88, 39.5f, 39.5f, 39.5f, &RING_STROKE, 1) <= 1);
+    CHECK(CompareToReference(37, 23, 12.0f, 6.0f, 4.0f, NEON_STROKES, 3) <= 1);
+    CHECK(CompareToReference(515, 301, 240.0f, 140.0f, 16.0f, NEON_STROKES, 3) <= 1);
+}
+
+// What LoadTexture warms at startup: the neon rect of every quality tier and the result ring
+TEST(StartupBakeTime)
+{
+    std::vector<unsigned char> neon(30 * 30 * 4), ring(88 * 88 * 4);
+    double seconds = test::Measure([&]() {
+        for (int layers = 1; layers <= 3; layers++)
+            raster::BakeRoundedRectStrokes(neon.data(), 30, 30, 9.0f, 9.0f, 8.0f,
+                                           NEON_STROKES + 3 - layers, layers);
+        raster::BakeRoundedRectStrokes(ring.data(), 88, 88, 39.5f, 39.5f, 39.5f, &RING_STROKE, 1);
+    });
+    test::Report("startup bakes", seconds);
+}
+
+// Past THREAD_MIN_PIXELS the rows are split over threads
+TEST(LargeBakeTime)
+{
+    std::vector<unsigned char> rgba(512 * 512 * 4);
+    double seconds = test::Measure([&]() {
+        raster::BakeRoundedRectStrokes(rgba.data(), 512, 512, 240.0f, 240.0f, 16.0f,
+                                       NEON_STROKES, 3);
+    });
+    test::Report("512x512 3 strokes", seconds);
+
+    seconds = test::Measure([&]() {
+        BakeReference(512, 512, 240.0f, 240.0f, 16.0f, NEON_STROKES, 3);
+    });
+    test::Report("512x512 3 strokes, plain loop", seconds);
+}
@@ -0,0 +1,140 @@
+#include "69/core/FrameGovernor.h"
+
+#include "Test.h"
+
+#include <cmath>
+#include <cstdio>
+
+using core::FrameGovernor;
+using Mode = FrameGovernor::Mode;
+
+static const double VSYNC = 1.0 / 60.0;
+
+// The frame loop of Main.cpp on a fake clock: block for the governor's timeout, render, then
+// Present waits for the next vsync
+struct FakeLoop
+{
+    FrameGovernor Governor;
+    double Now = 0.0;
+    int Frames = 0;
+    int BackToBack = 0; // Frames the quality controller would sample
+    bool Blocked = false;
+
+    void Run(double seconds)
+    {
+        double end = Now + seconds;
+        bool renderedLast = false;
+        Blocked = false;
+        while (Now < end)
+        {
+            double timeout = Governor.GetWaitTimeout(Now);
+            if (timeout < 0.0)
+            {
+                // Nothing renders until a message comes
+                Blocked = true;
+                Now = end;
+                break;
+            }
+
+            BackToBack += renderedLast && timeout == 0.0;
+            Now += timeout;
+            double frameStart = Now;
+            Now = (std::floor(Now / VSYNC + 1e-6) + 1.0) * VSYNC;
+            Frames++;
+            Governor.FrameRendered(frameStart);
+            renderedLast = true;
+        }
+    }
+
+    void Idle()
+    {
+        Governor.SetAnimating(false);
+        Governor.SetAmbientAnimating(false);
+    }
+};
+
+// Rendered frames per second of 10 s, within a frame
+static bool HasRate(int frames, double rate)
+{
+    printf("  %d frames, expected %.0f\n", frames, rate * 10.0);
+    return std::fabs(frames - rate * 10.0) <= 1.0;
+}
+
+// Something animating: every vsync, all of them sampled for the quality tier
+TEST(AnimatingRendersEveryVsync)
+{
+    FakeLoop loop;
+    loop.Run(10.0);
+    CHECK(loop.Governor.GetMode(loop.Now) == Mode::FULL_RATE);
+    CHECK(HasRate(loop.Frames, 60.0));
+    CHECK(loop.BackToBack == loop.Frames - 1);
+}
+
+// Background blobs only: 30 fps focused, 10 fps in the background, never sampled
+TEST(AmbientMotionIsThrottled)
+{
+    FakeLoop loop;
+    loop.Governor.SetAnimating(false);
+    loop.Run(1.0);
+
+    int start = loop.Frames;
+    int sampled = loop.BackToBack;
+    loop.Run(10.0);
+    CHECK(loop.Governor.GetMode(loop.Now) == Mode::REDUCED_RATE);
+    CHECK(HasRate(loop.Frames - start, 30.0));
+
+    loop.Governor.SetFocused(false);
+    start = loop.Frames;
+    loop.Run(10.0);
+    CHECK(HasRate(loop.Frames - start, 10.0));
+    CHECK(loop.BackToBack == sampled);
+}
+
+// Nothing moving: no frame until input
+TEST(IdleWaitsForInput)
+{
+    FakeLoop loop;
+    loop.Idle();
+    loop.Run(10.0);
+    CHECK(loop.Blocked);
+    CHECK(loop.Governor.GetMode(loop.Now) == Mode::WAIT_FOR_INPUT);
+    CHECK(loop.Governor.GetWaitTimeout(loop.Now) < 0.0);
+}
+
+// Input keeps every vsync for half a second, so hover and click tweens can start
+TEST(InputGivesFullRateForAWhile)
+{
+    FakeLoop loop;
+    loop.Idle();
+    loop.Run(10.0);
+
+    loop.Governor.NotifyInput(loop.Now);
+    double inputTime = loop.Now;
+    int start = loop.Frames;
+    CHECK(loop.Governor.GetMode(inputTime + 0.49) == Mode::FULL_RATE);
+    CHECK(loop.Governor.GetMode(inputTime + 0.51) == Mode::WAIT_FOR_INPUT);
+
+    loop.Run(1.0);
+    CHECK(loop.Blocked);
+    CHECK(std::abs(loop.Frames - start - 30) <= 1);
+}
+
+// Minimized waits whatever animates, occluded polls 4 times a second for the window to return
+TEST(HiddenWindowRendersNothing)
+{
+    FakeLoop loop;
+    loop.Governor.SetMinimized(true);
+    loop.Run(10.0);
+    CHECK(loop.Blocked);
+    CHECK(loop.Frames == 0);
+
+    loop.Governor.SetMinimized(false);
+    loop.Governor.SetOccluded(true);
+    loop.Governor.FrameRendered(loop.Now);
+    CHECK(loop.Governor.GetMode(loop.Now) == Mode::WAIT_FOR_INPUT);
+    CHECK(std::fabs(loop.Governor.GetWaitTimeout(loop.Now) - 0.25) < 1e-9);
+    CHECK(loop.Governor.GetWaitTimeout(loop.Now + 0.3) == 0.0);
+
+    loop.Run(10.0);
+    CHECK(HasRate(loop.Frames, 4.0));
+}
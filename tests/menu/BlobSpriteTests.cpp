@@ -0,0 +1,225 @@
+#include "69/menu/BlobSprite.h"
+
+#include "69/menu/Theme.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace menu;
+
+// The immediate-mode blob the sprite replaced (Menu.cpp before the sprite): a 20 layer black
+// DrawBlurShadow then 24 shrinking AddCircleFilled in the blob color, blended one after the
+// other like the DX11 backend does. Coverage is measured on a 8x8 grid of samples per pixel,
+// independently of the analytic fringe BlobSprite::Bake uses.
+struct Layer
+{
+    bool Circle;
+    float HalfX, HalfY, CenterY, Rounding; // Rounded rect, relative to the blob center
+    float Radius;                          // Circle
+    float R, G, B, A;                      // Vertex color
+};
+
+static std::vector<Layer> MakeLayers(float size, const ImVec4& color)
+{
+    std::vector<Layer> layers;
+
+    // DrawBlurShadow(drawList, pos, pos, size, 20, size, 0.3f)
+    for (int i = 0; i < 20; i++)
+    {
+        float factor = (float)i / 20.0f;
+        float expansion = size * factor;
+        float op = (1.0f - factor) * (1.0f - factor);
+        int layerAlpha = (int)(theme::BLUR_STRENGTH * op * 0.3f);
+
+        // AddRectFilled(pos - e + (0, 4), pos + e + (0, 8)), rounding clamped like ImGui does
+        float width = expansion * 2.0f;
+        float height = expansion * 2.0f + 4.0f;
+        float rounding = std::min(size + expansion, std::min(width, height) * 0.5f - 1.0f);
+        layers.push_back({false, expansion, height * 0.5f, 6.0f, std::max(rounding, 0.0f), 0.0f,
+                          0.0f, 0.0f, 0.0f, layerAlpha / 255.0f});
+    }
+
+    // AddCircleFilled(pos, r, FadeColor(color, (1 - f) * 0.1)), alpha packed to 8 bits
+    for (int i = 0; i < 24; i++)
+    {
+        float f = (float)i / 24.0f;
+        float alpha = (float)theme::ToByte(color.w * (1.0f - f) * 0.1f) / 255.0f;
+        layers.push_back({true, 0.0f, 0.0f, 0.0f, 0.0f, size * (1.0f - f * 0.5f), color.x, color.y,
+                          color.z, alpha});
+    }
+    return layers;
+}
+
+static bool IsInside(const Layer& layer, float x, float y)
+{
+    if (layer.Circle)
+        return x * x + y * y <= layer.Radius * layer.Radius;
+
+    float qx = std::fabs(x) - (layer.HalfX - layer.Rounding);
+    float qy = std::fabs(y - layer.CenterY) - (layer.HalfY - layer.Rounding);
+    if (qx <= 0.0f || qy <= 0.0f)
+        return qx <= layer.Rounding && qy <= layer.Rounding;
+    return qx * qx + qy * qy <= layer.Rounding * layer.Rounding;
+}
+
+// Render target pixel, 8-bit (rounded after every blend) or exact
+struct Target
+{
+    float Color[4] = {};
+    bool Quantized = true;
+};
+
+static float Quantize(const Target& target, float value)
+{
+    if (!target.Quantized)
+        return value;
+    return std::round(std::clamp(value, 0.0f, 1.0f) * 255.0f) / 255.0f;
+}
+
+// Alpha over, alpha channel ONE / INV_SRC_ALPHA
+static void Blend(Target& target, float r, float g, float b, float a)
+{
+    float* dst = target.Color;
+    dst[0] = Quantize(target, r * a + dst[0] * (1.0f - a));
+    dst[1] = Quantize(target, g * a + dst[1] * (1.0f - a));
+    dst[2] = Quantize(target, b * a + dst[2] * (1.0f - a));
+    dst[3] = Quantize(target, a + dst[3] * (1.0f - a));
+}
+
+static void DrawLayers(const std::vector<Layer>& layers, float x, float y, Target& target)
+{
+    static const int SAMPLES = 8;
+    for (const Layer& layer : layers)
+    {
+        int inside = 0;
+        for (int sy = 0; sy < SAMPLES; sy++)
+        {
+            for (int sx = 0; sx < SAMPLES; sx++)
+            {
+                float px = x - 0.5f + ((float)sx + 0.5f) / SAMPLES;
+                float py = y - 0.5f + ((float)sy + 0.5f) / SAMPLES;
+                inside += IsInside(layer, px, py);
+            }
+        }
+
+        float coverage = (float)inside / (SAMPLES * SAMPLES);
+        if (coverage > 0.0f)
+            Blend(target, layer.R, layer.G, layer.B, layer.A * coverage);
+    }
+}
+
+// How the menu draws a cell: one quad tinted with the blob color at full fade alpha
+static void DrawSprite(const unsigned char* texel, const ImVec4& color, Target& target)
+{
+    float share = texel[0] / 255.0f;
+    Blend(target, share * color.x, share * color.y, share * color.z, texel[3] / 255.0f);
+}
+
+static int GetError(const Target& drawn, const Target& expected, int channel)
+{
+    return std::abs((int)std::lround((drawn.Color[channel] - expected.Color[channel]) * 255.0f));
+}
+
+// Per pixel, at a bake scale of 1 (one texel per screen pixel, no filtering in between).
+// Against the exact composite of the layers the sprite is off by its own 8-bit rounding. The
+// layered draw itself rounded in the target after each of its 44 layers, which puts it up to
+// a few steps away from both.
+TEST(BakedSpriteMatchesLayeredDraw)
+{
+    struct Blob
+    {
+        float Size;
+        ImVec4 Color;
+    };
+    const Blob blobs[] = {{160.0f, theme::BLOB_1}, {190.0f, theme::BLOB_2}, {140.0f, theme::BLOB_3}};
+
+    BlobSprite sprite;
+    for (const Blob& blob : blobs)
+        sprite.AddBlob(blob.Size, blob.Color.w);
+    sprite.Bake(1.0f);
+    CHECK(sprite.GetPixels() != nullptr);
+
+    int column = 0;
+    for (const Blob& blob : blobs)
+    {
+        std::vector<Layer> layers = MakeLayers(blob.Size, blob.Color);
+
+        // The cell is Extent * 2 texels wide, centered on the blob
+        float extent = blob.Size + 10.0f;
+        int side = (int)std::ceil(extent * 2.0f);
+        int maxError = 0, maxLayeredError = 0;
+        long long totalError = 0, totalLayeredError = 0;
+        for (int py = 0; py < side; py++)
+        {
+            for (int px = 0; px < side; px++)
+            {
+                float x = (float)px + 0.5f - extent;
+                float y = (float)py + 0.5f - extent;
+
+                Target exact, layered;
+                exact.Quantized = false;
+                DrawLayers(layers, x, y, exact);
+                DrawLayers(layers, x, y, layered);
+
+                Target drawn;
+                const unsigned char* texel =
+                    sprite.GetPixels() + ((size_t)py * sprite.GetWidth() + column + px) * 4;
+                DrawSprite(texel, blob.Color, drawn);
+
+                for (int c = 0; c < 4; c++)
+                {
+                    int error = GetError(drawn, exact, c);
+                    int layeredError = GetError(drawn, layered, c);
+                    maxError = std::max(maxError, error);
+                    maxLayeredError = std::max(maxLayeredError, layeredError);
+                    totalError += error;
+                    totalLayeredError += layeredError;
+                }
+            }
+        }
+
+        double samples = (double)side * side * 4;
+        printf("  size %.0f: exact max %d mean %.3f, 8-bit layers max %d mean %.3f\n", blob.Size,
+               maxError, totalError / samples, maxLayeredError, totalLayeredError / samples);
+        CHECK(maxError <= 1);
+        CHECK(totalError / samples < 0.15);
+        CHECK(maxLayeredError <= 8);
+        CHECK(totalLayeredError / samples < 3.0);
+        column += side + 1;
+    }
+}
+
+// Reduced resolution keeps the same falloff, only resampled
+TEST(HalfScaleBakeKeepsTheFalloff)
+{
+    BlobSprite full, half;
+    full.AddBlob(160.0f, 0.1f);
+    half.AddBlob(160.0f, 0.1f);
+    full.Bake(1.0f);
+    half.Bake(0.5f);
+
+    CHECK(half.GetWidth() == full.GetWidth() / 2 + 1);
+    CHECK(half.GetHeight() == full.GetHeight() / 2);
+
+    int maxError = 0;
+    for (int y = 0; y < half.GetHeight(); y++)
+    {
+        for (int x = 0; x < half.GetHeight(); x++)
+        {
+            // The half scale texel sits where 2x2 full scale texels meet
+            const unsigned char* texel = half.GetPixels() + ((size_t)y * half.GetWidth() + x) * 4;
+            int alpha = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                int fx = x * 2 + (i & 1);
+                int fy = y * 2 + (i >> 1);
+                alpha += full.GetPixels()[((size_t)fy * full.GetWidth() + fx) * 4 + 3];
+            }
+            maxError = std::max(maxError, std::abs(texel[3] - (alpha + 2) / 4));
+        }
+    }
+    CHECK(maxError <= 3);
+}
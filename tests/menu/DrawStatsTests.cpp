@@ -0,0 +1,59 @@
+#include "69/menu/DrawStats.h"
+
+#include "Test.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace menu;
+
+static std::string ReadFile(const char* path)
+{
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+// Value of "key" in the object starting at section ("avg" / "max") of a state
+static double FindValue(const std::string& json, const char* state, const char* section,
+                        const char* key)
+{
+    size_t at = json.find(std::string("\"") + state + "\"");
+    at = json.find(std::string("\"") + section + "\"", at);
+    at = json.find(std::string("\"") + key + "\": ", at);
+    if (at == std::string::npos)
+        return -1.0;
+    return atof(json.c_str() + at + strlen(key) + 4);
+}
+
+// Hours of heavy frames add up past INT_MAX, the average must not wrap
+TEST(TotalsDontOverflow)
+{
+    DrawStats frame;
+    frame.Vertices = INT_MAX / 2;
+    frame.Indices = INT_MAX;
+    frame.CpuMs = 2.0;
+
+    DrawStatsRecorder recorder;
+    for (int i = 0; i < 5; i++)
+        recorder.Record(AppState::MAIN_MENU, frame);
+    recorder.Record(AppState::LOGIN, DrawStats());
+
+    const char* path = "DrawStatsTests.json";
+    CHECK(recorder.WriteJson(path));
+    std::string json = ReadFile(path);
+    remove(path);
+
+    CHECK(FindValue(json, "MAIN_MENU", "avg", "vertices") == (double)(INT_MAX / 2));
+    CHECK(FindValue(json, "MAIN_MENU", "avg", "indices") == (double)INT_MAX);
+    CHECK(FindValue(json, "MAIN_MENU", "max", "indices") == (double)INT_MAX);
+    CHECK(FindValue(json, "MAIN_MENU", "avg", "cpu_ms") == 2.0);
+    CHECK(FindValue(json, "LOGIN", "avg", "vertices") == 0.0);
+    CHECK(json.find("LAUNCHING") == std::string::npos);
+}
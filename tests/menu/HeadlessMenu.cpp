@@ -0,0 +1,368 @@
+// Headless run of the menu through every AppState: a wrong key and back to login, the right
+// key, main menu, launch, quit. Offline and cached logins the server refuses as well.
+// Fixed frame steps, clicks and typing as ImGui input events, draw statistics per state
+// written to headless_draw_stats.json like --draw-stats does.
+// Launching and quitting can't be undone (Menu.cpp keeps it in a static), that test runs last.
+#include "69/menu/DrawStats.h"
+#include "69/menu/Menu.h"
+#include "69/resource/fonts/FontAwesome.h"
+#include "69/resource/fonts/FontPrompt.h"
+#include "69/resource/fonts/IconsFontAwesome.h"
+
+#include "ImGuiFixture.h"
+#include "Test.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace menu;
+
+static const char* VALID_KEY = "69-TEST-KEY";
+static const char* REVOKED_KEY = "69-REVOKED-KEY"; // Offline token still valid, server refuses
+static const float FRAME_TIME = 1.0f / 60.0f;
+
+// Item labels of Menu::DrawLoginScreen and DrawMainMenu, found through ImGuiFixture::GetItemRect
+static const char* LICENSE_INPUT = "##input";
+static const char* CONFIRM_BUTTON = "ยืนยัน";
+static const char* LAUNCH_BUTTON = "เปิดใช้งาน";
+
+// Answers at once: only VALID_KEY is licensed, to one product. REVOKED_KEY logs in offline and
+// its revalidation is refused once ReleaseRevalidation() is called. SetCachedLogin() stands in
+// for the login cache the menu opens on.
+class StandInService final : public service::IService
+{
+  public:
+    service::LoginBundle Login(const std::string& licenseKey,
+                               const service::CancellationToken&) override
+    {
+        service::LoginBundle bundle;
+        bool licensed = licenseKey == VALID_KEY || licenseKey == REVOKED_KEY;
+        bundle.Result = licensed ? service::OperationResult::SUCCESS
+                                 : service::OperationResult::DENIED;
+        if (licensed)
+        {
+            bundle.Subscriptions.push_back({"default", "2099-01-01"});
+            bundle.Software.push_back({"Stand-in", 0, 1});
+            bundle.Offline = licenseKey == REVOKED_KEY;
+        }
+        return bundle;
+    }
+
+    bool GetCachedLogin(std::string& licenseKey, service::LoginBundle& bundle) override
+    {
+        if (m_CachedKey.empty())
+            return false;
+        licenseKey = m_CachedKey;
+        bundle = Login(m_CachedKey, service::CancellationToken());
+        bundle.Offline = false;
+        return true;
+    }
+
+    void SetCachedLogin(const std::string& licenseKey)
+    {
+        m_CachedKey = licenseKey;
+    }
+
+    service::LoginBundle Revalidate(const std::string& licenseKey,
+                                    const service::CancellationToken& token) override
+    {
+        if (licenseKey != REVOKED_KEY)
+            return Login(licenseKey, token);
+
+        while (!m_RevalidationReleased && !token.ShouldStop())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        service::LoginBundle bundle;
+        bundle.Result = token.ShouldStop() ? token.GetStopResult()
+                                           : service::OperationResult::DENIED;
+        return bundle;
+    }
+
+    void ReleaseRevalidation()
+    {
+        m_RevalidationReleased = true;
+    }
+
+    service::OperationResult ValidateUser(const std::string& licenseKey,
+                                          const service::CancellationToken& token) override
+    {
+        return Login(licenseKey, token).Result;
+    }
+
+    std::vector<service::SoftwareItem> GetAvailableSoftware() override
+    {
+        return {{"Stand-in", 0, 1}};
+    }
+
+    service::OperationResult LaunchSoftware(int, const service::CancellationToken&) override
+    {
+        m_Launched = true;
+        return service::OperationResult::SUCCESS;
+    }
+
+    bool HasLaunched() const
+    {
+        return m_Launched;
+    }
+
+  private:
+    std::string m_CachedKey; // Set before the menu reads it
+    std::atomic<bool> m_Launched{false};
+    std::atomic<bool> m_RevalidationReleased{false};
+};
+
+class Driver
+{
+  public:
+    // A cached login, if any, is there before the menu starts
+    explicit Driver(const char* cachedKey = nullptr) : m_Service(std::make_shared<StandInService>())
+    {
+        if (cachedKey)
+            m_Service->SetCachedLogin(cachedKey);
+
+        // Fonts as the loader loads them, see Main.cpp
+        ImGuiIO& io = ImGui::GetIO();
+        ImFontConfig fontConfig;
+        fontConfig.PixelSnapH = true;
+        fontConfig.FontDataOwnedByAtlas = false;
+        static const ImWchar thaiRanges[] = {0x0020, 0x007E, 0x0E00, 0x0E7F, 0};
+        io.Fonts->AddFontFromMemoryTTF((void*)resource::s_Prompt_ttf, resource::s_Prompt_ttf_len,
+                                       20.0f, &fontConfig, thaiRanges);
+
+        ImFontConfig iconsConfig;
+        iconsConfig.MergeMode = true;
+        iconsConfig.PixelSnapH = true;
+        iconsConfig.FontDataOwnedByAtlas = false;
+        iconsConfig.GlyphMinAdvanceX = 13.0f;
+        static const ImWchar iconsRanges[] = {ICON_MIN_FA, ICON_MAX_FA, 0};
+        io.Fonts->AddFontFromMemoryTTF((void*)resource::s_FontAwesome_ttf,
+                                       resource::s_FontAwesome_ttf_len, 16.0f, &iconsConfig,
+                                       iconsRanges);
+        ImGui::StyleColorsDark();
+
+        m_Menu = std::make_unique<Menu>(m_Service, m_Platform, m_Fixture.GetTextures());
+    }
+
+    ~Driver()
+    {
+        // Before the context and the textures it drew with
+        m_Menu.reset();
+    }
+
+    void Frame()
+    {
+        AppState state = m_Menu->GetState();
+        m_Visited[(int)state] = true;
+
+        auto start = std::chrono::steady_clock::now();
+        m_Fixture.NewFrame(FRAME_TIME);
+        m_Menu->Render(FRAME_TIME);
+        ImDrawData* drawData = m_Fixture.Render();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        DrawStats stats = CollectDrawStats(drawData);
+        stats.CpuMs = elapsed.count();
+        m_Stats.Record(state, stats);
+        m_Frames++;
+
+        // Service answers come from the Executor, let it run
+        if (state == AppState::LOADING || state == AppState::LAUNCHING)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Frames until done() or maxFrames, false on the latter
+    bool RunUntil(const std::function<bool()>& done, int maxFrames = 60 * 30)
+    {
+        for (int i = 0; i < maxFrames; i++)
+        {
+            if (done())
+                return true;
+            Frame();
+        }
+        return done();
+    }
+
+    bool RunUntilState(AppState state)
+    {
+        return RunUntil([this, state]() { return m_Menu->GetState() == state; });
+    }
+
+    // Move there, press, release: one event per frame like a real mouse
+    void Click(float x, float y)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.AddMousePosEvent(x, y);
+        Frame();
+        io.AddMouseButtonEvent(0, true);
+        Frame();
+        io.AddMouseButtonEvent(0, false);
+        Frame();
+    }
+
+    // Center of the item with that label, false if it was never drawn
+    bool Click(const char* label)
+    {
+        ImRect rect;
+        if (!m_Fixture.GetItemRect(label, rect))
+        {
+            printf("  no item %s\n", label);
+            return false;
+        }
+        ImVec2 center = rect.GetCenter();
+        Click(center.x, center.y);
+        return true;
+    }
+
+    void Type(const char* text)
+    {
+        ImGui::GetIO().AddInputCharactersUTF8(text);
+        Frame();
+    }
+
+    bool Login(const char* licenseKey)
+    {
+        if (!Click(LICENSE_INPUT))
+            return false;
+        Type(licenseKey);
+        return Click(CONFIRM_BUTTON);
+    }
+
+    AppState GetState() const
+    {
+        return m_Menu->GetState();
+    }
+    StandInService& GetService()
+    {
+        return *m_Service;
+    }
+    const NullPlatform& GetPlatform() const
+    {
+        return m_Platform;
+    }
+    const DrawStatsRecorder& GetStats() const
+    {
+        return m_Stats;
+    }
+    bool WasVisited(AppState state) const
+    {
+        return m_Visited[(int)state];
+    }
+    int GetFrames() const
+    {
+        return m_Frames;
+    }
+
+  private:
+    ImGuiFixture m_Fixture;
+    NullPlatform m_Platform;
+    std::shared_ptr<StandInService> m_Service;
+    std::unique_ptr<Menu> m_Menu;
+    DrawStatsRecorder m_Stats;
+    bool m_Visited[(int)AppState::LAUNCHING + 1] = {};
+    int m_Frames = 0;
+};
+
+// An offline login reaches the main menu, but launching waits for the server, which refuses it
+TEST(RefusedRevalidationBlocksTheLaunch)
+{
+    Driver driver;
+    for (int i = 0; i < 60; i++)
+        driver.Frame();
+
+    CHECK(driver.Login(REVOKED_KEY));
+    CHECK(driver.RunUntilState(AppState::MAIN_MENU));
+    for (int i = 0; i < 30; i++)
+        driver.Frame();
+    CHECK(driver.Click(LAUNCH_BUTTON));
+    CHECK(driver.RunUntilState(AppState::LAUNCHING));
+
+    // Long past the launch on the progress bar, still waiting
+    for (int i = 0; i < 60 * 5; i++)
+        driver.Frame();
+    CHECK(!driver.GetService().HasLaunched());
+
+    // Refused: logged out through the failed result, nothing launched
+    driver.GetService().ReleaseRevalidation();
+    CHECK(driver.RunUntilState(AppState::RESULT));
+    CHECK(driver.RunUntilState(AppState::LOGIN));
+    CHECK(!driver.GetService().HasLaunched());
+    CHECK(!driver.GetPlatform().HasQuit());
+}
+
+// A cached login opens on the main menu, the server refusing it sends back to login
+TEST(RefusedCachedLoginLogsOut)
+{
+    Driver driver(REVOKED_KEY);
+    driver.Frame();
+    CHECK(driver.WasVisited(AppState::MAIN_MENU));
+    CHECK(!driver.WasVisited(AppState::LOGIN));
+    for (int i = 0; i < 60; i++)
+        driver.Frame();
+    CHECK(driver.GetState() == AppState::MAIN_MENU);
+
+    driver.GetService().ReleaseRevalidation();
+    CHECK(driver.RunUntilState(AppState::RESULT));
+    CHECK(driver.RunUntilState(AppState::LOGIN));
+    CHECK(!driver.GetService().HasLaunched());
+}
+
+// Launching from a cached login waits for the server, which refuses it
+TEST(RefusedCachedLoginBlocksTheLaunch)
+{
+    Driver driver(REVOKED_KEY);
+    for (int i = 0; i < 60; i++)
+        driver.Frame();
+    CHECK(driver.GetState() == AppState::MAIN_MENU);
+    CHECK(driver.Click(LAUNCH_BUTTON));
+    CHECK(driver.RunUntilState(AppState::LAUNCHING));
+
+    for (int i = 0; i < 60 * 5; i++)
+        driver.Frame();
+    CHECK(!driver.GetService().HasLaunched());
+
+    driver.GetService().ReleaseRevalidation();
+    CHECK(driver.RunUntilState(AppState::RESULT));
+    CHECK(driver.RunUntilState(AppState::LOGIN));
+    CHECK(!driver.GetService().HasLaunched());
+    CHECK(!driver.GetPlatform().HasQuit());
+}
+
+TEST(EveryStateIsReached)
+{
+    Driver driver;
+    for (int i = 0; i < 60; i++)
+        driver.Frame();
+
+    // Refused, through the failed result back to login
+    CHECK(driver.Login("WRONG-KEY"));
+    CHECK(driver.RunUntilState(AppState::TRANSITION_TO_LOGIN));
+    CHECK(driver.RunUntilState(AppState::LOGIN));
+
+    // Accepted, through the result to the main menu
+    CHECK(driver.Login(VALID_KEY));
+    CHECK(driver.RunUntilState(AppState::MAIN_MENU));
+
+    // Launch, then the window fades out and quits
+    for (int i = 0; i < 30; i++)
+        driver.Frame();
+    CHECK(driver.Click(LAUNCH_BUTTON));
+    CHECK(driver.RunUntilState(AppState::LAUNCHING));
+    CHECK(driver.RunUntil([&driver]() { return driver.GetPlatform().HasQuit(); }));
+    CHECK(driver.GetService().HasLaunched());
+
+    for (int i = 0; i <= (int)AppState::LAUNCHING; i++)
+    {
+        if (!driver.WasVisited((AppState)i))
+            printf("  never reached %s\n", GetStateName((AppState)i));
+        CHECK(driver.WasVisited((AppState)i));
+    }
+
+    printf("  %d frames\n", driver.GetFrames());
+    CHECK(driver.GetStats().WriteJson("headless_draw_stats.json"));
+}
@@ -0,0 +1,154 @@
+// ImageAtlas in a real font atlas, drawn by SoftwareRenderer: images keep their pixels when the
+// atlas grows and repacks them, and text plus images stay in one draw command.
+#include "69/menu/ImageAtlas.h"
+
+#include "ImGuiFixture.h"
+#include "Test.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace menu;
+
+static const int IMAGE_SIZE = 16;
+static const int IMAGE_COUNT = 6;
+
+// Quadrant q of image index, opaque and different for every image
+static ImU32 GetQuadrantColor(int index, int quadrant)
+{
+    return IM_COL32(40 + index * 30, 60 + quadrant * 50, 200 - index * 20 - quadrant * 10, 255);
+}
+
+static std::vector<ImU32> MakeImage(int index)
+{
+    std::vector<ImU32> pixels(IMAGE_SIZE * IMAGE_SIZE);
+    for (int y = 0; y < IMAGE_SIZE; y++)
+    {
+        for (int x = 0; x < IMAGE_SIZE; x++)
+        {
+            int quadrant = (x >= IMAGE_SIZE / 2) + (y >= IMAGE_SIZE / 2) * 2;
+            pixels[y * IMAGE_SIZE + x] = GetQuadrantColor(index, quadrant);
+        }
+    }
+    return pixels;
+}
+
+// Where image index is drawn, 1:1 on whole pixels so quadrant centers sample exactly
+static ImVec2 GetImagePos(int index)
+{
+    return ImVec2(20.0f + index * (IMAGE_SIZE + 8), 60.0f);
+}
+
+// Text, then every image, on one list
+static void DrawImages(ImDrawList* drawList, const std::vector<ImTextureRef>& textures,
+                       const std::vector<ImVec2>& uv0, const std::vector<ImVec2>& uv1)
+{
+    drawList->AddText(ImVec2(20, 20), IM_COL32(255, 255, 255, 255), "Products");
+    for (int i = 0; i < (int)textures.size(); i++)
+    {
+        ImVec2 pos = GetImagePos(i);
+        drawList->AddImage(textures[i], pos, ImVec2(pos.x + IMAGE_SIZE, pos.y + IMAGE_SIZE),
+                           uv0[i], uv1[i]);
+    }
+}
+
+static int CountCommands(ImDrawData* drawData)
+{
+    int count = 0;
+    for (const ImDrawList* list : drawData->CmdLists)
+    {
+        for (const ImDrawCmd& cmd : list->CmdBuffer)
+            count += cmd.ElemCount > 0 && !cmd.UserCallback;
+    }
+    return count;
+}
+
+// Quadrant centers of every image on screen
+static bool ImagesAreOnScreen(const ImGuiFixture& fixture, int count)
+{
+    bool same = true;
+    for (int i = 0; i < count; i++)
+    {
+        for (int quadrant = 0; quadrant < 4; quadrant++)
+        {
+            ImVec2 pos = GetImagePos(i);
+            int x = (int)pos.x + IMAGE_SIZE / 4 + (quadrant % 2) * IMAGE_SIZE / 2;
+            int y = (int)pos.y + IMAGE_SIZE / 4 + (quadrant / 2) * IMAGE_SIZE / 2;
+            ImU32 pixel = fixture.GetPixel(x, y);
+            if (pixel != GetQuadrantColor(i, quadrant))
+            {
+                printf("  image %d quadrant %d: %08X, expected %08X\n", i, quadrant, pixel,
+                       GetQuadrantColor(i, quadrant));
+                same = false;
+            }
+        }
+    }
+    return same;
+}
+
+TEST(ImagesSurviveTheAtlasGrowing)
+{
+    ImGuiFixture fixture;
+    ImageAtlas images;
+
+    fixture.NewFrame();
+    for (int i = 0; i < IMAGE_COUNT; i++)
+    {
+        std::vector<ImU32> pixels = MakeImage(i);
+        CHECK(images.Add((const unsigned char*)pixels.data(), IMAGE_SIZE, IMAGE_SIZE) == i);
+    }
+    fixture.Render();
+
+    // Large images until the atlas has to grow, which repacks everything in it
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    int width = atlas->TexData->Width;
+    int height = atlas->TexData->Height;
+    std::vector<ImU32> filler(128 * 128, IM_COL32(255, 0, 255, 255));
+    fixture.NewFrame();
+    int added = 0;
+    while (atlas->TexData->Width == width && atlas->TexData->Height == height && added < 64)
+    {
+        CHECK(images.Add((const unsigned char*)filler.data(), 128, 128) >= 0);
+        added++;
+    }
+    CHECK(atlas->TexData->Width * atlas->TexData->Height > width * height);
+    printf("  %dx%d grew to %dx%d after %d images of 128x128\n", width, height,
+           atlas->TexData->Width, atlas->TexData->Height, added);
+
+    std::vector<ImTextureRef> textures(IMAGE_COUNT);
+    std::vector<ImVec2> uv0(IMAGE_COUNT), uv1(IMAGE_COUNT);
+    for (int i = 0; i < IMAGE_COUNT; i++)
+        CHECK(images.Get(i, textures[i], uv0[i], uv1[i]));
+    DrawImages(ImGui::GetBackgroundDrawList(), textures, uv0, uv1);
+    ImDrawData* drawData = fixture.Render();
+
+    CHECK(ImagesAreOnScreen(fixture, IMAGE_COUNT));
+
+    // Glyphs and images come from the same texture: a single command
+    CHECK(CountCommands(drawData) == 1);
+}
+
+// The same images as textures of their own split the list at every texture change
+TEST(SeparateTexturesSplitTheDrawList)
+{
+    ImGuiFixture fixture;
+    fixture.NewFrame();
+    fixture.Render();
+
+    std::vector<ImTextureRef> textures;
+    std::vector<ImVec2> uv0(IMAGE_COUNT, ImVec2(0, 0)), uv1(IMAGE_COUNT, ImVec2(1, 1));
+    for (int i = 0; i < IMAGE_COUNT; i++)
+    {
+        std::vector<ImU32> pixels = MakeImage(i);
+        textures.push_back(fixture.GetTextures().CreateTexture(
+            (const unsigned char*)pixels.data(), IMAGE_SIZE, IMAGE_SIZE));
+    }
+
+    fixture.NewFrame();
+    DrawImages(ImGui::GetBackgroundDrawList(), textures, uv0, uv1);
+    ImDrawData* drawData = fixture.Render();
+
+    CHECK(ImagesAreOnScreen(fixture, IMAGE_COUNT));
+    printf("  %d draw commands for text and %d images\n", CountCommands(drawData), IMAGE_COUNT);
+    CHECK(CountCommands(drawData) == 1 + IMAGE_COUNT);
+}
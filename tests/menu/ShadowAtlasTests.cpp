@@ -0,0 +1,131 @@
+// ShadowAtlas nine-slice shadows against the layered AddRectFilled shadow they replace, both
+// rasterized by SoftwareRenderer from a real ImGui context.
+#include "69/menu/ShadowAtlas.h"
+
+#include "69/menu/Theme.h"
+#include "ImGuiFixture.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace menu;
+
+static const int WIDTH = 200;
+static const int HEIGHT = 160;
+static const ImU32 BACKGROUND = IM_COL32(255, 255, 255, 255);
+
+// The layers are AA-fringed polygons on one side and analytic coverage on the other, the corners
+// are tessellated differently too
+static const int TOLERANCE = 6;
+
+struct Shadow
+{
+    const char* Name;
+    float Spread;
+    int Layers;
+    float Rounding;
+    float Alpha;
+};
+
+// The menu's shadows at every quality tier, plus a square one and a faded one
+static const Shadow SHADOWS[] = {
+    {"glass panel", 15.0f, 15, 12.0f, 1.0f},   {"glass panel, medium", 15.0f, 8, 12.0f, 1.0f},
+    {"glass panel, low", 15.0f, 4, 12.0f, 1.0f}, {"button", 8.0f, 10, 8.0f, 0.6f},
+    {"button, medium", 8.0f, 5, 8.0f, 0.6f},   {"square", 20.0f, 8, 0.0f, 1.0f},
+    {"half faded", 15.0f, 15, 12.0f, 0.5f},
+};
+
+static const ImVec2 RECT_MIN(50, 40);
+static const ImVec2 RECT_MAX(150, 110);
+
+// DrawBlurShadow's fallback loop in Menu.cpp
+static void DrawLayered(ImDrawList* drawList, ImVec2 pMin, ImVec2 pMax, const Shadow& shadow)
+{
+    for (int i = 0; i < shadow.Layers; i++)
+    {
+        float factor = (float)i / (float)shadow.Layers;
+        float expansion = shadow.Spread * factor;
+        float op = (1.0f - factor);
+        op *= op;
+        int layerAlpha = (int)(theme::BLUR_STRENGTH * op * shadow.Alpha);
+
+        drawList->AddRectFilled(ImVec2(pMin.x - expansion, pMin.y + 4.0f - expansion),
+                                ImVec2(pMax.x + expansion, pMax.y + 8.0f + expansion),
+                                IM_COL32(0, 0, 0, layerAlpha), shadow.Rounding + expansion);
+    }
+}
+
+static std::vector<ImU32> CopyPixels(const ImGuiFixture& fixture)
+{
+    std::vector<ImU32> pixels;
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        for (int x = 0; x < WIDTH; x++)
+            pixels.push_back(fixture.GetPixel(x, y));
+    }
+    return pixels;
+}
+
+static int GetDistance(ImU32 a, ImU32 b)
+{
+    int distance = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        int channel = (int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF);
+        distance = std::max(distance, std::abs(channel));
+    }
+    return distance;
+}
+
+TEST(NineSliceMatchesTheLayers)
+{
+    ImGuiFixture fixture(WIDTH, HEIGHT);
+    ShadowAtlas atlas;
+    atlas.SetTextureFactory(&fixture.GetTextures());
+
+    for (const Shadow& shadow : SHADOWS)
+    {
+        fixture.NewFrame();
+        DrawLayered(ImGui::GetBackgroundDrawList(), RECT_MIN, RECT_MAX, shadow);
+        fixture.Render(BACKGROUND);
+        std::vector<ImU32> layered = CopyPixels(fixture);
+
+        fixture.NewFrame();
+        CHECK(atlas.Draw(ImGui::GetBackgroundDrawList(), RECT_MIN, RECT_MAX, shadow.Spread,
+                         shadow.Layers, shadow.Rounding, shadow.Alpha));
+        fixture.Render(BACKGROUND);
+        std::vector<ImU32> sliced = CopyPixels(fixture);
+
+        int different = 0;
+        int worst = 0;
+        for (size_t i = 0; i < layered.size(); i++)
+        {
+            int distance = GetDistance(layered[i], sliced[i]);
+            worst = std::max(worst, distance);
+            different += distance > TOLERANCE;
+        }
+        printf("  %s: worst %d, %d pixels past %d\n", shadow.Name, worst, different, TOLERANCE);
+        CHECK(different == 0);
+    }
+}
+
+// The shadow has to reach the background, or both sides could be drawing nothing
+TEST(ShadowIsVisible)
+{
+    ImGuiFixture fixture(WIDTH, HEIGHT);
+    ShadowAtlas atlas;
+    atlas.SetTextureFactory(&fixture.GetTextures());
+
+    fixture.NewFrame();
+    CHECK(atlas.Draw(ImGui::GetBackgroundDrawList(), RECT_MIN, RECT_MAX, SHADOWS[0].Spread,
+                     SHADOWS[0].Layers, SHADOWS[0].Rounding, SHADOWS[0].Alpha));
+    fixture.Render(BACKGROUND);
+
+    // Under the rect, and past its bottom edge where the shadow is offset to
+    CHECK(GetDistance(fixture.GetPixel(100, 75), BACKGROUND) > 20);
+    CHECK(GetDistance(fixture.GetPixel(100, 120), BACKGROUND) > 0);
+    CHECK(fixture.GetPixel(5, 5) == BACKGROUND);
+}
@@ -0,0 +1,258 @@
+// SoftwareRenderer against a stored reference image. The draw data is built by hand, so the
+// test needs no ImGui context and runs with the stub. After an intended change to the output,
+// look at the new image and rewrite the reference with: SoftwareRendererTests --update
+#include "69/menu/SoftwareRenderer.h"
+
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace menu;
+
+static const int WIDTH = 160;
+static const int HEIGHT = 120; // 3 x 2 tiles, the last ones partial
+static const ImU32 CLEAR_COLOR = IM_COL32(0, 0, 0, 0);
+
+// Two channels may be this far off: bilinear sampling is float math, another compiler may round
+// differently
+static const int TOLERANCE = 2;
+
+static const std::string REFERENCE = std::string(TEST_DATA_DIR) + "/SoftwareRenderer.pam";
+
+// One draw list with every kind of command the menu sends
+class Scene
+{
+  public:
+    explicit Scene(MemoryTextureFactory& textures) : m_List(nullptr)
+    {
+        // 8x8 checker, drawn with uvs past 1 to wrap
+        std::vector<ImU32> checker(8 * 8);
+        for (int y = 0; y < 8; y++)
+        {
+            for (int x = 0; x < 8; x++)
+            {
+                bool light = ((x / 2) + (y / 2)) % 2 == 0;
+                checker[y * 8 + x] =
+                    light ? IM_COL32(240, 230, 200, 255) : IM_COL32(40, 90, 160, 128);
+            }
+        }
+        ImTextureID checkerTexture =
+            textures.CreateTexture((const unsigned char*)checker.data(), 8, 8);
+
+        ImVec4 fullScreen(0.0f, 0.0f, (float)WIDTH, (float)HEIGHT);
+
+        // Background gradient, untextured like ImGui's shapes (uv on the white pixel)
+        AddQuad(ImVec2(0, 0), ImVec2(WIDTH, HEIGHT), ImVec2(0, 0), ImVec2(0, 0),
+                {IM_COL32(20, 30, 60, 255), IM_COL32(60, 20, 80, 255), IM_COL32(90, 90, 20, 255),
+                 IM_COL32(10, 80, 90, 255)});
+        AddCommand(ImTextureID_Invalid, fullScreen);
+
+        // Glow ring: 600 triangles, enough to be set up in several chunks
+        const int segments = 300;
+        for (int i = 0; i < segments; i++)
+        {
+            float a0 = 6.2831853f * i / segments;
+            float a1 = 6.2831853f * (i + 1) / segments;
+            ImU32 inner = IM_COL32(80, 220, 255, 200);
+            ImU32 outer = IM_COL32(80, 220, 255, 0);
+            int first = m_List.VtxBuffer.Size;
+            AddVertex(ImVec2(80 + cosf(a0) * 34, 60 + sinf(a0) * 34), ImVec2(0, 0), inner);
+            AddVertex(ImVec2(80 + cosf(a0) * 46, 60 + sinf(a0) * 46), ImVec2(0, 0), outer);
+            AddVertex(ImVec2(80 + cosf(a1) * 46, 60 + sinf(a1) * 46), ImVec2(0, 0), outer);
+            AddVertex(ImVec2(80 + cosf(a1) * 34, 60 + sinf(a1) * 34), ImVec2(0, 0), inner);
+            AddIndices(first, {0, 1, 2, 0, 2, 3});
+        }
+        AddCommand(ImTextureID_Invalid, fullScreen);
+
+        // Translucent triangle across the tile corner at (64, 64)
+        int first = m_List.VtxBuffer.Size;
+        AddVertex(ImVec2(30, 10), ImVec2(0, 0), IM_COL32(255, 60, 40, 160));
+        AddVertex(ImVec2(130, 40), ImVec2(0, 0), IM_COL32(255, 60, 40, 160));
+        AddVertex(ImVec2(50, 110), ImVec2(0, 0), IM_COL32(255, 60, 40, 160));
+        AddIndices(first, {0, 1, 2});
+        AddCommand(ImTextureID_Invalid, fullScreen);
+
+        // Textured and tinted, wrapping twice
+        AddQuad(ImVec2(70, 60), ImVec2(150, 110), ImVec2(0, 0), ImVec2(2, 2),
+                {IM_COL32(255, 255, 255, 220), IM_COL32(255, 200, 200, 220),
+                 IM_COL32(200, 255, 200, 220), IM_COL32(200, 200, 255, 220)});
+        AddCommand(checkerTexture, fullScreen);
+
+        // Clipped to a smaller rect
+        AddQuad(ImVec2(10, 70), ImVec2(100, 115), ImVec2(0, 0), ImVec2(0, 0),
+                {IM_COL32(40, 200, 90, 255), IM_COL32(40, 200, 90, 255),
+                 IM_COL32(40, 200, 90, 255), IM_COL32(40, 200, 90, 255)});
+        AddCommand(ImTextureID_Invalid, ImVec4(20, 80, 60, 110));
+
+        // Off the pixel grid, thin, with a color per vertex
+        first = m_List.VtxBuffer.Size;
+        AddVertex(ImVec2(100.3f, 5.7f), ImVec2(0, 0), IM_COL32(255, 255, 0, 255));
+        AddVertex(ImVec2(155.8f, 8.1f), ImVec2(0, 0), IM_COL32(255, 0, 255, 128));
+        AddVertex(ImVec2(150.2f, 50.9f), ImVec2(0, 0), IM_COL32(0, 255, 255, 64));
+        AddVertex(ImVec2(2.5f, 2.5f), ImVec2(0, 0), IM_COL32(255, 255, 255, 255));
+        AddVertex(ImVec2(158.0f, 4.0f), ImVec2(0, 0), IM_COL32(255, 255, 255, 255));
+        AddVertex(ImVec2(3.0f, 3.6f), ImVec2(0, 0), IM_COL32(255, 255, 255, 255));
+        AddIndices(first, {0, 1, 2, 3, 4, 5});
+        AddCommand(ImTextureID_Invalid, fullScreen);
+
+        m_Data.Valid = true;
+        m_Data.CmdLists.push_back(&m_List);
+        m_Data.CmdListsCount = 1;
+        m_Data.TotalVtxCount = m_List.VtxBuffer.Size;
+        m_Data.TotalIdxCount = m_List.IdxBuffer.Size;
+        m_Data.DisplayPos = ImVec2(0, 0);
+        m_Data.DisplaySize = ImVec2(WIDTH, HEIGHT);
+        m_Data.FramebufferScale = ImVec2(1, 1);
+    }
+
+    ImDrawData* GetDrawData()
+    {
+        return &m_Data;
+    }
+
+  private:
+    void AddVertex(ImVec2 pos, ImVec2 uv, ImU32 color)
+    {
+        ImDrawVert vertex;
+        vertex.pos = pos;
+        vertex.uv = uv;
+        vertex.col = color;
+        m_List.VtxBuffer.push_back(vertex);
+    }
+
+    void AddIndices(int first, std::initializer_list<int> indices)
+    {
+        for (int index : indices)
+            m_List.IdxBuffer.push_back((ImDrawIdx)(first + index));
+    }
+
+    // Corners clockwise from the top left
+    void AddQuad(ImVec2 min, ImVec2 max, ImVec2 uvMin, ImVec2 uvMax,
+                 const std::vector<ImU32>& colors)
+    {
+        int first = m_List.VtxBuffer.Size;
+        AddVertex(min, uvMin, colors[0]);
+        AddVertex(ImVec2(max.x, min.y), ImVec2(uvMax.x, uvMin.y), colors[1]);
+        AddVertex(max, uvMax, colors[2]);
+        AddVertex(ImVec2(min.x, max.y), ImVec2(uvMin.x, uvMax.y), colors[3]);
+        AddIndices(first, {0, 1, 2, 0, 2, 3});
+    }
+
+    // Closes the indices added since the last command
+    void AddCommand(ImTextureID texture, ImVec4 clipRect)
+    {
+        ImDrawCmd cmd;
+        cmd.ClipRect = clipRect;
+        cmd.TexRef = ImTextureRef(texture);
+        cmd.IdxOffset = m_Indexed;
+        cmd.ElemCount = (unsigned int)m_List.IdxBuffer.Size - m_Indexed;
+        m_List.CmdBuffer.push_back(cmd);
+        m_Indexed = (unsigned int)m_List.IdxBuffer.Size;
+    }
+
+    ImDrawList m_List;
+    ImDrawData m_Data;
+    unsigned int m_Indexed = 0;
+};
+
+// RGBA8 PAM, rows top to bottom
+static bool WritePam(const std::string& path, const std::vector<unsigned char>& rgba)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    fprintf(file, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n",
+            WIDTH, HEIGHT);
+    bool written = fwrite(rgba.data(), 1, rgba.size(), file) == rgba.size();
+    return fclose(file) == 0 && written;
+}
+
+// Only what WritePam writes
+static bool ReadPam(const std::string& path, std::vector<unsigned char>& rgba)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    int width = 0, height = 0;
+    bool read = fscanf(file, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\n",
+                       &width, &height) == 2 &&
+                width == WIDTH && height == HEIGHT;
+    char end[8] = {};
+    read = read && fscanf(file, "%7s", end) == 1 && std::string(end) == "ENDHDR" &&
+           fgetc(file) == '\n';
+    rgba.resize((size_t)WIDTH * HEIGHT * 4);
+    read = read && fread(rgba.data(), 1, rgba.size(), file) == rgba.size();
+    fclose(file);
+    return read;
+}
+
+// The framebuffer as RGBA bytes, whatever the byte order of ImU32
+static std::vector<unsigned char> RenderScene(int threads)
+{
+    MemoryTextureFactory textures;
+    Scene scene(textures);
+    SoftwareRenderer renderer(textures, threads);
+    renderer.Render(scene.GetDrawData(), CLEAR_COLOR);
+
+    std::vector<unsigned char> rgba;
+    for (int y = 0; y < renderer.GetHeight(); y++)
+    {
+        for (int x = 0; x < renderer.GetWidth(); x++)
+        {
+            ImU32 pixel = renderer.GetPixels()[y * renderer.GetPitch() + x];
+            rgba.push_back((unsigned char)(pixel >> IM_COL32_R_SHIFT));
+            rgba.push_back((unsigned char)(pixel >> IM_COL32_G_SHIFT));
+            rgba.push_back((unsigned char)(pixel >> IM_COL32_B_SHIFT));
+            rgba.push_back((unsigned char)(pixel >> IM_COL32_A_SHIFT));
+        }
+    }
+    return rgba;
+}
+
+TEST(MatchesReferenceImage)
+{
+    std::vector<unsigned char> rendered = RenderScene(1);
+    CHECK(rendered.size() == (size_t)WIDTH * HEIGHT * 4);
+    if (test::IsUpdate())
+    {
+        CHECK(WritePam(REFERENCE, rendered));
+        printf("  wrote %s\n", REFERENCE.c_str());
+        return;
+    }
+
+    std::vector<unsigned char> reference;
+    CHECK(ReadPam(REFERENCE, reference));
+    if (reference.size() != rendered.size())
+        return;
+
+    int different = 0;
+    int worst = 0;
+    for (size_t i = 0; i < rendered.size(); i += 4)
+    {
+        int distance = 0;
+        for (size_t c = 0; c < 4; c++)
+            distance = std::max(distance, std::abs(rendered[i + c] - reference[i + c]));
+        worst = std::max(worst, distance);
+        different += distance > TOLERANCE;
+    }
+    if (different > 0)
+    {
+        WritePam("SoftwareRenderer.actual.pam", rendered);
+        printf("  %d pixels differ (up to %d), see SoftwareRenderer.actual.pam\n", different,
+               worst);
+    }
+    CHECK(different == 0);
+}
+
+// Binning and tiles are split across threads, the pixels must not depend on it
+TEST(ThreadCountDoesntChangeThePixels)
+{
+    std::vector<unsigned char> single = RenderScene(1);
+    CHECK(RenderScene(4) == single);
+    CHECK(RenderScene(SoftwareRenderer::MAX_THREADS) == single);
+}
@@ -0,0 +1,162 @@
+#include "69/service/Ed25519.h"
+
+#include "Test.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace service;
+
+static std::vector<uint8_t> FromHex(const char* hex)
+{
+    std::vector<uint8_t> bytes;
+    for (; hex[0] && hex[1]; hex += 2)
+    {
+        char digits[3] = {hex[0], hex[1], 0};
+        bytes.push_back((uint8_t)std::strtoul(digits, nullptr, 16));
+    }
+    return bytes;
+}
+
+static std::string ToHex(const uint8_t* bytes, size_t size)
+{
+    static const char HEX[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < size; i++)
+    {
+        hex += HEX[bytes[i] >> 4];
+        hex += HEX[bytes[i] & 15];
+    }
+    return hex;
+}
+
+// RFC 8032 section 7.1, tests 1 to 3
+struct Vector
+{
+    const char* PublicKey;
+    const char* Message;
+    const char* Signature;
+};
+
+static const Vector RFC8032[] = {
+    {"d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a", "",
+     "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155"
+     "5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"},
+    {"3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c", "72",
+     "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+     "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"},
+    {"fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025", "af82",
+     "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac"
+     "18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a"},
+};
+
+// Group order L, little endian like S
+static const char* GROUP_ORDER = "edd3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010";
+
+static bool Verify(const Vector& vector, const std::vector<uint8_t>& signature)
+{
+    std::vector<uint8_t> publicKey = FromHex(vector.PublicKey);
+    std::vector<uint8_t> message = FromHex(vector.Message);
+    return VerifyEd25519(publicKey.data(), message.data(), message.size(), signature.data());
+}
+
+TEST(Rfc8032VectorsVerify)
+{
+    for (const Vector& vector : RFC8032)
+        CHECK(Verify(vector, FromHex(vector.Signature)));
+}
+
+TEST(TamperedRIsRejected)
+{
+    for (const Vector& vector : RFC8032)
+    {
+        std::vector<uint8_t> signature = FromHex(vector.Signature);
+        signature[0] ^= 1;
+        CHECK(!Verify(vector, signature));
+    }
+}
+
+TEST(TamperedSIsRejected)
+{
+    for (const Vector& vector : RFC8032)
+    {
+        std::vector<uint8_t> signature = FromHex(vector.Signature);
+        signature[32] ^= 1;
+        CHECK(!Verify(vector, signature));
+    }
+}
+
+TEST(OtherMessageIsRejected)
+{
+    std::vector<uint8_t> publicKey = FromHex(RFC8032[2].PublicKey);
+    std::vector<uint8_t> signature = FromHex(RFC8032[2].Signature);
+    const uint8_t message[] = {0xaf, 0x83};
+    CHECK(!VerifyEd25519(publicKey.data(), message, sizeof(message), signature.data()));
+}
+
+// S + L passes the group equation like S does, only the S < L check stops it
+TEST(NonCanonicalSIsRejected)
+{
+    std::vector<uint8_t> order = FromHex(GROUP_ORDER);
+    for (const Vector& vector : RFC8032)
+    {
+        std::vector<uint8_t> signature = FromHex(vector.Signature);
+        int carry = 0;
+        for (int i = 0; i < 32; i++)
+        {
+            int sum = signature[32 + i] + order[i] + carry;
+            signature[32 + i] = (uint8_t)sum;
+            carry = sum >> 8;
+        }
+        CHECK(carry == 0);
+        CHECK(!Verify(vector, signature));
+    }
+
+    // S = L exactly
+    std::vector<uint8_t> signature = FromHex(RFC8032[0].Signature);
+    for (int i = 0; i < 32; i++)
+        signature[32 + i] = order[i];
+    CHECK(!Verify(RFC8032[0], signature));
+}
+
+// FIPS 180-2 "abc"
+TEST(Sha512Vector)
+{
+    uint8_t digest[SHA512_SIZE];
+    Sha512("abc", 3, digest);
+    CHECK(ToHex(digest, sizeof(digest)) ==
+          "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+          "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+}
+
+// RFC 4231 test cases 2 and 6 (key longer than a block)
+TEST(HmacSha512Vectors)
+{
+    uint8_t digest[SHA512_SIZE];
+    const char* data = "what do ya want for nothing?";
+    HmacSha512("Jefe", 4, data, 28, digest);
+    CHECK(ToHex(digest, sizeof(digest)) ==
+          "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+          "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+
+    std::vector<uint8_t> key(131, 0xaa);
+    std::string longKeyData = "Test Using Larger Than Block-Size Key - Hash Key First";
+    HmacSha512(key.data(), key.size(), longKeyData.data(), longKeyData.size(), digest);
+    CHECK(ToHex(digest, sizeof(digest)) ==
+          "80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f352"
+          "6b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598");
+}
+
+// The user claim of a license token as scripts/login_server.py writes it, salt 00 01 .. 0f
+TEST(TokenUserClaimMatchesTheServer)
+{
+    uint8_t salt[16];
+    for (int i = 0; i < 16; i++)
+        salt[i] = (uint8_t)i;
+    uint8_t digest[SHA512_SIZE];
+    HmacSha512("69-TEST-KEY", 11, salt, sizeof(salt), digest);
+    CHECK(ToHex(digest, sizeof(digest)) ==
+          "491627e139f47b096e84c26dc6f785261f53fa18e0a62aae0013982b6bdccaa5"
+          "1ad64473a1d53b44d42a99af35d744be299b332f23e89dc7347a2b75569e5b5d");
+}
@@ -0,0 +1,243 @@
+#include "69/service/EndpointPool.h"
+#include "69/service/Executor.h"
+
+#include "StandInServer.h"
+#include "Test.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace service;
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static HttpResponse Accept(const StandInServer::Request& request)
+{
+    return {200, request.Body};
+}
+
+// A new connection per attempt to the server at url, as the port is all that differs
+static HttpResponse Post(const std::string& url)
+{
+    int port = std::atoi(url.c_str() + url.rfind(':') + 1);
+    return LoopbackClient(port).Post("/login", "key");
+}
+
+// See EndpointPool.cpp: hedge delay without enough latency samples, the range a measured one is
+// clamped to, how many answers it takes and how many attempts can run at once
+static const double HEDGE_DELAY_MS = 1000.0;
+static const auto MIN_HEDGE_DELAY = std::chrono::milliseconds(50);
+static const auto MAX_HEDGE_DELAY = std::chrono::milliseconds(3000);
+static const int MIN_LATENCY_SAMPLES = 8;
+static const int MAX_ATTEMPT_THREADS = 8;
+
+// First here, while every attempt thread is free: answers slower than MAX_HEDGE_DELAY, taken in
+// parallel so it doesn't take as many times as long
+TEST(SlowEndpointHedgeDelayIsClamped)
+{
+    StandInServer slow(Accept);
+    slow.SetDelay(MAX_HEDGE_DELAY + std::chrono::milliseconds(100));
+
+    EndpointPool pool({slow.GetUrl()});
+    std::vector<std::thread> senders;
+    std::atomic<int> answered{0};
+    for (int i = 0; i < MIN_LATENCY_SAMPLES; i++)
+    {
+        senders.emplace_back([&]() {
+            answered += pool.Send(Post, CancellationToken(std::chrono::seconds(10))).Status == 200;
+        });
+    }
+    for (std::thread& sender : senders)
+        sender.join();
+
+    CHECK(answered == MIN_LATENCY_SAMPLES);
+    CHECK(pool.GetHedgeDelay(0) == MAX_HEDGE_DELAY);
+}
+
+TEST(FastEndpointHedgeDelayIsClamped)
+{
+    StandInServer fast(Accept);
+    EndpointPool pool({fast.GetUrl()});
+    CHECK(pool.GetHedgeDelay(0).count() == (long long)HEDGE_DELAY_MS);
+
+    for (int i = 0; i < MIN_LATENCY_SAMPLES; i++)
+        CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 200);
+    CHECK(pool.GetHedgeDelay(0) == MIN_HEDGE_DELAY);
+}
+
+// Once an endpoint has answered enough, a hung attempt on it is hedged at its p95
+TEST(HedgeFiresAtTheMeasuredP95)
+{
+    StandInServer slow(Accept);
+    StandInServer healthy(Accept);
+    slow.SetDelay(std::chrono::milliseconds(150));
+
+    // Slower than usual but well under the default delay, nothing is hedged yet
+    EndpointPool pool({slow.GetUrl(), healthy.GetUrl()});
+    for (int i = 0; i < MIN_LATENCY_SAMPLES; i++)
+        CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 200);
+    CHECK(healthy.GetRequests() == 0);
+
+    double p95 = (double)pool.GetHedgeDelay(0).count();
+    printf("  p95 of %d answers delayed by 150 ms: %.0f ms\n", MIN_LATENCY_SAMPLES, p95);
+    CHECK(p95 >= 150.0 && p95 < 250.0);
+
+    slow.SetHanging(true);
+    Clock::time_point start = Clock::now();
+    CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 200);
+    double elapsed = MillisecondsSince(start);
+    CHECK(elapsed >= p95 && elapsed < p95 + 100.0);
+    CHECK(healthy.GetRequests() == 1);
+}
+
+TEST(HedgeAnswersForAHungEndpoint)
+{
+    StandInServer hung(Accept);
+    StandInServer healthy(Accept);
+    hung.SetHanging(true);
+
+    EndpointPool pool({hung.GetUrl(), healthy.GetUrl()});
+    Clock::time_point start = Clock::now();
+    HttpResponse response = pool.Send(Post, CancellationToken(std::chrono::seconds(5)));
+    double elapsed = MillisecondsSince(start);
+
+    CHECK(response.Status == 200);
+    CHECK(elapsed >= HEDGE_DELAY_MS && elapsed < HEDGE_DELAY_MS + 500.0);
+    CHECK(hung.GetRequests() == 1);
+    CHECK(healthy.GetRequests() == 1);
+
+    // The winner is tried first next time, no hedge needed
+    start = Clock::now();
+    CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 200);
+    CHECK(MillisecondsSince(start) < 200.0);
+    CHECK(hung.GetRequests() == 1);
+}
+
+// Every Executor worker blocked, the way a login running on one of them sees it when the others
+// are busy. Attempts queued behind them would never start.
+TEST(SendDoesntWaitForTheExecutor)
+{
+    static std::atomic<bool> release{false};
+    static std::atomic<int> blocked{0};
+    for (int i = 0; i < 8; i++)
+    {
+        Executor::Get().Submit(Executor::Priority::INTERACTIVE, []() {
+            blocked++;
+            while (!release)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            blocked--;
+        });
+    }
+    while (blocked == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    StandInServer hung(Accept);
+    StandInServer healthy(Accept);
+    hung.SetHanging(true);
+
+    EndpointPool pool({hung.GetUrl(), healthy.GetUrl()});
+    Clock::time_point start = Clock::now();
+    HttpResponse response = pool.Send(Post, CancellationToken(std::chrono::seconds(5)));
+    CHECK(response.Status == 200);
+    CHECK(MillisecondsSince(start) < HEDGE_DELAY_MS + 500.0);
+
+    release = true;
+    while (blocked > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+// Nothing answers, Send gives up when the token does and leaves the attempt behind
+TEST(DeadlineEndsAHungSend)
+{
+    StandInServer hung(Accept);
+    hung.SetHanging(true);
+
+    EndpointPool pool({hung.GetUrl()});
+    Clock::time_point start = Clock::now();
+    HttpResponse response = pool.Send(Post, CancellationToken(std::chrono::milliseconds(200)));
+    double elapsed = MillisecondsSince(start);
+
+    CHECK(response.Status == 0);
+    CHECK(elapsed >= 200.0 && elapsed < 400.0);
+    CHECK(hung.GetRequests() == 1);
+}
+
+// A connection closed without an answer is a failure like a server error
+TEST(DroppedRequestIsRetriedOnTheNextEndpoint)
+{
+    StandInServer dropping(Accept);
+    StandInServer healthy(Accept);
+    dropping.SetDropping(true);
+
+    RetryPolicy policy;
+    policy.BaseDelay = std::chrono::milliseconds(10);
+    EndpointPool pool({dropping.GetUrl(), healthy.GetUrl()}, policy);
+    Clock::time_point start = Clock::now();
+    CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 200);
+    CHECK(MillisecondsSince(start) < 100.0); // Retried, not hedged
+    CHECK(dropping.GetRequests() == 1);
+    CHECK(healthy.GetRequests() == 1);
+}
+
+TEST(EveryAttemptDroppedGivesNoAnswer)
+{
+    StandInServer dropping(Accept);
+    dropping.SetDropping(true);
+
+    RetryPolicy policy;
+    policy.BaseDelay = std::chrono::milliseconds(10);
+    EndpointPool pool({dropping.GetUrl()}, policy);
+    CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 0);
+    CHECK(dropping.GetRequests() == policy.MaxAttempts);
+}
+
+// Attempts left hung hold their threads, past MAX_ATTEMPT_THREADS new attempts fail at once
+// instead of piling up more threads, and the threads are used again once the sockets let go
+TEST(HungAttemptsDontPileUp)
+{
+    StandInServer hung(Accept);
+    StandInServer healthy(Accept);
+    hung.SetHanging(true);
+
+    RetryPolicy policy;
+    policy.MaxAttempts = 1;
+    EndpointPool hungPool({hung.GetUrl()}, policy);
+    for (int i = 0; i < 50 && hung.GetRequests() < MAX_ATTEMPT_THREADS; i++)
+        hungPool.Send(Post, CancellationToken(std::chrono::milliseconds(20)));
+    CHECK(hung.GetRequests() == MAX_ATTEMPT_THREADS);
+
+    EndpointPool pool({healthy.GetUrl()}, policy);
+    Clock::time_point start = Clock::now();
+    CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 0);
+    CHECK(MillisecondsSince(start) < 50.0);
+    CHECK(hung.GetRequests() == MAX_ATTEMPT_THREADS);
+    CHECK(healthy.GetRequests() == 0);
+
+    hung.Stop();
+    start = Clock::now();
+    bool answered = false;
+    while (!answered && MillisecondsSince(start) < 2000.0)
+        answered = pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 200;
+    CHECK(answered);
+}
+
+// A failed endpoint is retried on the next one after the backoff
+TEST(ServerErrorIsRetriedOnTheNextEndpoint)
+{
+    StandInServer failing([](const StandInServer::Request&) { return HttpResponse{503, ""}; });
+    StandInServer healthy(Accept);
+
+    RetryPolicy policy;
+    policy.BaseDelay = std::chrono::milliseconds(10);
+    EndpointPool pool({failing.GetUrl(), healthy.GetUrl()}, policy);
+    CHECK(pool.Send(Post, CancellationToken(std::chrono::seconds(5))).Status == 200);
+    CHECK(failing.GetRequests() == 1);
+    CHECK(healthy.GetRequests() == 1);
+}
@@ -0,0 +1,173 @@
+#include "69/service/LoginRecord.h"
+
+#include "Test.h"
+
+#include <cstring>
+#include <string>
+
+using namespace service;
+
+static const char* HWID = "S-1-5-21-1004336348-1177238915-682003330-1001";
+static const char* KEY = "69-TEST-KEY";
+static const long long NOW = 1700000000;
+static const long long EXPIRY = NOW + 3600;
+
+static LoginBundle MakeBundle()
+{
+    LoginBundle bundle;
+    bundle.Result = OperationResult::SUCCESS;
+    bundle.Subscriptions.push_back({"default", "2099-01-01"});
+    bundle.Software.push_back({"Stand-in", 2, 7});
+    bundle.Software.push_back({"Other", 0, 9});
+    bundle.Variables["motd"] = "hello";
+    return bundle;
+}
+
+static LoginRecord MakeRecord()
+{
+    LoginRecord record;
+    CHECK(PackLoginRecord(HWID, KEY, MakeBundle(), EXPIRY, record));
+    return record;
+}
+
+static bool Unpack(const LoginRecord& record, const std::string& hwid = HWID, long long now = NOW)
+{
+    std::string licenseKey;
+    LoginBundle bundle;
+    return UnpackLoginRecord(record, hwid, now, licenseKey, bundle);
+}
+
+TEST(RoundTrip)
+{
+    LoginRecord record = MakeRecord();
+    std::string licenseKey;
+    LoginBundle bundle;
+    CHECK(UnpackLoginRecord(record, HWID, NOW, licenseKey, bundle));
+
+    LoginBundle expected = MakeBundle();
+    CHECK(licenseKey == KEY);
+    CHECK(bundle.Result == OperationResult::SUCCESS);
+    CHECK(!bundle.Offline);
+    CHECK(bundle.Subscriptions.size() == 1);
+    CHECK(bundle.Subscriptions[0].Name == "default");
+    CHECK(bundle.Subscriptions[0].Expiry == "2099-01-01");
+    CHECK(bundle.Software.size() == 2);
+    CHECK(bundle.Software[0].Name == "Stand-in" && bundle.Software[0].IconIndex == 2 &&
+          bundle.Software[0].ID == 7);
+    CHECK(bundle.Software[1].Name == "Other" && bundle.Software[1].ID == 9);
+    CHECK(bundle.Variables == expected.Variables);
+}
+
+TEST(OtherMachineIsRefused)
+{
+    LoginRecord record = MakeRecord();
+    CHECK(!Unpack(record, "S-1-5-21-0-0-0-1001"));
+    CHECK(!Unpack(record, std::string(HWID) + "0"));
+    CHECK(!Unpack(record, ""));
+
+    // An empty hwid never matches, not even an empty one
+    LoginRecord empty;
+    CHECK(PackLoginRecord("", KEY, MakeBundle(), EXPIRY, empty));
+    CHECK(!Unpack(empty, ""));
+}
+
+TEST(ExpiredIsRefused)
+{
+    LoginRecord record = MakeRecord();
+    CHECK(Unpack(record, HWID, EXPIRY - 1));
+    CHECK(!Unpack(record, HWID, EXPIRY));
+    CHECK(!Unpack(record, HWID, EXPIRY + 7 * 24 * 3600));
+}
+
+TEST(OtherFormatIsRefused)
+{
+    LoginRecord record = MakeRecord();
+    record.Magic ^= 1;
+    CHECK(!Unpack(record));
+
+    record = MakeRecord();
+    record.Version++;
+    CHECK(!Unpack(record));
+}
+
+// Counts past the arrays would read outside the record
+TEST(CountsAreChecked)
+{
+    LoginRecord record = MakeRecord();
+    record.SubscriptionCount = 9;
+    CHECK(!Unpack(record));
+
+    record = MakeRecord();
+    record.SoftwareCount = 17;
+    CHECK(!Unpack(record));
+
+    record = MakeRecord();
+    record.VariableCount = 0xFFFFFFFF;
+    CHECK(!Unpack(record));
+
+    // Up to the array sizes is fine
+    record = MakeRecord();
+    record.SubscriptionCount = 8;
+    record.SoftwareCount = 16;
+    record.VariableCount = 8;
+    CHECK(Unpack(record));
+}
+
+// Strings without a terminator would be read past their field
+TEST(TerminationIsChecked)
+{
+    LoginRecord record = MakeRecord();
+    memset(record.Hwid, 'x', sizeof(record.Hwid));
+    CHECK(!Unpack(record));
+
+    record = MakeRecord();
+    memset(record.LicenseKey, 'x', sizeof(record.LicenseKey));
+    CHECK(!Unpack(record));
+
+    record = MakeRecord();
+    memset(record.Subscriptions[0].Expiry, 'x', sizeof(record.Subscriptions[0].Expiry));
+    CHECK(!Unpack(record));
+
+    record = MakeRecord();
+    memset(record.Software[1].Name, 'x', sizeof(record.Software[1].Name));
+    CHECK(!Unpack(record));
+
+    record = MakeRecord();
+    memset(record.Variables[0].Value, 'x', sizeof(record.Variables[0].Value));
+    CHECK(!Unpack(record));
+
+    // Past the count nothing is read
+    record = MakeRecord();
+    memset(record.Software[2].Name, 'x', sizeof(record.Software[2].Name));
+    CHECK(Unpack(record));
+}
+
+TEST(TooLargeDoesNotFit)
+{
+    LoginRecord record;
+    CHECK(!PackLoginRecord(std::string(128, 'h'), KEY, MakeBundle(), EXPIRY, record));
+    CHECK(PackLoginRecord(std::string(127, 'h'), KEY, MakeBundle(), EXPIRY, record));
+    CHECK(!PackLoginRecord(HWID, std::string(64, 'k'), MakeBundle(), EXPIRY, record));
+    CHECK(!PackLoginRecord(HWID, std::string("69\0KEY", 6), MakeBundle(), EXPIRY, record));
+
+    LoginBundle bundle = MakeBundle();
+    bundle.Subscriptions.resize(9, {"default", "2099-01-01"});
+    CHECK(!PackLoginRecord(HWID, KEY, bundle, EXPIRY, record));
+
+    bundle = MakeBundle();
+    bundle.Software.resize(17, {"Stand-in", 0, 1});
+    CHECK(!PackLoginRecord(HWID, KEY, bundle, EXPIRY, record));
+
+    bundle = MakeBundle();
+    for (int i = 0; i < 9; i++)
+        bundle.Variables.emplace(std::to_string(i), "1");
+    CHECK(!PackLoginRecord(HWID, KEY, bundle, EXPIRY, record));
+
+    bundle = MakeBundle();
+    bundle.Variables["motd"] = std::string(224, 'm');
+    CHECK(!PackLoginRecord(HWID, KEY, bundle, EXPIRY, record));
+
+    bundle = MakeBundle();
+    bundle.Software[1].Name = std::string(64, 'n');
+    CHECK(!PackLoginRecord(HWID, KEY, bundle, EXPIRY, record));
+}
@@ -0,0 +1,131 @@
+#include "69/service/Metrics.h"
+
+#include "Test.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace service;
+using Histogram = LatencyHistogram;
+
+TEST(EveryBucketStartsItsOwnRange)
+{
+    for (int bucket = 0; bucket < Histogram::BUCKET_COUNT; bucket++)
+    {
+        uint32_t start = Histogram::GetBucketStart(bucket);
+        CHECK(Histogram::GetBucket(start) == bucket);
+        if (bucket > 0)
+            CHECK(Histogram::GetBucket(start - 1) == bucket - 1);
+        if (bucket + 1 < Histogram::BUCKET_COUNT)
+            CHECK(Histogram::GetBucketStart(bucket + 1) > start);
+    }
+}
+
+// Linear up to 15, then 8 buckets per power of two
+TEST(BucketEdges)
+{
+    CHECK(Histogram::GetBucket(0) == 0);
+    CHECK(Histogram::GetBucket(15) == 15);
+    CHECK(Histogram::GetBucket(16) == 16);
+    CHECK(Histogram::GetBucket(17) == 16);
+    CHECK(Histogram::GetBucket(18) == 17);
+    CHECK(Histogram::GetBucketStart(16) == 16);
+    CHECK(Histogram::GetBucketStart(24) == 32);
+    CHECK(Histogram::GetBucket(UINT32_MAX) == 239);
+    CHECK(Histogram::GetBucket(UINT32_MAX) == Histogram::BUCKET_COUNT - 1);
+}
+
+// A bucket is never wider than 1/8 of its start
+TEST(BucketsStayNarrow)
+{
+    for (int bucket = 16; bucket + 1 < Histogram::BUCKET_COUNT; bucket++)
+    {
+        double start = Histogram::GetBucketStart(bucket);
+        double width = Histogram::GetBucketStart(bucket + 1) - start;
+        CHECK(width <= start / 8.0);
+    }
+}
+
+static bool IsNear(double value, double expected, double tolerance)
+{
+    if (std::fabs(value - expected) <= tolerance)
+        return true;
+    printf("  %.4f, expected %.4f\n", value, expected);
+    return false;
+}
+
+TEST(PercentilesOfAUniformSpread)
+{
+    Histogram histogram;
+    for (int ms = 1; ms <= 100; ms++)
+        histogram.Record(std::chrono::milliseconds(ms));
+
+    Histogram::Snapshot snapshot;
+    histogram.Read(snapshot);
+    CHECK(snapshot.Count == 100);
+    CHECK(snapshot.MaxMicros == 100000);
+    CHECK(snapshot.SumMicros == 5050000);
+
+    // Bucket middles are off by at most 1/16
+    CHECK(IsNear(snapshot.GetPercentileMs(50.0), 50.0, 50.0 / 16.0));
+    CHECK(IsNear(snapshot.GetPercentileMs(90.0), 90.0, 90.0 / 16.0));
+    CHECK(IsNear(snapshot.GetPercentileMs(0.0), 1.0, 1.0 / 16.0));
+
+    // Never above the largest value
+    CHECK(snapshot.GetPercentileMs(100.0) <= 100.0);
+    CHECK(IsNear(snapshot.GetPercentileMs(100.0), 100.0, 100.0 / 16.0));
+}
+
+TEST(PercentilesOfFewValues)
+{
+    Histogram::Snapshot snapshot;
+    Histogram empty;
+    empty.Read(snapshot);
+    CHECK(snapshot.Count == 0);
+    CHECK(snapshot.GetPercentileMs(99.0) == 0.0);
+
+    Histogram histogram;
+    histogram.Record(std::chrono::microseconds(7));
+    histogram.Record(std::chrono::microseconds(7));
+    histogram.Record(std::chrono::seconds(2));
+    histogram.Read(snapshot);
+    CHECK(snapshot.GetPercentileMs(50.0) == 0.0075); // Single-value bucket, its middle
+
+    // Rank rounded down: the 99th of 3 values is the second one
+    CHECK(snapshot.GetPercentileMs(99.0) == 0.0075);
+    CHECK(IsNear(snapshot.GetPercentileMs(100.0), 2000.0, 2000.0 / 16.0));
+}
+
+TEST(OutOfRangeLatenciesAreClamped)
+{
+    Histogram histogram;
+    histogram.Record(std::chrono::microseconds(-5));
+    histogram.Record(std::chrono::hours(2)); // Past UINT32_MAX microseconds
+
+    Histogram::Snapshot snapshot;
+    histogram.Read(snapshot);
+    CHECK(snapshot.Counts[0] == 1);
+    CHECK(snapshot.Counts[Histogram::BUCKET_COUNT - 1] == 1);
+    CHECK(snapshot.MaxMicros == UINT32_MAX);
+}
+
+TEST(WriteJsonReplacesTheFile)
+{
+    const char* path = "metrics_test.json";
+    Metrics::Record(Metric::LOGIN, std::chrono::milliseconds(120));
+    for (int i = 0; i < 2; i++)
+    {
+        CHECK(Metrics::WriteJson(path));
+        std::ifstream file(path);
+        std::stringstream json;
+        json << file.rdbuf();
+        CHECK(json.str().find("\"login\": {\"count\": 1,") != std::string::npos);
+        CHECK(json.str().find("http_request") == std::string::npos); // No samples
+    }
+    CHECK(!std::ifstream(std::string(path) + ".tmp"));
+    std::remove(path);
+}
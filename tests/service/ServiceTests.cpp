@@ -0,0 +1,197 @@
+#include "69/service/Scheduler.h"
+#include "69/service/Service.h"
+
+#include "StandInServer.h"
+#include "Test.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace service;
+using Clock = std::chrono::steady_clock;
+
+static const auto LONG_TIMEOUT = std::chrono::seconds(30);
+
+static double MillisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Service whose every call sits in a request to the stand-in server and never looks at the
+// token, like a login stuck in a socket
+class HungService final : public IService
+{
+  public:
+    explicit HungService(int port) : m_Port(port)
+    {
+    }
+
+    LoginBundle Login(const std::string& licenseKey, const CancellationToken&) override
+    {
+        LoginBundle bundle;
+        bundle.Result = Call("/login", licenseKey);
+        return bundle;
+    }
+
+    bool GetCachedLogin(std::string&, LoginBundle&) override
+    {
+        return false;
+    }
+
+    LoginBundle Revalidate(const std::string& licenseKey, const CancellationToken& token) override
+    {
+        return Login(licenseKey, token);
+    }
+
+    OperationResult ValidateUser(const std::string& licenseKey, const CancellationToken&) override
+    {
+        return Call("/validate", licenseKey);
+    }
+
+    std::vector<SoftwareItem> GetAvailableSoftware() override
+    {
+        return {};
+    }
+
+    OperationResult LaunchSoftware(int id, const CancellationToken&) override
+    {
+        return Call("/launch", std::to_string(id));
+    }
+
+    // Calls that got back from the server, answered or dropped
+    std::atomic<int> Returned{0};
+
+  private:
+    OperationResult Call(const std::string& path, const std::string& body)
+    {
+        bool answered = LoopbackClient(m_Port).Post(path, body).Ok();
+        Returned++;
+        return answered ? OperationResult::SUCCESS : OperationResult::FAILURE;
+    }
+
+    int m_Port;
+};
+
+static service::HttpResponse Accept(const StandInServer::Request&)
+{
+    return {200, "ok"};
+}
+
+static void WaitForRequests(const StandInServer& server, int requests)
+{
+    while (server.GetRequests() < requests)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+// The worker is left in the socket until the server stops
+static bool WaitForReturns(const HungService& service, int calls)
+{
+    Clock::time_point start = Clock::now();
+    while (service.Returned < calls && MillisecondsSince(start) < 2000.0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return service.Returned == calls;
+}
+
+static Task<void> LoginFlow(std::shared_ptr<IService> service, OperationResult& result)
+{
+    LoginBundle bundle = co_await LoginAsync(service, "69-TEST-KEY", LONG_TIMEOUT);
+    result = bundle.Result;
+}
+
+TEST(CancelReportsAtOnce)
+{
+    StandInServer server(Accept);
+    server.SetHanging(true);
+    auto hung = std::make_shared<HungService>(server.GetPort());
+
+    PendingOperation operation = PendingOperation::Start(
+        [hung](const CancellationToken& token) { return hung->ValidateUser("key", token); },
+        LONG_TIMEOUT);
+    WaitForRequests(server, 1);
+
+    OperationResult result = OperationResult::SUCCESS;
+    CHECK(!operation.Poll(result));
+
+    Clock::time_point start = Clock::now();
+    operation.Cancel();
+    CHECK(operation.Poll(result));
+    CHECK(result == OperationResult::CANCELLED);
+    CHECK(MillisecondsSince(start) < 100.0);
+
+    server.Stop();
+    CHECK(WaitForReturns(*hung, 1));
+}
+
+TEST(DeadlinePassesOnAHungCall)
+{
+    StandInServer server(Accept);
+    server.SetHanging(true);
+    auto hung = std::make_shared<HungService>(server.GetPort());
+
+    Clock::time_point start = Clock::now();
+    PendingOperation operation = PendingOperation::Start(
+        [hung](const CancellationToken& token) { return hung->LaunchSoftware(1, token); },
+        std::chrono::milliseconds(50));
+
+    OperationResult result = OperationResult::SUCCESS;
+    while (!operation.Poll(result))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    double elapsed = MillisecondsSince(start);
+    CHECK(result == OperationResult::TIMED_OUT);
+    CHECK(elapsed >= 50.0 && elapsed < 150.0);
+
+    server.Stop();
+    CHECK(WaitForReturns(*hung, 1));
+}
+
+// What closing the menu does: cancel the flows waiting on the service and destroy them. Must
+// not wait for the worker stuck on the server.
+TEST(ShutdownWithAHungServerIsPrompt)
+{
+    StandInServer server(Accept);
+    server.SetHanging(true);
+    auto hung = std::make_shared<HungService>(server.GetPort());
+
+    auto scheduler = std::make_unique<FrameScheduler>();
+    OperationResult result = OperationResult::SUCCESS;
+    scheduler->Spawn(LoginFlow(hung, result));
+    WaitForRequests(server, 1);
+    for (int i = 0; i < 3; i++)
+        scheduler->Tick();
+    CHECK(scheduler->HasPending());
+
+    Clock::time_point start = Clock::now();
+    scheduler->CancelAll();
+    scheduler.reset();
+    CHECK(MillisecondsSince(start) < 100.0);
+    CHECK(result == OperationResult::SUCCESS); // The flow never resumed
+    CHECK(hung->Returned == 0);
+
+    // The worker gets out once the server lets go of it
+    server.Stop();
+    CHECK(WaitForReturns(*hung, 1));
+}
+
+// A flow that isn't cancelled still gets the answer once the server sends it
+TEST(ReleasedServerAnswersTheFlow)
+{
+    StandInServer server(Accept);
+    server.SetHanging(true);
+    auto hung = std::make_shared<HungService>(server.GetPort());
+
+    FrameScheduler scheduler;
+    OperationResult result = OperationResult::FAILURE;
+    scheduler.Spawn(LoginFlow(hung, result));
+    WaitForRequests(server, 1);
+    server.SetHanging(false);
+
+    Clock::time_point start = Clock::now();
+    while (scheduler.HasPending() && MillisecondsSince(start) < 2000.0)
+    {
+        scheduler.Tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(!scheduler.HasPending());
+    CHECK(result == OperationResult::SUCCESS);
+}
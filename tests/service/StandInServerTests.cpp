@@ -0,0 +1,93 @@
+#include "StandInServer.h"
+
+#include "Test.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static service::HttpResponse Echo(const StandInServer::Request& request)
+{
+    return {200, request.Method + " " + request.Path + " " + request.Body};
+}
+
+static double MillisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+TEST(KeepAliveReusesTheConnection)
+{
+    std::atomic<int> connection{0};
+    StandInServer server([&connection](const StandInServer::Request& request) {
+        connection = request.Connection;
+        return Echo(request);
+    });
+    CHECK(server.GetPort() != 0);
+
+    LoopbackClient client(server.GetPort());
+    for (int i = 0; i < 3; i++)
+    {
+        service::HttpResponse response = client.Post("/login", "key=" + std::to_string(i));
+        CHECK(response.Status == 200);
+        CHECK(response.Body == "POST /login key=" + std::to_string(i));
+    }
+    CHECK(server.GetConnections() == 1);
+    CHECK(server.GetRequests() == 3);
+    CHECK(connection == 1);
+}
+
+TEST(DelayIsAddedToEveryAnswer)
+{
+    StandInServer server(Echo);
+    LoopbackClient client(server.GetPort());
+    client.Post("/", "");
+
+    server.SetDelay(std::chrono::milliseconds(50));
+    Clock::time_point start = Clock::now();
+    CHECK(client.Post("/", "").Status == 200);
+    CHECK(MillisecondsSince(start) >= 50.0);
+}
+
+// A hung request is answered once released, or dropped when the server stops
+TEST(HangingHoldsAnswersUntilReleasedOrStopped)
+{
+    StandInServer server(Echo);
+    server.SetHanging(true);
+
+    service::HttpResponse released;
+    std::thread first([&]() { released = LoopbackClient(server.GetPort()).Post("/", "a"); });
+    while (server.GetRequests() < 1)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    server.SetHanging(false);
+    first.join();
+    CHECK(released.Status == 200);
+
+    server.SetHanging(true);
+    service::HttpResponse dropped{-1, ""};
+    std::thread second([&]() { dropped = LoopbackClient(server.GetPort()).Post("/", "b"); });
+    while (server.GetRequests() < 2)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    Clock::time_point start = Clock::now();
+    server.Stop();
+    second.join();
+    CHECK(dropped.Status == 0);
+    CHECK(MillisecondsSince(start) < 100.0);
+}
+
+TEST(DroppedRequestsCloseTheConnection)
+{
+    StandInServer server(Echo);
+    server.SetDropping(true);
+
+    Clock::time_point start = Clock::now();
+    CHECK(LoopbackClient(server.GetPort()).Post("/", "a").Status == 0);
+    CHECK(MillisecondsSince(start) < 100.0);
+    CHECK(server.GetRequests() == 1);
+
+    server.SetDropping(false);
+    CHECK(LoopbackClient(server.GetPort()).Post("/", "b").Status == 200);
+}
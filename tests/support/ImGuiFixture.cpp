@@ -0,0 +1,38 @@
+#include "ImGuiFixture.h"
+
+ImGuiFixture::ImGuiFixture(int width, int height, int threads) : m_Renderer(m_Textures, threads)
+{
+    m_Context = ImGui::CreateContext();
+    m_Context->TestEngine = &m_Items;
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    m_Renderer.Init();
+}
+
+ImGuiFixture::~ImGuiFixture()
+{
+    ImGui::SetCurrentContext(m_Context);
+    m_Renderer.Shutdown();
+    ImGui::DestroyContext(m_Context);
+}
+
+void ImGuiFixture::NewFrame(float deltaTime)
+{
+    ImGui::SetCurrentContext(m_Context);
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.Fonts->Fonts.Size == 0)
+        io.Fonts->AddFontDefault();
+    io.DeltaTime = deltaTime;
+    ImGui::NewFrame();
+    m_Context->TestEngineHookItems = true;
+}
+
+ImDrawData* ImGuiFixture::Render(ImU32 clearColor)
+{
+    ImGui::Render();
+    ImDrawData* drawData = ImGui::GetDrawData();
+    m_Renderer.Render(drawData, clearColor);
+    return drawData;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "ItemRects.h"
+
+#include "69/menu/SoftwareRenderer.h"
+#include "69/menu/Texture.h"
+#include "imgui/imgui.h"
+
+// A real ImGui context rasterized by SoftwareRenderer into memory, for the tests built with
+// IMGUI_SOURCE_DIR. Textures, the font atlas included, live in GetTextures().
+class ImGuiFixture
+{
+  public:
+    explicit ImGuiFixture(int width = 380, int height = 520, int threads = 1);
+    ~ImGuiFixture();
+
+    ImGuiFixture(const ImGuiFixture&) = delete;
+    ImGuiFixture& operator=(const ImGuiFixture&) = delete;
+
+    // The default font is added unless fonts were added before the first frame
+    void NewFrame(float deltaTime = 1.0f / 60.0f);
+
+    // ImGui::Render, then rasterized, without ending a frame that was never started
+    ImDrawData* Render(ImU32 clearColor = 0);
+
+    menu::MemoryTextureFactory& GetTextures()
+    {
+        return m_Textures;
+    }
+    const menu::SoftwareRenderer& GetRenderer() const
+    {
+        return m_Renderer;
+    }
+
+    // Rect of the item ImGui last submitted with that label, from the test engine hooks
+    bool GetItemRect(const char* label, ImRect& rect) const
+    {
+        return m_Items.Find(label, rect);
+    }
+
+    // IM_COL32 pixel of the last rendered frame
+    ImU32 GetPixel(int x, int y) const
+    {
+        return m_Renderer.GetPixels()[y * m_Renderer.GetPitch() + x];
+    }
+
+  private:
+    menu::MemoryTextureFactory m_Textures;
+    menu::SoftwareRenderer m_Renderer;
+    ItemRects m_Items;
+    ImGuiContext* m_Context = nullptr;
+};
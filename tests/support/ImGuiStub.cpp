@@ -0,0 +1,108 @@
+// Stand-in for the ImGui functions the portable tests link against, used when IMGUI_SOURCE_DIR
+// isn't given (the tree only has the ImGui headers). Nothing here builds geometry: tests fill
+// their draw lists by hand, and what needs a real context is only built with the sources.
+// Pure helpers the tests compare against are copied as they are in imgui.cpp.
+#include "imgui/imgui.h"
+#include "imgui/imgui_internal.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Linked in but never reached by the stub-built tests
+[[noreturn]] static void Unavailable(const char* function)
+{
+    fprintf(stderr, "%s needs the ImGui sources, configure with IMGUI_SOURCE_DIR\n", function);
+    abort();
+}
+
+ImGuiIO& ImGui::GetIO()
+{
+    Unavailable(__FUNCTION__);
+}
+
+ImGuiPlatformIO& ImGui::GetPlatformIO()
+{
+    Unavailable(__FUNCTION__);
+}
+
+void ImDrawList::AddImage(ImTextureRef, const ImVec2&, const ImVec2&, const ImVec2&,
+                          const ImVec2&, ImU32)
+{
+    Unavailable(__FUNCTION__);
+}
+
+void ImDrawList::PushClipRect(const ImVec2&, const ImVec2&, bool)
+{
+    Unavailable(__FUNCTION__);
+}
+
+void ImDrawList::PopClipRect()
+{
+    Unavailable(__FUNCTION__);
+}
+
+void ImDrawList::PushTexture(ImTextureRef)
+{
+    Unavailable(__FUNCTION__);
+}
+
+void ImDrawList::PopTexture()
+{
+    Unavailable(__FUNCTION__);
+}
+
+void ImDrawList::PrimReserve(int, int)
+{
+    Unavailable(__FUNCTION__);
+}
+
+// Same conversion as imgui.cpp, the packed palette is checked against it
+ImU32 ImGui::ColorConvertFloat4ToU32(const ImVec4& in)
+{
+    ImU32 out;
+    out = ((ImU32)IM_F32_TO_INT8_SAT(in.x)) << IM_COL32_R_SHIFT;
+    out |= ((ImU32)IM_F32_TO_INT8_SAT(in.y)) << IM_COL32_G_SHIFT;
+    out |= ((ImU32)IM_F32_TO_INT8_SAT(in.z)) << IM_COL32_B_SHIFT;
+    out |= ((ImU32)IM_F32_TO_INT8_SAT(in.w)) << IM_COL32_A_SHIFT;
+    return out;
+}
+
+// Plain malloc, no allocator hooks. Enough for ImVector and draw lists filled by hand.
+void* ImGui::MemAlloc(size_t size)
+{
+    return malloc(size);
+}
+
+void ImGui::MemFree(void* ptr)
+{
+    free(ptr);
+}
+
+// As in imgui_draw.cpp, minus the shared data setup only the Add* functions use
+ImDrawList::ImDrawList(ImDrawListSharedData* sharedData)
+{
+    memset((void*)this, 0, sizeof(*this));
+    _Data = sharedData;
+}
+
+ImDrawList::~ImDrawList()
+{
+}
+
+void ImDrawListSplitter::ClearFreeMemory()
+{
+    _Channels.clear();
+    _Current = 0;
+    _Count = 1;
+}
+
+void ImDrawData::Clear()
+{
+    Valid = false;
+    CmdListsCount = TotalIdxCount = TotalVtxCount = 0;
+    CmdLists.resize(0);
+    DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
+    OwnerViewport = nullptr;
+    Textures = nullptr;
+}
@@ -0,0 +1,26 @@
+// The test engine hooks ImGui calls when built with IMGUI_ENABLE_TEST_ENGINE, part of the
+// imgui library so every test linking ImGui has them
+#include "ItemRects.h"
+
+void ImGuiTestEngineHook_ItemAdd(ImGuiContext* ctx, ImGuiID id, const ImRect& bb,
+                                 const ImGuiLastItemData*)
+{
+    if (ctx->TestEngine && id != 0)
+        ((ItemRects*)ctx->TestEngine)->Add(id, bb);
+}
+
+void ImGuiTestEngineHook_ItemInfo(ImGuiContext* ctx, ImGuiID id, const char* label,
+                                  ImGuiItemStatusFlags)
+{
+    if (ctx->TestEngine && label)
+        ((ItemRects*)ctx->TestEngine)->SetLabel(id, label);
+}
+
+void ImGuiTestEngineHook_Log(ImGuiContext*, const char*, ...)
+{
+}
+
+const char* ImGuiTestEngine_FindItemDebugLabel(ImGuiContext*, ImGuiID)
+{
+    return nullptr;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "imgui/imgui.h"
+#include "imgui/imgui_internal.h"
+
+#include <string>
+#include <vector>
+
+// Where ImGui last placed each labelled item, filled by the test engine hooks in ItemRects.cpp
+// (ImGui is built with IMGUI_ENABLE_TEST_ENGINE alongside IMGUI_SOURCE_DIR). ImGuiFixture
+// points ImGuiContext::TestEngine at one. Items keep their last rect on frames they skip.
+class ItemRects
+{
+  public:
+    void Add(ImGuiID id, const ImRect& rect)
+    {
+        for (Item& item : m_Items)
+        {
+            if (item.Id == id)
+            {
+                item.Rect = rect;
+                return;
+            }
+        }
+        m_Items.push_back({id, rect, ""});
+    }
+
+    void SetLabel(ImGuiID id, const char* label)
+    {
+        for (Item& item : m_Items)
+        {
+            if (item.Id == id)
+                item.Label = label;
+        }
+    }
+
+    // Most recently added item with that label
+    bool Find(const char* label, ImRect& rect) const
+    {
+        for (auto it = m_Items.rbegin(); it != m_Items.rend(); ++it)
+        {
+            if (it->Label == label)
+            {
+                rect = it->Rect;
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    struct Item
+    {
+        ImGuiID Id;
+        ImRect Rect;
+        std::string Label;
+    };
+
+    std::vector<Item> m_Items;
+};
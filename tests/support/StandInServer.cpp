@@ -0,0 +1,303 @@
+#include "StandInServer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using SocketLength = int;
+static const int SHUTDOWN_BOTH = SD_BOTH;
+static const int SEND_FLAGS = 0;
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketLength = socklen_t;
+static const int SHUTDOWN_BOTH = SHUT_RDWR;
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#endif
+
+static void StartSockets()
+{
+#ifdef _WIN32
+    static const bool started = []() {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    (void)started;
+#endif
+}
+
+static void CloseSocket(intptr_t socket)
+{
+#ifdef _WIN32
+    closesocket((SOCKET)socket);
+#else
+    close((int)socket);
+#endif
+}
+
+// Answers go out as soon as they are written
+static void SetNoDelay(intptr_t socket)
+{
+    int one = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+}
+
+static bool SendAll(intptr_t socket, const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        int n = (int)send(socket, data.data() + sent, (int)(data.size() - sent), SEND_FLAGS);
+        if (n <= 0)
+            return false;
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+// One HTTP message (request or response) off a connection, pending keeps what was read past it
+struct Message
+{
+    std::string StartLine;
+    std::string Body;
+    bool KeepAlive = true;
+};
+
+static bool ReadMessage(intptr_t socket, std::string& pending, Message& message)
+{
+    char buffer[4096];
+    size_t headerEnd;
+    while ((headerEnd = pending.find("\r\n\r\n")) == std::string::npos)
+    {
+        int n = (int)recv(socket, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            return false;
+        pending.append(buffer, (size_t)n);
+    }
+
+    std::string headers = pending.substr(0, headerEnd);
+    std::transform(headers.begin(), headers.end(), headers.begin(),
+                   [](unsigned char c) { return (char)std::tolower(c); });
+    message.StartLine = pending.substr(0, pending.find("\r\n"));
+    message.KeepAlive = headers.find("\r\nconnection: close") == std::string::npos;
+
+    size_t length = 0;
+    size_t at = headers.find("\r\ncontent-length:");
+    if (at != std::string::npos)
+        length = (size_t)std::strtoul(headers.c_str() + at + 17, nullptr, 10);
+
+    pending.erase(0, headerEnd + 4);
+    while (pending.size() < length)
+    {
+        int n = (int)recv(socket, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            return false;
+        pending.append(buffer, (size_t)n);
+    }
+    message.Body = pending.substr(0, length);
+    pending.erase(0, length);
+    return true;
+}
+
+StandInServer::StandInServer(Handler handler) : m_Handler(std::move(handler))
+{
+    StartSockets();
+    m_Listener = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    SocketLength length = sizeof(address);
+    if (bind(m_Listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(m_Listener, 16) != 0 || getsockname(m_Listener, (sockaddr*)&address, &length) != 0)
+    {
+        CloseSocket(m_Listener);
+        m_Listener = -1;
+        return;
+    }
+
+    m_Port = ntohs(address.sin_port);
+    m_AcceptThread = std::thread(&StandInServer::AcceptLoop, this);
+}
+
+StandInServer::~StandInServer()
+{
+    Stop();
+}
+
+std::string StandInServer::GetUrl() const
+{
+    return "http://127.0.0.1:" + std::to_string(m_Port) + "/";
+}
+
+void StandInServer::SetDelay(std::chrono::milliseconds delay)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Delay = delay;
+}
+
+void StandInServer::SetHanging(bool hanging)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Hanging = hanging;
+    m_Changed.notify_all();
+}
+
+void StandInServer::SetDropping(bool dropping)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Dropping = dropping;
+}
+
+void StandInServer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Stopping)
+            return;
+        m_Stopping = true;
+        m_Changed.notify_all();
+
+        // Wakes the blocked accept and recv calls, the threads close their sockets
+        for (intptr_t socket : m_Sockets)
+            shutdown(socket, SHUTDOWN_BOTH);
+        if (m_Listener != -1)
+        {
+            shutdown(m_Listener, SHUTDOWN_BOTH);
+            CloseSocket(m_Listener);
+        }
+    }
+
+    if (m_AcceptThread.joinable())
+        m_AcceptThread.join();
+
+    // Nothing adds threads once the accept loop is gone
+    for (std::thread& thread : m_Threads)
+        thread.join();
+    m_Threads.clear();
+}
+
+void StandInServer::AcceptLoop()
+{
+    for (;;)
+    {
+        intptr_t socket = (intptr_t)accept(m_Listener, nullptr, nullptr);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Stopping)
+        {
+            if (socket >= 0)
+                CloseSocket(socket);
+            return;
+        }
+        if (socket < 0)
+            continue;
+
+        SetNoDelay(socket);
+        m_Sockets.push_back(socket);
+        m_Threads.emplace_back(&StandInServer::Serve, this, socket, ++m_Connections);
+    }
+}
+
+bool StandInServer::Hold()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Changed.wait(lock, [this]() { return !m_Hanging || m_Stopping; });
+    if (m_Delay.count() > 0)
+        m_Changed.wait_for(lock, m_Delay, [this]() { return m_Stopping; });
+    return !m_Stopping && !m_Dropping;
+}
+
+void StandInServer::Serve(intptr_t socket, int connection)
+{
+    std::string pending;
+    Message message;
+    while (ReadMessage(socket, pending, message))
+    {
+        m_Requests++;
+        if (!Hold())
+            break;
+
+        Request request;
+        const std::string& line = message.StartLine;
+        size_t space = line.find(' ');
+        request.Method = line.substr(0, space);
+        request.Path = line.substr(space + 1, line.rfind(' ') - space - 1);
+        request.Body = std::move(message.Body);
+        request.Connection = connection;
+
+        service::HttpResponse response = m_Handler(request);
+        std::string head = "HTTP/1.1 " + std::to_string(response.Status) + " Stand-in\r\n" +
+                           "Content-Length: " + std::to_string(response.Body.size()) + "\r\n" +
+                           (message.KeepAlive ? "" : "Connection: close\r\n") + "\r\n";
+        if (!SendAll(socket, head + response.Body) || !message.KeepAlive)
+            break;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Sockets.erase(std::find(m_Sockets.begin(), m_Sockets.end(), socket));
+    CloseSocket(socket);
+}
+
+LoopbackClient::LoopbackClient(int port) : m_Port(port)
+{
+    StartSockets();
+}
+
+LoopbackClient::~LoopbackClient()
+{
+    if (m_Socket != -1)
+        CloseSocket(m_Socket);
+}
+
+service::HttpResponse LoopbackClient::Post(const std::string& path, const std::string& body)
+{
+    std::string request = "POST " + path + " HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Length: " +
+                          std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    // A kept connection the server closed in the meantime gets one retry on a new one
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        bool reused = m_Socket != -1;
+        if (!reused)
+        {
+            m_Socket = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons((unsigned short)m_Port);
+            if (connect(m_Socket, (sockaddr*)&address, sizeof(address)) != 0)
+            {
+                CloseSocket(m_Socket);
+                m_Socket = -1;
+                return service::HttpResponse();
+            }
+            SetNoDelay(m_Socket);
+        }
+
+        std::string pending;
+        Message message;
+        if (SendAll(m_Socket, request) && ReadMessage(m_Socket, pending, message))
+        {
+            service::HttpResponse response;
+            size_t space = message.StartLine.find(' ');
+            response.Status = std::atoi(message.StartLine.c_str() + space + 1);
+            response.Body = std::move(message.Body);
+            return response;
+        }
+
+        CloseSocket(m_Socket);
+        m_Socket = -1;
+        if (!reused)
+            break;
+    }
+    return service::HttpResponse();
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "69/service/HttpClient.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// HTTP/1.1 server on 127.0.0.1 standing in for the login servers (scripts/login_server.py
+// speaks the same protocol). Connections are kept alive, every request can be delayed or held
+// until released, and the server counts what reached it. One thread per connection.
+class StandInServer
+{
+  public:
+    struct Request
+    {
+        std::string Method;
+        std::string Path;
+        std::string Body;
+        int Connection = 0; // Accept order, 1 for the first connection
+    };
+
+    using Handler = std::function<service::HttpResponse(const Request& request)>;
+
+    // Listens on a free port right away
+    explicit StandInServer(Handler handler);
+    ~StandInServer();
+
+    StandInServer(const StandInServer&) = delete;
+    StandInServer& operator=(const StandInServer&) = delete;
+
+    // http://127.0.0.1:<port>/
+    std::string GetUrl() const;
+    int GetPort() const
+    {
+        return m_Port;
+    }
+
+    // Added before every answer
+    void SetDelay(std::chrono::milliseconds delay);
+
+    // Requests are read but not answered until SetHanging(false) or the server stops, which
+    // closes the connection without an answer
+    void SetHanging(bool hanging);
+
+    // Requests are read, then the connection is closed without an answer, like a server or
+    // proxy that drops them
+    void SetDropping(bool dropping);
+
+    int GetConnections() const
+    {
+        return m_Connections;
+    }
+    int GetRequests() const
+    {
+        return m_Requests;
+    }
+
+    // Closes the listener and every connection, waits for their threads
+    void Stop();
+
+  private:
+    void AcceptLoop();
+    void Serve(intptr_t socket, int connection);
+
+    // False when the server stopped while holding the request, or drops it
+    bool Hold();
+
+    Handler m_Handler;
+    intptr_t m_Listener = -1;
+    int m_Port = 0;
+
+    std::atomic<int> m_Connections{0};
+    std::atomic<int> m_Requests{0};
+
+    std::mutex m_Mutex; // Guards everything below
+    std::condition_variable m_Changed;
+    bool m_Stopping = false;
+    bool m_Hanging = false;
+    bool m_Dropping = false;
+    std::chrono::milliseconds m_Delay{0};
+    std::vector<intptr_t> m_Sockets;
+    std::vector<std::thread> m_Threads;
+    std::thread m_AcceptThread;
+};
+
+// Blocking keep-alive client for the tests that don't go through HttpClient (WinHTTP).
+// Reconnects when the server closed the connection.
+class LoopbackClient
+{
+  public:
+    explicit LoopbackClient(int port);
+    ~LoopbackClient();
+
+    LoopbackClient(const LoopbackClient&) = delete;
+    LoopbackClient& operator=(const LoopbackClient&) = delete;
+
+    // Status 0 when the connection closed without an answer
+    service::HttpResponse Post(const std::string& path, const std::string& body);
+
+  private:
+    int m_Port;
+    intptr_t m_Socket = -1;
+};
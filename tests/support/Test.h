@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+
+// Self-registering checks for the executables under tests/, main() is in TestMain.cpp.
+//   TEST(BakedSpriteMatchesLayers) { CHECK(a == b); }
+// Tests run in the order they are defined, a failed CHECK is reported and the test goes on.
+// The exit code is the number of failed tests.
+namespace test
+{
+
+using TestFn = void (*)();
+
+// Called by TEST at static initialization
+bool Register(const char* name, TestFn fn);
+
+// Reports a failed CHECK of the running test
+void Fail(const char* file, int line, const char* expression);
+
+// Benchmarks run a single iteration with --quick, so ctest keeps them working. Their numbers
+// only mean something without it (and in an optimized build).
+bool IsQuick();
+
+// Golden tests write their reference instead of comparing against it with --update
+bool IsUpdate();
+
+// Prints one benchmark result, seconds per call shown in milliseconds
+void Report(const char* name, double seconds);
+
+// Seconds per call of fn: best of a few runs, each long enough to be measured
+template <class Fn> double Measure(Fn&& fn)
+{
+    using Clock = std::chrono::steady_clock;
+    auto run = [&fn](int calls) {
+        auto start = Clock::now();
+        for (int i = 0; i < calls; i++)
+            fn();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    if (IsQuick())
+        return run(1);
+
+    // Double the calls until a run lasts 50 ms
+    int calls = 1;
+    double elapsed = run(calls);
+    while (elapsed < 0.05 && calls < (1 << 24))
+    {
+        calls *= 2;
+        elapsed = run(calls);
+    }
+
+    double best = elapsed / calls;
+    for (int i = 0; i < 4; i++)
+    {
+        double seconds = run(calls) / calls;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+} // namespace test
+
+#define TEST(name)                                                                                 \
+    static void name();                                                                            \
+    static const bool name##Registered = test::Register(#name, name);                              \
+    static void name()
+
+#define CHECK(expression) ((expression) ? (void)0 : test::Fail(__FILE__, __LINE__, #expression))
@@ -0,0 +1,90 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace test
+{
+
+struct Case
+{
+    const char* Name;
+    TestFn Fn;
+};
+
+static std::vector<Case>& GetCases()
+{
+    static std::vector<Case> cases;
+    return cases;
+}
+
+static int g_Failures = 0; // Failed CHECKs of the running test
+static bool g_Quick = false;
+static bool g_Update = false;
+
+bool Register(const char* name, TestFn fn)
+{
+    GetCases().push_back({name, fn});
+    return true;
+}
+
+void Fail(const char* file, int line, const char* expression)
+{
+    printf("  %s(%d): CHECK(%s) failed\n", file, line, expression);
+    fflush(stdout);
+    g_Failures++;
+}
+
+bool IsQuick()
+{
+    return g_Quick;
+}
+
+bool IsUpdate()
+{
+    return g_Update;
+}
+
+void Report(const char* name, double seconds)
+{
+    printf("  %-48s %10.4f ms\n", name, seconds * 1000.0);
+    fflush(stdout);
+}
+
+} // namespace test
+
+// [--quick] [--update] [name filter]
+int main(int argc, char** argv)
+{
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+            test::g_Quick = true;
+        else if (strcmp(argv[i], "--update") == 0)
+            test::g_Update = true;
+        else
+            filter = argv[i];
+    }
+
+    int failed = 0;
+    for (const test::Case& test : test::GetCases())
+    {
+        if (filter && !strstr(test.Name, filter))
+            continue;
+
+        printf("%s\n", test.Name);
+        fflush(stdout);
+        test::g_Failures = 0;
+        test.Fn();
+        if (test::g_Failures > 0)
+        {
+            printf("FAILED %s\n", test.Name);
+            failed++;
+        }
+    }
+
+    printf(failed ? "%d test(s) failed\n" : "All tests passed\n", failed);
+    return failed;
+}